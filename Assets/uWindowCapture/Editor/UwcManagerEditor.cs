@@ -1,41 +1,53 @@
-﻿using UnityEngine;
-using UnityEditor;
-
-namespace uWindowCapture
-{
-
-[CustomEditor(typeof(UwcManager))]
-public class UwcManagerEditor : Editor
-{
-    UwcManager manager
-    {
-        get { return target as UwcManager; }
-    }
-
-    SerializedProperty windowTitlesUpdateTiming;
-
-    void OnEnable()
-    {
-        windowTitlesUpdateTiming = serializedObject.FindProperty("windowTitlesUpdateTiming");
-    }
-
-    public override void OnInspectorGUI()
-    {
-        serializedObject.Update();
-        Draw();
-        serializedObject.ApplyModifiedProperties();
-    }
-
-    void Draw()
-    {
-        var debugMode = (DebugMode)EditorGUILayout.EnumPopup("Debug Mode", manager.debugModeFromInspector);
-        if (debugMode != manager.debugModeFromInspector)
-        {
-            manager.debugModeFromInspector = debugMode;
-        }
-
-        EditorGUILayout.PropertyField(windowTitlesUpdateTiming);
-    }
-}
-
+﻿using UnityEngine;
+using UnityEditor;
+
+namespace uWindowCapture
+{
+
+[CustomEditor(typeof(UwcManager))]
+public class UwcManagerEditor : Editor
+{
+    UwcManager manager
+    {
+        get { return target as UwcManager; }
+    }
+
+    SerializedProperty windowTitlesUpdateTiming;
+    SerializedProperty framePacing;
+    SerializedProperty renderAllWindows;
+    SerializedProperty renderByteBudget;
+    SerializedProperty windowFilter;
+
+    void OnEnable()
+    {
+        windowTitlesUpdateTiming = serializedObject.FindProperty("windowTitlesUpdateTiming");
+        framePacing = serializedObject.FindProperty("framePacing");
+        renderAllWindows = serializedObject.FindProperty("renderAllWindows");
+        renderByteBudget = serializedObject.FindProperty("renderByteBudget");
+        windowFilter = serializedObject.FindProperty("windowFilter");
+    }
+
+    public override void OnInspectorGUI()
+    {
+        serializedObject.Update();
+        Draw();
+        serializedObject.ApplyModifiedProperties();
+    }
+
+    void Draw()
+    {
+        var debugMode = (DebugMode)EditorGUILayout.EnumPopup("Debug Mode", manager.debugModeFromInspector);
+        if (debugMode != manager.debugModeFromInspector)
+        {
+            manager.debugModeFromInspector = debugMode;
+        }
+
+        EditorGUILayout.PropertyField(windowTitlesUpdateTiming);
+        EditorGUILayout.PropertyField(framePacing);
+        EditorGUILayout.PropertyField(renderAllWindows);
+        EditorGUILayout.PropertyField(renderByteBudget);
+        EditorGUILayout.PropertyField(windowFilter, true);
+    }
+}
+
 }
\ No newline at end of file
@@ -1,288 +1,825 @@
-﻿using UnityEngine;
-using System;
-using System.Runtime.InteropServices;
-
-#pragma warning disable 114, 465
-
-namespace uWindowCapture
-{
-
-public enum DebugMode
-{
-    None = 0,
-    File = 1,
-    UnityLog = 2, /* currently has bug when app exits. */
-}
-
-public enum CaptureMode
-{
-    None = -1,
-    PrintWindow = 0,
-    BitBlt = 1,
-}
-
-public enum CapturePriority
-{
-    Auto = -1,
-    High = 0,
-    Middle = 1,
-    Low = 2,
-}
-
-public enum MessageType
-{
-    None = -1,
-    WindowAdded = 0,
-    WindowRemoved = 1,
-    WindowCaptured = 2,
-    WindowSizeChanged = 3,
-    IconCaptured = 4,
-    CursorCaptured = 5,
-    Error = 1000,
-    TextureNullError = 1001,
-    TextureSizeError = 1002,
-}
-
-[StructLayout(LayoutKind.Sequential)]
-public struct Message
-{
-    [MarshalAs(UnmanagedType.I4)]
-    public MessageType type;
-    [MarshalAs(UnmanagedType.I4)]
-    public int windowId;
-    [MarshalAs(UnmanagedType.I8)]
-    public IntPtr userData;
-}
-
-[StructLayout(LayoutKind.Sequential)]
-public struct Point
-{
-    [MarshalAs(UnmanagedType.I4)]
-    public int x;
-    [MarshalAs(UnmanagedType.I4)]
-    public int y;
-}
-
-public static class Lib
-{
-    public const string name = "uWindowCapture";
-
-    [UnmanagedFunctionPointer(CallingConvention.Cdecl)]
-    public delegate void DebugLogDelegate(string str);
-
-    [DllImport(name, EntryPoint = "UwcInitialize")]
-    public static extern void Initialize();
-    [DllImport(name, EntryPoint = "UwcFinalize")]
-    public static extern void Finalize();
-    [DllImport(name, EntryPoint = "UwcSetDebugMode")]
-    public static extern void SetDebugMode(DebugMode mode);
-    [DllImport(name, EntryPoint = "UwcSetLogFunc")]
-    public static extern void SetLogFunc(DebugLogDelegate func);
-    [DllImport(name, EntryPoint = "UwcSetErrorFunc")]
-    public static extern void SetErrorFunc(DebugLogDelegate func);
-    [DllImport(name, EntryPoint = "UwcGetRenderEventFunc")]
-    public static extern IntPtr GetRenderEventFunc();
-    [DllImport(name, EntryPoint = "UwcUpdate")]
-    public static extern void Update();
-    [DllImport(name, EntryPoint = "UwcTriggerGpuUpload")]
-    public static extern void TriggerGpuUpload();
-    [DllImport(name, EntryPoint = "UwcGetMessageCount")]
-    private static extern int GetMessageCount();
-    [DllImport(name, EntryPoint = "UwcGetMessages")]
-    private static extern IntPtr GetMessages_Internal();
-    [DllImport(name, EntryPoint = "UwcClearMessages")]
-    private static extern void ClearMessages();
-    [DllImport(name, EntryPoint = "UwcCheckWindowExistence")]
-    public static extern bool CheckWindowExistence(int id);
-    [DllImport(name, EntryPoint = "UwcGetWindowHandle")]
-    public static extern IntPtr GetWindowHandle(int id);
-    [DllImport(name, EntryPoint = "UwcGetWindowParentId")]
-    public static extern int GetWindowParentId(int id);
-    [DllImport(name, EntryPoint = "UwcGetWindowOwnerHandle")]
-    public static extern IntPtr GetWindowOwnerHandle(int id);
-    [DllImport(name, EntryPoint = "UwcGetWindowParentHandle")]
-    public static extern IntPtr GetWindowParentHandle(int id);
-    [DllImport(name, EntryPoint = "UwcGetWindowInstance")]
-    public static extern IntPtr GetWindowInstance(int id);
-    [DllImport(name, EntryPoint = "UwcGetWindowProcessId")]
-    public static extern int GetWindowProcessId(int id);
-    [DllImport(name, EntryPoint = "UwcGetWindowThreadId")]
-    public static extern int GetWindowThreadId(int id);
-    [DllImport(name, EntryPoint = "UwcRequestUpdateWindowTitle")]
-    public static extern void RequestUpdateWindowTitle(int id);
-    [DllImport(name, EntryPoint = "UwcRequestCaptureWindow")]
-    public static extern void RequestCaptureWindow(int id, CapturePriority priority);
-    [DllImport(name, EntryPoint = "UwcRequestCaptureIcon")]
-    public static extern void RequestCaptureIcon(int id);
-    [DllImport(name, EntryPoint = "UwcGetWindowX")]
-    public static extern int GetWindowX(int id);
-    [DllImport(name, EntryPoint = "UwcGetWindowY")]
-    public static extern int GetWindowY(int id);
-    [DllImport(name, EntryPoint = "UwcGetWindowWidth")]
-    public static extern int GetWindowWidth(int id);
-    [DllImport(name, EntryPoint = "UwcGetWindowHeight")]
-    public static extern int GetWindowHeight(int id);
-    [DllImport(name, EntryPoint = "UwcGetWindowZOrder")]
-    public static extern int GetWindowZOrder(int id);
-    [DllImport(name, EntryPoint = "UwcGetWindowBuffer")]
-    public static extern IntPtr GetWindowBuffer(int id);
-    [DllImport(name, EntryPoint = "UwcGetWindowTextureWidth")]
-    public static extern int GetWindowTextureWidth(int id);
-    [DllImport(name, EntryPoint = "UwcGetWindowTextureHeight")]
-    public static extern int GetWindowTextureHeight(int id);
-    [DllImport(name, EntryPoint = "UwcGetWindowTextureOffsetX")]
-    public static extern int GetWindowTextureOffsetX(int id);
-    [DllImport(name, EntryPoint = "UwcGetWindowTextureOffsetY")]
-    public static extern int GetWindowTextureOffsetY(int id);
-    [DllImport(name, EntryPoint = "UwcGetWindowIconWidth")]
-    public static extern int GetWindowIconWidth(int id);
-    [DllImport(name, EntryPoint = "UwcGetWindowIconHeight")]
-    public static extern int GetWindowIconHeight(int id);
-    [DllImport(name, EntryPoint = "UwcGetWindowTitleLength")]
-    private static extern int GetWindowTitleLength(int id);
-    [DllImport(name, EntryPoint = "UwcGetWindowTitle", CharSet = CharSet.Unicode)]
-    private static extern IntPtr GetWindowTitle_Internal(int id);
-    [DllImport(name, EntryPoint = "UwcGetWindowClassNameLength")]
-    private static extern int GetWindowClassNameLength(int id);
-    [DllImport(name, EntryPoint = "UwcGetWindowClassName", CharSet = CharSet.Ansi)]
-    private static extern IntPtr GetWindowClassName_Internal(int id);
-    [DllImport(name, EntryPoint = "UwcGetWindowTexturePtr")]
-    public static extern IntPtr GetWindowTexturePtr(int id);
-    [DllImport(name, EntryPoint = "UwcSetWindowTexturePtr")]
-    public static extern void SetWindowTexturePtr(int id, IntPtr texturePtr);
-    [DllImport(name, EntryPoint = "UwcGetWindowIconTexturePtr")]
-    public static extern IntPtr GetWindowIconTexturePtr(int id);
-    [DllImport(name, EntryPoint = "UwcSetWindowIconTexturePtr")]
-    public static extern void SetWindowIconTexturePtr(int id, IntPtr texturePtr);
-    [DllImport(name, EntryPoint = "UwcGetWindowCaptureMode")]
-    public static extern CaptureMode GetWindowCaptureMode(int id);
-    [DllImport(name, EntryPoint = "UwcSetWindowCaptureMode")]
-    public static extern void SetWindowCaptureMode(int id, CaptureMode mode);
-    [DllImport(name, EntryPoint = "UwcGetWindowCursorDraw")]
-    public static extern bool GetWindowCursorDraw(int id);
-    [DllImport(name, EntryPoint = "UwcSetWindowCursorDraw")]
-    public static extern void SetWindowCursorDraw(int id, bool draw);
-    [DllImport(name, EntryPoint = "UwcIsWindow")]
-    public static extern bool IsWindow(int id);
-    [DllImport(name, EntryPoint = "UwcIsWindowVisible")]
-    public static extern bool IsWindowVisible(int id);
-    [DllImport(name, EntryPoint = "UwcIsAltTabWindow")]
-    public static extern bool IsAltTabWindow(int id);
-    [DllImport(name, EntryPoint = "UwcIsDesktop")]
-    public static extern bool IsDesktop(int id);
-    [DllImport(name, EntryPoint = "UwcIsWindowEnabled")]
-    public static extern bool IsWindowEnabled(int id);
-    [DllImport(name, EntryPoint = "UwcIsWindowUnicode")]
-    public static extern bool IsWindowUnicode(int id);
-    [DllImport(name, EntryPoint = "UwcIsWindowZoomed")]
-    public static extern bool IsWindowZoomed(int id);
-    [DllImport(name, EntryPoint = "UwcIsWindowIconic")]
-    public static extern bool IsWindowIconic(int id);
-    [DllImport(name, EntryPoint = "UwcIsWindowHungUp")]
-    public static extern bool IsWindowHungUp(int id);
-    [DllImport(name, EntryPoint = "UwcIsWindowTouchable")]
-    public static extern bool IsWindowTouchable(int id);
-    [DllImport(name, EntryPoint = "UwcIsWindowApplicationFrameWindow")]
-    public static extern bool IsApplicationFrameWindow(int id);
-    [DllImport(name, EntryPoint = "UwcIsWindowUWP")]
-    public static extern bool IsWindowUWP(int id);
-    [DllImport(name, EntryPoint = "UwcIsWindowBackground")]
-    public static extern bool IsWindowBackground(int id);
-    [DllImport(name, EntryPoint = "UwcGetWindowPixel")]
-    public static extern Color32 GetWindowPixel(int id, int x, int y);
-    [DllImport(name, EntryPoint = "UwcGetWindowPixels")]
-    private static extern bool GetWindowPixels_Internal(int id, IntPtr output, int x, int y, int width, int height);
-    [DllImport(name, EntryPoint = "UwcRequestCaptureCursor")]
-    public static extern void RequestCaptureCursor();
-    [DllImport(name, EntryPoint = "UwcGetCursorPosition")]
-    public static extern Point GetCursorPosition();
-    [DllImport(name, EntryPoint = "UwcGetWindowIdFromPoint")]
-    public static extern int GetWindowIdFromPoint(int x, int y);
-    [DllImport(name, EntryPoint = "UwcGetWindowIdUnderCursor")]
-    public static extern int GetWindowIdUnderCursor();
-    [DllImport(name, EntryPoint = "UwcGetCursorX")]
-    public static extern int GetCursorX();
-    [DllImport(name, EntryPoint = "UwcGetCursorY")]
-    public static extern int GetCursorY();
-    [DllImport(name, EntryPoint = "UwcGetCursorWidth")]
-    public static extern int GetCursorWidth();
-    [DllImport(name, EntryPoint = "UwcGetCursorHeight")]
-    public static extern int GetCursorHeight();
-    [DllImport(name, EntryPoint = "UwcSetCursorTexturePtr")]
-    public static extern void SetCursorTexturePtr(IntPtr ptr);
-    [DllImport(name, EntryPoint = "UwcGetScreenX")]
-    public static extern int GetScreenX();
-    [DllImport(name, EntryPoint = "UwcGetScreenY")]
-    public static extern int GetScreenY();
-    [DllImport(name, EntryPoint = "UwcGetScreenWidth")]
-    public static extern int GetScreenWidth();
-    [DllImport(name, EntryPoint = "UwcGetScreenHeight")]
-    public static extern int GetScreenHeight();
-
-    public static Message[] GetMessages()
-    {
-        var count = GetMessageCount();
-        var messages = new Message[count];
-
-        if (count == 0) return messages;
-
-        var ptr = GetMessages_Internal();
-        var size = Marshal.SizeOf(typeof(Message));
-
-        for (int i = 0; i < count; ++i) {
-            var data = new IntPtr(ptr.ToInt64() + (size * i));
-            messages[i] = (Message)Marshal.PtrToStructure(data, typeof(Message));
-        }
-
-        ClearMessages();
-
-        return messages;
-    }
-
-    public static string GetWindowTitle(int id)
-    {
-        var len = GetWindowTitleLength(id);
-        var ptr = GetWindowTitle_Internal(id);
-        if (ptr != IntPtr.Zero) {
-            return Marshal.PtrToStringUni(ptr, len);
-        } else {
-            return "";
-        }
-    }
-
-    public static string GetWindowClassName(int id)
-    {
-        var len = GetWindowClassNameLength(id);
-        var ptr = GetWindowClassName_Internal(id);
-        if (ptr != IntPtr.Zero) {
-            return Marshal.PtrToStringAnsi(ptr, len);
-        } else {
-            return "";
-        }
-    }
-
-    public static Color32[] GetWindowPixels(int id, int x, int y, int width, int height)
-    {
-        var color = new Color32[width * height];       
-        GetWindowPixels(id, color, x, y, width, height);
-        return color;
-    }
-
-    public static bool GetWindowPixels(int id, Color32[] colors, int x, int y, int width, int height)
-    {
-        if (colors.Length < width * height) {
-            Debug.LogErrorFormat("colors is smaller than (width * height).", id, x, y, width, height);
-            return false;
-        }
-		var handle = GCHandle.Alloc(colors, GCHandleType.Pinned);
-		var ptr = handle.AddrOfPinnedObject();
-        if (!GetWindowPixels_Internal(id, ptr, x, y, width, height)) {
-            Debug.LogErrorFormat("GetWindowPixels({0}, {1}, {2}, {3}, {4}) failed.", id, x, y, width, height);
-            return false;
-        }
-        handle.Free();
-        return true;
-    }
-}
-
+﻿using UnityEngine;
+using System;
+using System.Runtime.InteropServices;
+
+#pragma warning disable 114, 465
+
+namespace uWindowCapture
+{
+
+public enum DebugMode
+{
+    None = 0,
+    File = 1,
+    UnityLog = 2, /* currently has bug when app exits. */
+}
+
+public enum CaptureMode
+{
+    None = -1,
+    PrintWindow = 0,
+    BitBlt = 1,
+}
+
+public enum CapturePriority
+{
+    Auto = -1,
+    High = 0,
+    Middle = 1,
+    Low = 2,
+}
+
+public enum PipelineStage
+{
+    Capture = 0,
+    Upload = 1,
+    Render = 2,
+}
+
+public enum QueuePolicy
+{
+    DropOldest = 0,
+    DropNewest = 1,
+}
+
+public enum CaptureRequestState
+{
+    Unknown = -1,
+    Pending = 0,
+    Completed = 1,
+    Failed = 2,
+}
+
+public enum MessageType
+{
+    None = -1,
+    WindowAdded = 0,
+    WindowRemoved = 1,
+    WindowCaptured = 2,
+    WindowSizeChanged = 3,
+    IconCaptured = 4,
+    CursorCaptured = 5,
+    WindowQuarantined = 6,
+    WindowRecovered = 7,
+    WindowMoved = 8,
+    WindowZOrderChanged = 9,
+    WindowTitleChanged = 10,
+    WindowIconicChanged = 11,
+    WindowMonitorChanged = 12,
+    WindowAttributesChanged = 13,
+    Error = 1000,
+    TextureNullError = 1001,
+    TextureSizeError = 1002,
+}
+
+[StructLayout(LayoutKind.Sequential)]
+public struct Message
+{
+    [MarshalAs(UnmanagedType.I4)]
+    public MessageType type;
+    [MarshalAs(UnmanagedType.I4)]
+    public int windowId;
+    [MarshalAs(UnmanagedType.I8)]
+    public IntPtr userData;
+    // changed fields of the window messages (e.g. x, y, width and height of WindowMoved)
+    [MarshalAs(UnmanagedType.I4)]
+    public int value0;
+    [MarshalAs(UnmanagedType.I4)]
+    public int value1;
+    [MarshalAs(UnmanagedType.I4)]
+    public int value2;
+    [MarshalAs(UnmanagedType.I4)]
+    public int value3;
+
+    public static ulong GetTypeBit(MessageType type)
+    {
+        var index = (int)type;
+        if (index >= (int)MessageType.Error) return 1ul << 63;
+        if (index < 0 || index >= 63) return 0;
+        return 1ul << index;
+    }
+}
+
+[StructLayout(LayoutKind.Sequential)]
+public struct Point
+{
+    [MarshalAs(UnmanagedType.I4)]
+    public int x;
+    [MarshalAs(UnmanagedType.I4)]
+    public int y;
+}
+
+[StructLayout(LayoutKind.Sequential)]
+public struct PipelineStageStats
+{
+    [MarshalAs(UnmanagedType.U4)]
+    public uint queueDepth;
+    [MarshalAs(UnmanagedType.U4)]
+    public uint maxQueueDepth;
+    [MarshalAs(UnmanagedType.U4)]
+    public uint queueCapacity;
+    [MarshalAs(UnmanagedType.U4)]
+    public uint budget;
+    [MarshalAs(UnmanagedType.U8)]
+    public ulong processed;
+    [MarshalAs(UnmanagedType.U8)]
+    public ulong dropped;
+    [MarshalAs(UnmanagedType.U8)]
+    public ulong overwritten;
+    [MarshalAs(UnmanagedType.R4)]
+    public float averageWaitTime;
+    [MarshalAs(UnmanagedType.R4)]
+    public float maxWaitTime;
+    [MarshalAs(UnmanagedType.R4)]
+    public float averageProcessTime;
+    [MarshalAs(UnmanagedType.R4)]
+    public float maxProcessTime;
+}
+
+[StructLayout(LayoutKind.Sequential)]
+public struct AtlasRect
+{
+    [MarshalAs(UnmanagedType.I4)]
+    public int page;
+    [MarshalAs(UnmanagedType.U4)]
+    public uint x;
+    [MarshalAs(UnmanagedType.U4)]
+    public uint y;
+    [MarshalAs(UnmanagedType.U4)]
+    public uint width;
+    [MarshalAs(UnmanagedType.U4)]
+    public uint height;
+    [MarshalAs(UnmanagedType.R4)]
+    public float uvX;
+    [MarshalAs(UnmanagedType.R4)]
+    public float uvY;
+    [MarshalAs(UnmanagedType.R4)]
+    public float uvWidth;
+    [MarshalAs(UnmanagedType.R4)]
+    public float uvHeight;
+}
+
+[StructLayout(LayoutKind.Sequential)]
+public struct RenderStats
+{
+    [MarshalAs(UnmanagedType.U8)]
+    public ulong frameCount;
+    [MarshalAs(UnmanagedType.U4)]
+    public uint lastCopyCount;
+    [MarshalAs(UnmanagedType.U4)]
+    public uint maxCopyCount;
+    [MarshalAs(UnmanagedType.R4)]
+    public float lastFrameTime;
+    [MarshalAs(UnmanagedType.R4)]
+    public float averageFrameTime;
+    [MarshalAs(UnmanagedType.R4)]
+    public float maxFrameTime;
+    [MarshalAs(UnmanagedType.U8)]
+    public ulong openedResourceCount;
+    [MarshalAs(UnmanagedType.U8)]
+    public ulong reusedResourceCount;
+}
+
+[StructLayout(LayoutKind.Sequential)]
+public struct UploadStats
+{
+    [MarshalAs(UnmanagedType.U8)]
+    public ulong triggerCount;
+    [MarshalAs(UnmanagedType.U8)]
+    public ulong uploadCount;
+    [MarshalAs(UnmanagedType.U8)]
+    public ulong uploadedBytes;
+    [MarshalAs(UnmanagedType.U8)]
+    public ulong flushCount;
+    [MarshalAs(UnmanagedType.U8)]
+    public ulong budgetExceededCount;
+    [MarshalAs(UnmanagedType.U4)]
+    public uint lastUploadsPerTrigger;
+    [MarshalAs(UnmanagedType.U4)]
+    public uint maxUploadsPerTrigger;
+    [MarshalAs(UnmanagedType.R4)]
+    public float averageUploadsPerTrigger;
+    [MarshalAs(UnmanagedType.U8)]
+    public ulong lastBytesPerTrigger;
+    [MarshalAs(UnmanagedType.U8)]
+    public ulong maxBytesPerTrigger;
+    [MarshalAs(UnmanagedType.R4)]
+    public float averageBytesPerTrigger;
+    [MarshalAs(UnmanagedType.R4)]
+    public float averageTriggerTime;
+    [MarshalAs(UnmanagedType.R4)]
+    public float maxTriggerTime;
+    [MarshalAs(UnmanagedType.U8)]
+    public ulong createdSharedTextureCount;
+    [MarshalAs(UnmanagedType.U8)]
+    public ulong reusedSharedTextureCount;
+    [MarshalAs(UnmanagedType.U4)]
+    public uint pooledSharedTextureCount;
+}
+
+[StructLayout(LayoutKind.Sequential)]
+public struct IconCacheStats
+{
+    [MarshalAs(UnmanagedType.U8)]
+    public ulong hitCount;
+    [MarshalAs(UnmanagedType.U8)]
+    public ulong missCount;
+    [MarshalAs(UnmanagedType.U8)]
+    public ulong uploadCount;
+    [MarshalAs(UnmanagedType.U8)]
+    public ulong sharedUploadCount;
+    [MarshalAs(UnmanagedType.U8)]
+    public ulong evictedCount;
+    [MarshalAs(UnmanagedType.U4)]
+    public uint entryCount;
+    [MarshalAs(UnmanagedType.U4)]
+    public uint capacity;
+    [MarshalAs(UnmanagedType.R4)]
+    public float hitRate;
+}
+
+[StructLayout(LayoutKind.Sequential)]
+public struct QuarantineInfo
+{
+    [MarshalAs(UnmanagedType.Bool)]
+    public bool isQuarantined;
+    [MarshalAs(UnmanagedType.U4)]
+    public uint slowCallCount;
+    [MarshalAs(UnmanagedType.R4)]
+    public float lastCallTime;
+    [MarshalAs(UnmanagedType.R4)]
+    public float maxCallTime;
+    [MarshalAs(UnmanagedType.R4)]
+    public float backoff;
+}
+
+[StructLayout(LayoutKind.Sequential)]
+public struct FrameInfo
+{
+    [MarshalAs(UnmanagedType.U8)]
+    public ulong sequence;
+    [MarshalAs(UnmanagedType.U8)]
+    public ulong captureTime;
+    [MarshalAs(UnmanagedType.U8)]
+    public ulong uploadTime;
+    [MarshalAs(UnmanagedType.U8)]
+    public ulong renderTime;
+}
+
+[StructLayout(LayoutKind.Sequential)]
+public struct CaptureResult
+{
+    [MarshalAs(UnmanagedType.I4)]
+    public CaptureRequestState state;
+    [MarshalAs(UnmanagedType.I4)]
+    public int windowId;
+    [MarshalAs(UnmanagedType.U8)]
+    public ulong frameSequence;
+    [MarshalAs(UnmanagedType.U8)]
+    public ulong requestTime;
+    [MarshalAs(UnmanagedType.U8)]
+    public ulong captureTime;
+    [MarshalAs(UnmanagedType.U8)]
+    public ulong uploadTime;
+    [MarshalAs(UnmanagedType.U8)]
+    public ulong renderTime;
+}
+
+[StructLayout(LayoutKind.Sequential)]
+public struct FrameClockStats
+{
+    public const int histogramSize = 12;
+
+    [MarshalAs(UnmanagedType.U8)]
+    public ulong frameCount;
+    [MarshalAs(UnmanagedType.R4)]
+    public float period;
+    [MarshalAs(UnmanagedType.R4)]
+    public float lead;
+    [MarshalAs(UnmanagedType.R4)]
+    public float averageJitter;
+    [MarshalAs(UnmanagedType.R4)]
+    public float maxJitter;
+    [MarshalAs(UnmanagedType.R4)]
+    public float averageLatency;
+    [MarshalAs(UnmanagedType.R4)]
+    public float maxLatency;
+    [MarshalAs(UnmanagedType.ByValArray, SizeConst = histogramSize)]
+    public uint[] jitterHistogram;
+    [MarshalAs(UnmanagedType.ByValArray, SizeConst = histogramSize)]
+    public uint[] latencyHistogram;
+}
+
+[StructLayout(LayoutKind.Sequential)]
+public struct CaptureGroupFrame
+{
+    [MarshalAs(UnmanagedType.U8)]
+    public ulong sequence;
+    [MarshalAs(UnmanagedType.U8)]
+    public ulong timestamp;
+    [MarshalAs(UnmanagedType.U4)]
+    public uint memberCount;
+    [MarshalAs(UnmanagedType.U4)]
+    public uint capturedCount;
+    [MarshalAs(UnmanagedType.R4)]
+    public float skew;
+}
+
+[StructLayout(LayoutKind.Sequential)]
+public struct CaptureGroupMember
+{
+    [MarshalAs(UnmanagedType.I4)]
+    public int windowId;
+    [MarshalAs(UnmanagedType.Bool)]
+    public bool isCaptured;
+    public FrameInfo frame;
+}
+
+[StructLayout(LayoutKind.Sequential)]
+public struct CaptureGroupStats
+{
+    public const int histogramSize = 12;
+
+    [MarshalAs(UnmanagedType.U8)]
+    public ulong frameCount;
+    [MarshalAs(UnmanagedType.U8)]
+    public ulong incompleteFrameCount;
+    [MarshalAs(UnmanagedType.R4)]
+    public float averageSkew;
+    [MarshalAs(UnmanagedType.R4)]
+    public float maxSkew;
+    [MarshalAs(UnmanagedType.ByValArray, SizeConst = histogramSize)]
+    public uint[] skewHistogram;
+}
+
+[System.Flags]
+public enum WindowFilterFlag
+{
+    None = 0,
+    AltTabOnly = 1 << 0,
+    ExcludeCloaked = 1 << 1,
+}
+
+[System.Flags]
+public enum WindowSnapshotFlag
+{
+    Desktop = 1 << 0,
+    Visible = 1 << 1,
+    Iconic = 1 << 2,
+    Zoomed = 1 << 3,
+    Enabled = 1 << 4,
+    AltTab = 1 << 5,
+    ApplicationFrame = 1 << 6,
+    UWP = 1 << 7,
+    Background = 1 << 8,
+    Quarantined = 1 << 9,
+}
+
+[StructLayout(LayoutKind.Sequential)]
+public struct WindowSnapshotEntry
+{
+    public IntPtr handle;
+    public IntPtr ownerHandle;
+    [MarshalAs(UnmanagedType.I4)]
+    public int id;
+    [MarshalAs(UnmanagedType.I4)]
+    public int parentId;
+    [MarshalAs(UnmanagedType.I4)]
+    public int processId;
+    [MarshalAs(UnmanagedType.I4)]
+    public int threadId;
+    [MarshalAs(UnmanagedType.I4)]
+    public int x;
+    [MarshalAs(UnmanagedType.I4)]
+    public int y;
+    [MarshalAs(UnmanagedType.I4)]
+    public int width;
+    [MarshalAs(UnmanagedType.I4)]
+    public int height;
+    [MarshalAs(UnmanagedType.I4)]
+    public int clientWidth;
+    [MarshalAs(UnmanagedType.I4)]
+    public int clientHeight;
+    [MarshalAs(UnmanagedType.I4)]
+    public int zOrder;
+    [MarshalAs(UnmanagedType.U4)]
+    public WindowSnapshotFlag flags;
+    [MarshalAs(UnmanagedType.I4)]
+    public int textureWidth;
+    [MarshalAs(UnmanagedType.I4)]
+    public int textureHeight;
+    [MarshalAs(UnmanagedType.I4)]
+    public int textureOffsetX;
+    [MarshalAs(UnmanagedType.I4)]
+    public int textureOffsetY;
+    [MarshalAs(UnmanagedType.I4)]
+    public int iconWidth;
+    [MarshalAs(UnmanagedType.I4)]
+    public int iconHeight;
+    [MarshalAs(UnmanagedType.U4)]
+    public uint titleVersion;
+
+    public bool Has(WindowSnapshotFlag flag)
+    {
+        return (flags & flag) != 0;
+    }
+}
+
+public static class Lib
+{
+    public const string name = "uWindowCapture";
+
+    // Event ids of the render event. Window ids are never negative.
+    // Either RenderEventAll or RenderEventFrame must be issued every frame for the frame clock, the cursor and the atlas.
+    public const int RenderEventAll = -1;
+    public const int RenderEventFrame = -2;
+    public static int GetWindowRenderEvent(int windowId) { return windowId; }
+    public static int GetGroupRenderEvent(int groupId) { return -3 - groupId; }
+
+    [UnmanagedFunctionPointer(CallingConvention.Cdecl)]
+    public delegate void DebugLogDelegate(string str);
+
+    [DllImport(name, EntryPoint = "UwcInitialize")]
+    public static extern void Initialize();
+    [DllImport(name, EntryPoint = "UwcFinalize")]
+    public static extern void Finalize();
+    [DllImport(name, EntryPoint = "UwcSetDebugMode")]
+    public static extern void SetDebugMode(DebugMode mode);
+    [DllImport(name, EntryPoint = "UwcSetLogFunc")]
+    public static extern void SetLogFunc(DebugLogDelegate func);
+    [DllImport(name, EntryPoint = "UwcSetErrorFunc")]
+    public static extern void SetErrorFunc(DebugLogDelegate func);
+    [DllImport(name, EntryPoint = "UwcGetRenderEventFunc")]
+    public static extern IntPtr GetRenderEventFunc();
+    [DllImport(name, EntryPoint = "UwcUpdate")]
+    public static extern void Update();
+    [DllImport(name, EntryPoint = "UwcTriggerGpuUpload")]
+    public static extern void TriggerGpuUpload();
+    [DllImport(name, EntryPoint = "UwcSetFramePacing")]
+    public static extern void SetFramePacing(bool enabled);
+    [DllImport(name, EntryPoint = "UwcGetFrameClockStats")]
+    public static extern bool GetFrameClockStats(out FrameClockStats stats);
+    [DllImport(name, EntryPoint = "UwcSetPipelineStageBudget")]
+    public static extern void SetPipelineStageBudget(PipelineStage stage, int budget);
+    [DllImport(name, EntryPoint = "UwcSetPipelineStageQueue")]
+    public static extern void SetPipelineStageQueue(PipelineStage stage, int capacity, QueuePolicy policy);
+    [DllImport(name, EntryPoint = "UwcGetPipelineStageStats")]
+    public static extern bool GetPipelineStageStats(PipelineStage stage, out PipelineStageStats stats);
+    [DllImport(name, EntryPoint = "UwcSetAtlasSettings")]
+    public static extern void SetAtlasSettings(int pageSize, int thumbnailSize, int maxPageCount);
+    [DllImport(name, EntryPoint = "UwcAddAtlasWindow")]
+    public static extern void AddAtlasWindow(int id);
+    [DllImport(name, EntryPoint = "UwcRemoveAtlasWindow")]
+    public static extern void RemoveAtlasWindow(int id);
+    [DllImport(name, EntryPoint = "UwcGetAtlasRect")]
+    public static extern bool GetAtlasRect(int id, out AtlasRect rect);
+    [DllImport(name, EntryPoint = "UwcGetAtlasVersion")]
+    public static extern ulong GetAtlasVersion();
+    [DllImport(name, EntryPoint = "UwcGetAtlasPageSize")]
+    public static extern int GetAtlasPageSize();
+    [DllImport(name, EntryPoint = "UwcGetAtlasPageCount")]
+    public static extern int GetAtlasPageCount();
+    [DllImport(name, EntryPoint = "UwcSetAtlasPageTexture")]
+    public static extern void SetAtlasPageTexture(int page, IntPtr ptr);
+    [DllImport(name, EntryPoint = "UwcSetRenderByteBudget")]
+    public static extern void SetRenderByteBudget(ulong byteBudget);
+    [DllImport(name, EntryPoint = "UwcGetRenderStats")]
+    public static extern bool GetRenderStats(out RenderStats stats);
+    [DllImport(name, EntryPoint = "UwcSetUploadTriggerBudget")]
+    public static extern void SetUploadTriggerBudget(uint timeBudget, ulong byteBudget);
+    [DllImport(name, EntryPoint = "UwcGetUploadStats")]
+    public static extern bool GetUploadStats(out UploadStats stats);
+    [DllImport(name, EntryPoint = "UwcSetIconCacheCapacity")]
+    public static extern void SetIconCacheCapacity(uint capacity);
+    [DllImport(name, EntryPoint = "UwcClearIconCache")]
+    public static extern void ClearIconCache();
+    [DllImport(name, EntryPoint = "UwcGetIconCacheStats")]
+    public static extern bool GetIconCacheStats(out IconCacheStats stats);
+    [DllImport(name, EntryPoint = "UwcSwapMessages")]
+    private static extern int SwapMessages();
+    [DllImport(name, EntryPoint = "UwcSetMessageSubscription")]
+    public static extern void SetMessageSubscription(ulong mask);
+    [DllImport(name, EntryPoint = "UwcGetMessageCount")]
+    private static extern int GetMessageCount();
+    [DllImport(name, EntryPoint = "UwcCopyMessages")]
+    private static extern int CopyMessages([Out] Message[] messages, int capacity);
+    [DllImport(name, EntryPoint = "UwcClearMessages")]
+    private static extern void ClearMessages();
+    [DllImport(name, EntryPoint = "UwcCheckWindowExistence")]
+    public static extern bool CheckWindowExistence(int id);
+    [DllImport(name, EntryPoint = "UwcGetWindowHandle")]
+    public static extern IntPtr GetWindowHandle(int id);
+    [DllImport(name, EntryPoint = "UwcGetWindowParentId")]
+    public static extern int GetWindowParentId(int id);
+    [DllImport(name, EntryPoint = "UwcGetWindowOwnerHandle")]
+    public static extern IntPtr GetWindowOwnerHandle(int id);
+    [DllImport(name, EntryPoint = "UwcGetWindowParentHandle")]
+    public static extern IntPtr GetWindowParentHandle(int id);
+    [DllImport(name, EntryPoint = "UwcGetWindowInstance")]
+    public static extern IntPtr GetWindowInstance(int id);
+    [DllImport(name, EntryPoint = "UwcGetWindowProcessId")]
+    public static extern int GetWindowProcessId(int id);
+    [DllImport(name, EntryPoint = "UwcGetWindowThreadId")]
+    public static extern int GetWindowThreadId(int id);
+    [DllImport(name, EntryPoint = "UwcRequestUpdateWindowTitle")]
+    public static extern void RequestUpdateWindowTitle(int id);
+    [DllImport(name, EntryPoint = "UwcRequestCaptureWindow")]
+    public static extern void RequestCaptureWindow(int id, CapturePriority priority);
+    [DllImport(name, EntryPoint = "UwcRequestCaptureAsync")]
+    public static extern int RequestCaptureAsync(int id, CapturePriority priority);
+    [DllImport(name, EntryPoint = "UwcRequestCaptureAsyncBatch")]
+    public static extern int RequestCaptureAsyncBatch(int[] ids, int count, CapturePriority priority, [Out] int[] tokens);
+    [DllImport(name, EntryPoint = "UwcPollCapture")]
+    public static extern CaptureRequestState PollCapture(int token, out CaptureResult result);
+    [DllImport(name, EntryPoint = "UwcPollCaptureBatch")]
+    public static extern int PollCaptureBatch(int[] tokens, int count, [Out] CaptureResult[] results);
+    // Requests of textured windows complete only after the upload trigger and the render event of the next frame,
+    // so waiting for them on Unity's main thread blocks until the timeout. Poll them each frame instead.
+    [DllImport(name, EntryPoint = "UwcWaitCapture")]
+    public static extern CaptureRequestState WaitCapture(int token, int timeout, out CaptureResult result);
+    [DllImport(name, EntryPoint = "UwcWaitCaptureBatch")]
+    public static extern int WaitCaptureBatch(int[] tokens, int count, int timeout, [Out] CaptureResult[] results);
+    [DllImport(name, EntryPoint = "UwcCreateCaptureGroup")]
+    public static extern int CreateCaptureGroup();
+    [DllImport(name, EntryPoint = "UwcDestroyCaptureGroup")]
+    public static extern void DestroyCaptureGroup(int groupId);
+    [DllImport(name, EntryPoint = "UwcSetCaptureGroupMembers")]
+    public static extern bool SetCaptureGroupMembers(int groupId, int[] ids, int count);
+    [DllImport(name, EntryPoint = "UwcRequestCaptureGroup")]
+    public static extern void RequestCaptureGroup(int groupId);
+    [DllImport(name, EntryPoint = "UwcGetCaptureGroupFrame")]
+    public static extern bool GetCaptureGroupFrame(int groupId, out CaptureGroupFrame frame);
+    [DllImport(name, EntryPoint = "UwcGetCaptureGroupFrameMembers")]
+    public static extern int GetCaptureGroupFrameMembers(int groupId, [Out] CaptureGroupMember[] members, int capacity);
+    [DllImport(name, EntryPoint = "UwcGetCaptureGroupStats")]
+    public static extern bool GetCaptureGroupStats(int groupId, out CaptureGroupStats stats);
+    [DllImport(name, EntryPoint = "UwcGetWindowRenderedFrame")]
+    public static extern bool GetWindowRenderedFrame(int id, out FrameInfo frame);
+    [DllImport(name, EntryPoint = "UwcRequestCaptureIcon")]
+    public static extern void RequestCaptureIcon(int id);
+    [DllImport(name, EntryPoint = "UwcGetWindowX")]
+    public static extern int GetWindowX(int id);
+    [DllImport(name, EntryPoint = "UwcGetWindowY")]
+    public static extern int GetWindowY(int id);
+    [DllImport(name, EntryPoint = "UwcGetWindowWidth")]
+    public static extern int GetWindowWidth(int id);
+    [DllImport(name, EntryPoint = "UwcGetWindowHeight")]
+    public static extern int GetWindowHeight(int id);
+    [DllImport(name, EntryPoint = "UwcGetWindowZOrder")]
+    public static extern int GetWindowZOrder(int id);
+    [DllImport(name, EntryPoint = "UwcGetWindowBuffer")]
+    public static extern IntPtr GetWindowBuffer(int id);
+    [DllImport(name, EntryPoint = "UwcGetWindowTextureWidth")]
+    public static extern int GetWindowTextureWidth(int id);
+    [DllImport(name, EntryPoint = "UwcGetWindowTextureHeight")]
+    public static extern int GetWindowTextureHeight(int id);
+    [DllImport(name, EntryPoint = "UwcGetWindowTextureOffsetX")]
+    public static extern int GetWindowTextureOffsetX(int id);
+    [DllImport(name, EntryPoint = "UwcGetWindowTextureOffsetY")]
+    public static extern int GetWindowTextureOffsetY(int id);
+    [DllImport(name, EntryPoint = "UwcGetWindowIconWidth")]
+    public static extern int GetWindowIconWidth(int id);
+    [DllImport(name, EntryPoint = "UwcGetWindowIconHeight")]
+    public static extern int GetWindowIconHeight(int id);
+    [DllImport(name, EntryPoint = "UwcGetWindowTitleLength")]
+    private static extern int GetWindowTitleLength(int id);
+    [DllImport(name, EntryPoint = "UwcGetWindowTitle", CharSet = CharSet.Unicode)]
+    private static extern IntPtr GetWindowTitle_Internal(int id);
+    [DllImport(name, EntryPoint = "UwcGetWindowClassNameLength")]
+    private static extern int GetWindowClassNameLength(int id);
+    [DllImport(name, EntryPoint = "UwcGetWindowClassName", CharSet = CharSet.Ansi)]
+    private static extern IntPtr GetWindowClassName_Internal(int id);
+    [DllImport(name, EntryPoint = "UwcGetWindowTexturePtr")]
+    public static extern IntPtr GetWindowTexturePtr(int id);
+    [DllImport(name, EntryPoint = "UwcSetWindowTexturePtr")]
+    public static extern void SetWindowTexturePtr(int id, IntPtr texturePtr);
+    [DllImport(name, EntryPoint = "UwcGetWindowIconTexturePtr")]
+    public static extern IntPtr GetWindowIconTexturePtr(int id);
+    [DllImport(name, EntryPoint = "UwcSetWindowIconTexturePtr")]
+    public static extern void SetWindowIconTexturePtr(int id, IntPtr texturePtr);
+    [DllImport(name, EntryPoint = "UwcGetWindowCaptureMode")]
+    public static extern CaptureMode GetWindowCaptureMode(int id);
+    [DllImport(name, EntryPoint = "UwcSetWindowCaptureMode")]
+    public static extern void SetWindowCaptureMode(int id, CaptureMode mode);
+    [DllImport(name, EntryPoint = "UwcGetWindowCursorDraw")]
+    public static extern bool GetWindowCursorDraw(int id);
+    [DllImport(name, EntryPoint = "UwcSetWindowCursorDraw")]
+    public static extern void SetWindowCursorDraw(int id, bool draw);
+    [DllImport(name, EntryPoint = "UwcIsWindow")]
+    public static extern bool IsWindow(int id);
+    [DllImport(name, EntryPoint = "UwcIsWindowVisible")]
+    public static extern bool IsWindowVisible(int id);
+    [DllImport(name, EntryPoint = "UwcIsAltTabWindow")]
+    public static extern bool IsAltTabWindow(int id);
+    [DllImport(name, EntryPoint = "UwcIsDesktop")]
+    public static extern bool IsDesktop(int id);
+    [DllImport(name, EntryPoint = "UwcIsWindowEnabled")]
+    public static extern bool IsWindowEnabled(int id);
+    [DllImport(name, EntryPoint = "UwcIsWindowUnicode")]
+    public static extern bool IsWindowUnicode(int id);
+    [DllImport(name, EntryPoint = "UwcIsWindowZoomed")]
+    public static extern bool IsWindowZoomed(int id);
+    [DllImport(name, EntryPoint = "UwcIsWindowIconic")]
+    public static extern bool IsWindowIconic(int id);
+    [DllImport(name, EntryPoint = "UwcIsWindowHungUp")]
+    public static extern bool IsWindowHungUp(int id);
+    [DllImport(name, EntryPoint = "UwcIsWindowTouchable")]
+    public static extern bool IsWindowTouchable(int id);
+    [DllImport(name, EntryPoint = "UwcIsWindowApplicationFrameWindow")]
+    public static extern bool IsApplicationFrameWindow(int id);
+    [DllImport(name, EntryPoint = "UwcIsWindowUWP")]
+    public static extern bool IsWindowUWP(int id);
+    [DllImport(name, EntryPoint = "UwcIsWindowBackground")]
+    public static extern bool IsWindowBackground(int id);
+    [DllImport(name, EntryPoint = "UwcIsWindowQuarantined")]
+    public static extern bool IsWindowQuarantined(int id);
+    [DllImport(name, EntryPoint = "UwcGetWindowQuarantineInfo")]
+    public static extern bool GetWindowQuarantineInfo(int id, out QuarantineInfo info);
+    [DllImport(name, EntryPoint = "UwcSetWatchdogThreshold")]
+    public static extern void SetWatchdogThreshold(int milliseconds);
+    [DllImport(name, EntryPoint = "UwcGetWindowPixel")]
+    public static extern Color32 GetWindowPixel(int id, int x, int y);
+    [DllImport(name, EntryPoint = "UwcGetWindowPixels")]
+    private static extern bool GetWindowPixels_Internal(int id, IntPtr output, int x, int y, int width, int height);
+    [DllImport(name, EntryPoint = "UwcRequestCaptureCursor")]
+    public static extern void RequestCaptureCursor();
+    [DllImport(name, EntryPoint = "UwcGetCursorPosition")]
+    public static extern Point GetCursorPosition();
+    [DllImport(name, EntryPoint = "UwcSetWindowFilter", CharSet = CharSet.Unicode)]
+    private static extern void SetWindowFilter_Internal(
+        WindowFilterFlag flags, 
+        int minWidth, 
+        int minHeight, 
+        int[] processIds, 
+        int processIdCount, 
+        [MarshalAs(UnmanagedType.LPArray, ArraySubType = UnmanagedType.LPWStr)] string[] processNames, 
+        int processNameCount, 
+        string classPattern, 
+        string titlePattern);
+    [DllImport(name, EntryPoint = "UwcClearWindowFilter")]
+    public static extern void ClearWindowFilter();
+    [DllImport(name, EntryPoint = "UwcGetWindowSnapshot")]
+    private static extern int GetWindowSnapshot_Internal([Out] WindowSnapshotEntry[] entries, int capacity, out ulong version);
+    [DllImport(name, EntryPoint = "UwcGetWindowsOfProcess")]
+    private static extern int GetWindowsOfProcess_Internal(int processId, [Out] int[] ids, int capacity);
+    [DllImport(name, EntryPoint = "UwcGetWindowIdFromPoint")]
+    public static extern int GetWindowIdFromPoint(int x, int y);
+    [DllImport(name, EntryPoint = "UwcGetWindowIdsFromPoints")]
+    public static extern void GetWindowIdsFromPoints(Point[] points, int count, [Out] int[] ids);
+    [DllImport(name, EntryPoint = "UwcGetWindowIdsInRect")]
+    private static extern int GetWindowIdsInRect_Internal(int x, int y, int width, int height, [Out] int[] ids, int capacity);
+    [DllImport(name, EntryPoint = "UwcGetWindowIdUnderCursor")]
+    public static extern int GetWindowIdUnderCursor();
+    [DllImport(name, EntryPoint = "UwcGetCursorX")]
+    public static extern int GetCursorX();
+    [DllImport(name, EntryPoint = "UwcGetCursorY")]
+    public static extern int GetCursorY();
+    [DllImport(name, EntryPoint = "UwcGetCursorWidth")]
+    public static extern int GetCursorWidth();
+    [DllImport(name, EntryPoint = "UwcGetCursorHeight")]
+    public static extern int GetCursorHeight();
+    [DllImport(name, EntryPoint = "UwcSetCursorTexturePtr")]
+    public static extern void SetCursorTexturePtr(IntPtr ptr);
+    [DllImport(name, EntryPoint = "UwcGetScreenX")]
+    public static extern int GetScreenX();
+    [DllImport(name, EntryPoint = "UwcGetScreenY")]
+    public static extern int GetScreenY();
+    [DllImport(name, EntryPoint = "UwcGetScreenWidth")]
+    public static extern int GetScreenWidth();
+    [DllImport(name, EntryPoint = "UwcGetScreenHeight")]
+    public static extern int GetScreenHeight();
+
+    public static Message[] GetMessages()
+    {
+        Message[] messages = null;
+        var count = GetMessages(ref messages);
+        System.Array.Resize(ref messages, count);
+        return messages;
+    }
+
+    // Reads the messages into the given buffer, which is reallocated only when it is too small.
+    public static int GetMessages(ref Message[] messages)
+    {
+        var count = SwapMessages();
+        if (messages == null || messages.Length < count) {
+            messages = new Message[Mathf.NextPowerOfTwo(Mathf.Max(count, 16))];
+        }
+
+        if (count == 0) return 0;
+
+        // Message is blittable, so the array is pinned and filled with a single block copy.
+        return CopyMessages(messages, messages.Length);
+    }
+
+    public static string GetWindowTitle(int id)
+    {
+        var len = GetWindowTitleLength(id);
+        var ptr = GetWindowTitle_Internal(id);
+        if (ptr != IntPtr.Zero) {
+            return Marshal.PtrToStringUni(ptr, len);
+        } else {
+            return "";
+        }
+    }
+
+    public static string GetWindowClassName(int id)
+    {
+        var len = GetWindowClassNameLength(id);
+        var ptr = GetWindowClassName_Internal(id);
+        if (ptr != IntPtr.Zero) {
+            return Marshal.PtrToStringAnsi(ptr, len);
+        } else {
+            return "";
+        }
+    }
+
+    public static void SetWindowFilter(UwcWindowFilter filter)
+    {
+        var flags = WindowFilterFlag.None;
+        if (filter.altTabOnly) flags |= WindowFilterFlag.AltTabOnly;
+        if (filter.excludeCloaked) flags |= WindowFilterFlag.ExcludeCloaked;
+        var processIds = filter.processIds ?? new int[0];
+        var processNames = filter.processNames ?? new string[0];
+        SetWindowFilter_Internal(
+            flags, 
+            filter.minWidth, 
+            filter.minHeight, 
+            processIds, 
+            processIds.Length, 
+            processNames, 
+            processNames.Length, 
+            filter.classPattern ?? "", 
+            filter.titlePattern ?? "");
+    }
+
+    public static WindowSnapshotEntry[] GetWindowSnapshot(out ulong version)
+    {
+        var entries = new WindowSnapshotEntry[64];
+        for (;;) {
+            var n = GetWindowSnapshot_Internal(entries, entries.Length, out version);
+            if (n <= entries.Length) {
+                System.Array.Resize(ref entries, n);
+                return entries;
+            }
+            entries = new WindowSnapshotEntry[n];
+        }
+    }
+
+    public static ulong GetWindowSnapshotVersion()
+    {
+        ulong version;
+        GetWindowSnapshot_Internal(null, 0, out version);
+        return version;
+    }
+
+    public static int[] GetWindowsOfProcess(int processId)
+    {
+        var ids = new int[16];
+        for (;;) {
+            var n = GetWindowsOfProcess_Internal(processId, ids, ids.Length);
+            if (n <= ids.Length) {
+                System.Array.Resize(ref ids, n);
+                return ids;
+            }
+            ids = new int[n];
+        }
+    }
+
+    public static int[] GetWindowIdsInRect(int x, int y, int width, int height)
+    {
+        var ids = new int[16];
+        for (;;) {
+            var n = GetWindowIdsInRect_Internal(x, y, width, height, ids, ids.Length);
+            if (n <= ids.Length) {
+                System.Array.Resize(ref ids, n);
+                return ids;
+            }
+            ids = new int[n];
+        }
+    }
+
+    public static Color32[] GetWindowPixels(int id, int x, int y, int width, int height)
+    {
+        var color = new Color32[width * height];       
+        GetWindowPixels(id, color, x, y, width, height);
+        return color;
+    }
+
+    public static bool GetWindowPixels(int id, Color32[] colors, int x, int y, int width, int height)
+    {
+        if (colors.Length < width * height) {
+            Debug.LogErrorFormat("colors is smaller than (width * height).", id, x, y, width, height);
+            return false;
+        }
+		var handle = GCHandle.Alloc(colors, GCHandleType.Pinned);
+		var ptr = handle.AddrOfPinnedObject();
+        if (!GetWindowPixels_Internal(id, ptr, x, y, width, height)) {
+            Debug.LogErrorFormat("GetWindowPixels({0}, {1}, {2}, {3}, {4}) failed.", id, x, y, width, height);
+            return false;
+        }
+        handle.Free();
+        return true;
+    }
+}
+
 }
\ No newline at end of file
@@ -0,0 +1,103 @@
+﻿using UnityEngine;
+using System.Collections.Generic;
+
+namespace uWindowCapture
+{
+
+public class UwcThumbnailAtlas : MonoBehaviour 
+{
+    [Tooltip("Width and height of each atlas page texture.")]
+    public int pageSize = 2048;
+
+    [Tooltip("Windows are downscaled to fit into this size keeping their aspect ratio.")]
+    public int thumbnailSize = 256;
+
+    public int maxPageCount = 4;
+
+    public CapturePriority capturePriority = CapturePriority.Low;
+
+    public UwcEvent onLayoutChanged = new UwcEvent();
+
+    List<Texture2D> pages_ = new List<Texture2D>();
+    public List<Texture2D> pages
+    {
+        get { return pages_; }
+    }
+
+    HashSet<int> windowIds_ = new HashSet<int>();
+    ulong version_ = 0;
+
+    void Start()
+    {
+        Lib.SetAtlasSettings(pageSize, thumbnailSize, maxPageCount);
+    }
+
+    void OnDestroy()
+    {
+        foreach (var id in windowIds_) {
+            Lib.RemoveAtlasWindow(id);
+        }
+        windowIds_.Clear();
+    }
+
+    void Update()
+    {
+        UpdatePages();
+        RequestCaptures();
+
+        var version = Lib.GetAtlasVersion();
+        if (version != version_) {
+            version_ = version;
+            onLayoutChanged.Invoke();
+        }
+    }
+
+    void UpdatePages()
+    {
+        var count = Lib.GetAtlasPageCount();
+        var size = Lib.GetAtlasPageSize();
+        for (int i = pages_.Count; i < count; ++i) {
+            var texture = new Texture2D(size, size, TextureFormat.BGRA32, false);
+            pages_.Add(texture);
+            Lib.SetAtlasPageTexture(i, texture.GetNativeTexturePtr());
+        }
+    }
+
+    void RequestCaptures()
+    {
+        foreach (var id in windowIds_) {
+            var window = UwcManager.Find(id);
+            if (window != null) {
+                window.RequestCapture(capturePriority);
+            }
+        }
+    }
+
+    public void Add(UwcWindow window)
+    {
+        if (window == null || !windowIds_.Add(window.id)) return;
+        Lib.AddAtlasWindow(window.id);
+    }
+
+    public void Remove(UwcWindow window)
+    {
+        if (window == null || !windowIds_.Remove(window.id)) return;
+        Lib.RemoveAtlasWindow(window.id);
+    }
+
+    public bool TryGetThumbnail(UwcWindow window, out Texture2D texture, out Rect uvRect)
+    {
+        texture = null;
+        uvRect = new Rect();
+
+        AtlasRect rect;
+        if (window == null || !Lib.GetAtlasRect(window.id, out rect)) return false;
+        if (rect.page < 0 || rect.page >= pages_.Count) return false;
+
+        texture = pages_[rect.page];
+        uvRect = new Rect(rect.uvX, rect.uvY, rect.uvWidth, rect.uvHeight);
+        return true;
+    }
+}
+
+}
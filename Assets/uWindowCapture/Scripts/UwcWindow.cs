@@ -1,408 +1,473 @@
-﻿using UnityEngine;
-using UnityEngine.Events;
-
-namespace uWindowCapture
-{
-
-public class UwcWindow
-{
-    public UwcWindow(int id)
-    {
-        this.id = id;
-        isAlive = true;
-
-        onCaptured.AddListener(OnCaptured);
-        onSizeChanged.AddListener(OnSizeChanged);
-        onIconCaptured.AddListener(OnIconCaptured);
-
-        CreateIconTexture();
-
-        parentWindow = UwcManager.FindParent(id);
-        if (parentWindow != null) {
-            parentWindow.onChildAdded.Invoke(this);
-        }
-    }
-
-    public int id 
-    { 
-        get; 
-        private set; 
-    }
-
-    public UwcWindow parentWindow
-    {
-        get;
-        private set;
-    }
-
-    public System.IntPtr handle
-    {
-        get { return Lib.GetWindowHandle(id); }
-    }
-
-    public System.IntPtr ownerHandle
-    {
-        get { return Lib.GetWindowOwnerHandle(id); }
-    }
-
-    public System.IntPtr parentHandle
-    {
-        get { return Lib.GetWindowParentHandle(id); }
-    }
-
-    public System.IntPtr instance
-    {
-        get { return Lib.GetWindowInstance(id); }
-    }
-
-    public int processId
-    {
-        get { return Lib.GetWindowProcessId(id); }
-    }
-
-    public int threadId
-    {
-        get { return Lib.GetWindowThreadId(id); }
-    }
-
-    public bool isValid
-    {
-        get { return Lib.CheckWindowExistence(id); }
-    }
-
-    public bool isAlive
-    {
-        get;
-        set;
-    }
-
-    public bool isRoot
-    {
-        get { return parentWindow == null; }
-    }
-
-    public bool isChild
-    {
-        get { return !isRoot; }
-    }
-
-    public bool isVisible
-    {
-        get { return Lib.IsWindowVisible(id); }
-    }
-
-    public bool isAltTabWindow
-    {
-        get { return Lib.IsAltTabWindow(id); }
-    }
-
-    public bool isDesktop
-    {
-        get { return Lib.IsDesktop(id); }
-    }
-
-    public bool isEnabled
-    {
-        get { return Lib.IsWindowEnabled(id); }
-    }
-
-    public bool isUnicode
-    {
-        get { return Lib.IsWindowUnicode(id); }
-    }
-
-    public bool isZoomed 
-    {
-        get { return Lib.IsWindowZoomed(id); }
-    }
-
-    public bool isMaximized
-    {
-        get { return isZoomed; }
-    }
-
-    public bool isIconic
-    {
-        get { return Lib.IsWindowIconic(id); }
-    }
-
-    public bool isMinimized
-    {
-        get { return isIconic; }
-    }
-
-    public bool isHungup
-    {
-        get { return Lib.IsWindowHungUp(id); }
-    }
-
-    public bool isTouchable
-    {
-        get { return Lib.IsWindowTouchable(id); }
-    }
-
-    public bool isApplicationFrameWindow
-    {
-        get { return Lib.IsApplicationFrameWindow(id); }
-    }
-
-    public bool isUWP
-    {
-        get { return Lib.IsWindowUWP(id); }
-    }
-
-    public bool isBackground
-    {
-        get { return Lib.IsWindowBackground(id); }
-    }
-
-    public string title
-    {
-        get { return Lib.GetWindowTitle(id); } 
-    }
-
-    public string className
-    {
-        get { return Lib.GetWindowClassName(id); } 
-    }
-
-    public int rawX
-    {
-        get { return Lib.GetWindowX(id); }
-    }
-
-    public int rawY
-    {
-        get { return Lib.GetWindowY(id); }
-    }
-
-    public int rawWidth
-    {
-        get { return Lib.GetWindowWidth(id); }
-    }
-
-    public int rawHeight
-    {
-        get { return Lib.GetWindowHeight(id); }
-    }
-
-    public int x
-    {
-        get { return rawX + Lib.GetWindowTextureOffsetX(id); }
-    }
-
-    public int y
-    {
-        get { return rawY + Lib.GetWindowTextureOffsetY(id); }
-    }
-
-    public int width
-    {
-        get { return Lib.GetWindowTextureWidth(id); }
-    }
-
-    public int height
-    {
-        get { return Lib.GetWindowTextureHeight(id); }
-    }
-
-    public int zOrder
-    {
-        get { return Lib.GetWindowZOrder(id); }
-    }
-
-    public System.IntPtr buffer
-    {
-        get { return Lib.GetWindowBuffer(id); }
-    }
-
-    public int textureOffsetX
-    {
-        get { return Lib.GetWindowTextureOffsetX(id); }
-    }
-
-    public int textureOffsetY
-    {
-        get { return Lib.GetWindowTextureOffsetY(id); }
-    }
-
-    public int iconWidth
-    {
-        get { return Lib.GetWindowIconWidth(id); }
-    }
-
-    public int iconHeight
-    {
-        get { return Lib.GetWindowIconHeight(id); }
-    }
-
-    private Texture2D backTexture_;
-    private bool willTextureSizeChange_ = false;
-    public Texture2D texture
-    {
-        get;
-        private set;
-    }
-
-    private Texture2D iconTexture_;
-    private Texture2D errorIconTexture_;
-    private bool hasIconTextureCaptured_ = false;
-    public bool hasIconTexture
-    {
-        get { return hasIconTextureCaptured_; }
-    }
-
-    public Texture2D iconTexture
-    {
-        get { return hasIconTextureCaptured_ ? iconTexture_ : errorIconTexture_; }
-    }
-
-    public CaptureMode captureMode
-    {
-        get { return Lib.GetWindowCaptureMode(id); }
-        set { Lib.SetWindowCaptureMode(id, value); }
-    }
-
-    public bool cursorDraw
-    {
-        get { return Lib.GetWindowCursorDraw(id); }
-        set { Lib.SetWindowCursorDraw(id, value); }
-    }
-
-    private UnityEvent onCaptured_ = new UnityEvent();
-    public UnityEvent onCaptured 
-    { 
-        get { return onCaptured_; } 
-    }
-
-    private bool isFirstSizeChangedEvent_ = true;
-    private UnityEvent onSizeChanged_ = new UnityEvent();
-    public UnityEvent onSizeChanged
-    {
-        get { return onSizeChanged_; } 
-    }
-
-    private UnityEvent onIconCaptured_ = new UnityEvent();
-    public UnityEvent onIconCaptured 
-    { 
-        get { return onIconCaptured_; } 
-    }
-
-    public class ChildAddedEvent : UnityEvent<UwcWindow> {}
-    private ChildAddedEvent onChildAdded_ = new ChildAddedEvent();
-    public ChildAddedEvent onChildAdded
-    { 
-        get { return onChildAdded_; } 
-    }
-
-    public class ChildRemovedEvent : UnityEvent<UwcWindow> {}
-    private ChildRemovedEvent onChildRemoved_ = new ChildRemovedEvent();
-    public ChildRemovedEvent onChildRemoved
-    { 
-        get { return onChildRemoved_; } 
-    }
-
-    public void RequestUpdateTitle()
-    {
-        Lib.RequestUpdateWindowTitle(id);
-    }
-
-    public void RequestCaptureIcon()
-    {
-        Lib.RequestCaptureIcon(id);
-    }
-
-    public void RequestCapture(CapturePriority priority = CapturePriority.High)
-    {
-        if (!texture) {
-            CreateWindowTexture();
-        }
-        Lib.RequestCaptureWindow(id, priority);
-    }
-
-    void OnSizeChanged()
-    {
-        if (isFirstSizeChangedEvent_) {
-            isFirstSizeChangedEvent_ = false;
-            return;
-        }
-
-        CreateWindowTexture();
-    }
-
-    void OnCaptured()
-    {
-        UpdateWindowTexture();
-    }
-
-    void OnIconCaptured()
-    {
-        hasIconTextureCaptured_ = true;
-    }
-
-    void CreateWindowTexture(bool force = false)
-    {
-        var w = width;
-        var h = height;
-        if (w <= 0 || h <= 0) return;
-
-        if (force || !texture || texture.width != w || texture.height != h) {
-            if (backTexture_) {
-                Object.DestroyImmediate(backTexture_);
-            }
-            try {
-                backTexture_ = new Texture2D(w, h, TextureFormat.BGRA32, false);
-                Lib.SetWindowTexturePtr(id, backTexture_.GetNativeTexturePtr());
-                willTextureSizeChange_ = true;
-            } catch (System.Exception e) {
-                Debug.LogError(e.Message);
-                Debug.LogErrorFormat("Width: {0}, Height: {1}", w, h);
-            }
-        }
-    }
-
-    void UpdateWindowTexture()
-    {
-        if (willTextureSizeChange_) {
-            if (texture) {
-                Object.DestroyImmediate(texture);
-            }
-            texture = backTexture_;
-            backTexture_ = null;
-            willTextureSizeChange_ = false;
-        }
-    }
-
-    public void ResetWindowTexture()
-    {
-        CreateWindowTexture(true);
-    }
-
-    void CreateIconTexture()
-    {
-        var w = iconWidth;
-        var h = iconHeight;
-        if (w == 0 || h == 0) return;
-        iconTexture_ = new Texture2D(w, h, TextureFormat.BGRA32, false);
-        iconTexture_.filterMode = FilterMode.Point;
-        Lib.SetWindowIconTexturePtr(id, iconTexture_.GetNativeTexturePtr());
-        errorIconTexture_ = Resources.Load<Texture2D>("uWindowCapture/Textures/uWC_No_Image");
-    }
-
-    public Color32[] GetPixels(int x, int y, int width, int height)
-    {
-        return Lib.GetWindowPixels(id, x, y, width, height);
-    }
-
-    public bool GetPixels(Color32[] colors, int x, int y, int width, int height)
-    {
-        return Lib.GetWindowPixels(id, colors, x, y, width, height);
-    }
-
-    public Color32 GetPixel(int x, int y)
-    {
-        return Lib.GetWindowPixel(id, x, y);
-    }
-}
-
+﻿using UnityEngine;
+using UnityEngine.Events;
+
+namespace uWindowCapture
+{
+
+public class UwcWindow
+{
+    public UwcWindow(int id)
+    {
+        this.id = id;
+        isAlive = true;
+
+        onCaptured.AddListener(OnCaptured);
+        onSizeChanged.AddListener(OnSizeChanged);
+        onIconCaptured.AddListener(OnIconCaptured);
+
+        CreateIconTexture();
+
+        parentWindow = UwcManager.FindParent(id);
+        if (parentWindow != null) {
+            parentWindow.onChildAdded.Invoke(this);
+        }
+    }
+
+    public int id 
+    { 
+        get; 
+        private set; 
+    }
+
+    // the snapshot of this frame is read first, and the plugin is asked only for the windows not in it yet.
+    T GetSnapshotValue<T>(System.Func<WindowSnapshotEntry, T> selector, System.Func<int, T> fallback)
+    {
+        WindowSnapshotEntry e;
+        return UwcManager.TryGetSnapshot(id, out e) ? selector(e) : fallback(id);
+    }
+
+    public UwcWindow parentWindow
+    {
+        get;
+        private set;
+    }
+
+    public System.IntPtr handle
+    {
+        get { return GetSnapshotValue(e => e.handle, i => Lib.GetWindowHandle(i)); }
+    }
+
+    public System.IntPtr ownerHandle
+    {
+        get { return Lib.GetWindowOwnerHandle(id); }
+    }
+
+    public System.IntPtr parentHandle
+    {
+        get { return Lib.GetWindowParentHandle(id); }
+    }
+
+    public System.IntPtr instance
+    {
+        get { return Lib.GetWindowInstance(id); }
+    }
+
+    public int processId
+    {
+        get { return GetSnapshotValue(e => e.processId, i => Lib.GetWindowProcessId(i)); }
+    }
+
+    public int threadId
+    {
+        get { return GetSnapshotValue(e => e.threadId, i => Lib.GetWindowThreadId(i)); }
+    }
+
+    public bool isValid
+    {
+        get { return Lib.CheckWindowExistence(id); }
+    }
+
+    public bool isAlive
+    {
+        get;
+        set;
+    }
+
+    public bool isRoot
+    {
+        get { return parentWindow == null; }
+    }
+
+    public bool isChild
+    {
+        get { return !isRoot; }
+    }
+
+    public bool isVisible
+    {
+        get { return GetSnapshotValue(e => e.Has(WindowSnapshotFlag.Visible), i => Lib.IsWindowVisible(i)); }
+    }
+
+    public bool isAltTabWindow
+    {
+        get { return GetSnapshotValue(e => e.Has(WindowSnapshotFlag.AltTab), i => Lib.IsAltTabWindow(i)); }
+    }
+
+    public bool isDesktop
+    {
+        get { return GetSnapshotValue(e => e.Has(WindowSnapshotFlag.Desktop), i => Lib.IsDesktop(i)); }
+    }
+
+    public bool isEnabled
+    {
+        get { return GetSnapshotValue(e => e.Has(WindowSnapshotFlag.Enabled), i => Lib.IsWindowEnabled(i)); }
+    }
+
+    public bool isUnicode
+    {
+        get { return Lib.IsWindowUnicode(id); }
+    }
+
+    public bool isZoomed 
+    {
+        get { return GetSnapshotValue(e => e.Has(WindowSnapshotFlag.Zoomed), i => Lib.IsWindowZoomed(i)); }
+    }
+
+    public bool isMaximized
+    {
+        get { return isZoomed; }
+    }
+
+    public bool isIconic
+    {
+        get { return GetSnapshotValue(e => e.Has(WindowSnapshotFlag.Iconic), i => Lib.IsWindowIconic(i)); }
+    }
+
+    public bool isMinimized
+    {
+        get { return isIconic; }
+    }
+
+    public bool isHungup
+    {
+        get { return Lib.IsWindowHungUp(id); }
+    }
+
+    public bool isQuarantined
+    {
+        get { return Lib.IsWindowQuarantined(id); }
+    }
+
+    public bool isTouchable
+    {
+        get { return Lib.IsWindowTouchable(id); }
+    }
+
+    public bool isApplicationFrameWindow
+    {
+        get { return Lib.IsApplicationFrameWindow(id); }
+    }
+
+    public bool isUWP
+    {
+        get { return GetSnapshotValue(e => e.Has(WindowSnapshotFlag.UWP), i => Lib.IsWindowUWP(i)); }
+    }
+
+    public bool isBackground
+    {
+        get { return GetSnapshotValue(e => e.Has(WindowSnapshotFlag.Background), i => Lib.IsWindowBackground(i)); }
+    }
+
+    public string title
+    {
+        get { return Lib.GetWindowTitle(id); } 
+    }
+
+    public string className
+    {
+        get { return Lib.GetWindowClassName(id); } 
+    }
+
+    public int rawX
+    {
+        get { return GetSnapshotValue(e => e.x, i => Lib.GetWindowX(i)); }
+    }
+
+    public int rawY
+    {
+        get { return GetSnapshotValue(e => e.y, i => Lib.GetWindowY(i)); }
+    }
+
+    public int rawWidth
+    {
+        get { return GetSnapshotValue(e => e.width, i => Lib.GetWindowWidth(i)); }
+    }
+
+    public int rawHeight
+    {
+        get { return GetSnapshotValue(e => e.height, i => Lib.GetWindowHeight(i)); }
+    }
+
+    public int x
+    {
+        get { return rawX + Lib.GetWindowTextureOffsetX(id); }
+    }
+
+    public int y
+    {
+        get { return rawY + Lib.GetWindowTextureOffsetY(id); }
+    }
+
+    public int width
+    {
+        get { return Lib.GetWindowTextureWidth(id); }
+    }
+
+    public int height
+    {
+        get { return Lib.GetWindowTextureHeight(id); }
+    }
+
+    public int zOrder
+    {
+        get { return GetSnapshotValue(e => e.zOrder, i => Lib.GetWindowZOrder(i)); }
+    }
+
+    public System.IntPtr buffer
+    {
+        get { return Lib.GetWindowBuffer(id); }
+    }
+
+    public int textureOffsetX
+    {
+        get { return Lib.GetWindowTextureOffsetX(id); }
+    }
+
+    public int textureOffsetY
+    {
+        get { return Lib.GetWindowTextureOffsetY(id); }
+    }
+
+    public int iconWidth
+    {
+        get { return Lib.GetWindowIconWidth(id); }
+    }
+
+    public int iconHeight
+    {
+        get { return Lib.GetWindowIconHeight(id); }
+    }
+
+    private Texture2D backTexture_;
+    private bool willTextureSizeChange_ = false;
+    public Texture2D texture
+    {
+        get;
+        private set;
+    }
+
+    private Texture2D iconTexture_;
+    private Texture2D errorIconTexture_;
+    private bool hasIconTextureCaptured_ = false;
+    public bool hasIconTexture
+    {
+        get { return hasIconTextureCaptured_; }
+    }
+
+    public Texture2D iconTexture
+    {
+        get { return hasIconTextureCaptured_ ? iconTexture_ : errorIconTexture_; }
+    }
+
+    public CaptureMode captureMode
+    {
+        get { return Lib.GetWindowCaptureMode(id); }
+        set { Lib.SetWindowCaptureMode(id, value); }
+    }
+
+    public bool cursorDraw
+    {
+        get { return Lib.GetWindowCursorDraw(id); }
+        set { Lib.SetWindowCursorDraw(id, value); }
+    }
+
+    private UnityEvent onCaptured_ = new UnityEvent();
+    public UnityEvent onCaptured 
+    { 
+        get { return onCaptured_; } 
+    }
+
+    private UnityEvent onSizeChanged_ = new UnityEvent();
+    public UnityEvent onSizeChanged
+    {
+        get { return onSizeChanged_; } 
+    }
+
+    // x, y, width, height
+    public class MovedEvent : UnityEvent<int, int, int, int> {}
+    private MovedEvent onMoved_ = new MovedEvent();
+    public MovedEvent onMoved
+    {
+        get { return onMoved_; } 
+    }
+
+    // zOrder
+    public class ZOrderChangedEvent : UnityEvent<int> {}
+    private ZOrderChangedEvent onZOrderChanged_ = new ZOrderChangedEvent();
+    public ZOrderChangedEvent onZOrderChanged
+    {
+        get { return onZOrderChanged_; } 
+    }
+
+    // title
+    public class TitleChangedEvent : UnityEvent<string> {}
+    private TitleChangedEvent onTitleChanged_ = new TitleChangedEvent();
+    public TitleChangedEvent onTitleChanged
+    {
+        get { return onTitleChanged_; } 
+    }
+
+    // isIconic
+    public class IconicChangedEvent : UnityEvent<bool> {}
+    private IconicChangedEvent onIconicChanged_ = new IconicChangedEvent();
+    public IconicChangedEvent onIconicChanged
+    {
+        get { return onIconicChanged_; } 
+    }
+
+    // HMONITOR
+    public class MonitorChangedEvent : UnityEvent<System.IntPtr> {}
+    private MonitorChangedEvent onMonitorChanged_ = new MonitorChangedEvent();
+    public MonitorChangedEvent onMonitorChanged
+    {
+        get { return onMonitorChanged_; } 
+    }
+
+    // isAltTabWindow, isUWP, isBackground, isTransparent
+    public class AttributesChangedEvent : UnityEvent<bool, bool, bool, bool> {}
+    private AttributesChangedEvent onAttributesChanged_ = new AttributesChangedEvent();
+    public AttributesChangedEvent onAttributesChanged
+    {
+        get { return onAttributesChanged_; } 
+    }
+
+    private UnityEvent onIconCaptured_ = new UnityEvent();
+    public UnityEvent onIconCaptured 
+    { 
+        get { return onIconCaptured_; } 
+    }
+
+    public class ChildAddedEvent : UnityEvent<UwcWindow> {}
+    private ChildAddedEvent onChildAdded_ = new ChildAddedEvent();
+    public ChildAddedEvent onChildAdded
+    { 
+        get { return onChildAdded_; } 
+    }
+
+    public class ChildRemovedEvent : UnityEvent<UwcWindow> {}
+    private ChildRemovedEvent onChildRemoved_ = new ChildRemovedEvent();
+    public ChildRemovedEvent onChildRemoved
+    { 
+        get { return onChildRemoved_; } 
+    }
+
+    public void RequestUpdateTitle()
+    {
+        Lib.RequestUpdateWindowTitle(id);
+    }
+
+    public void RequestCaptureIcon()
+    {
+        Lib.RequestCaptureIcon(id);
+    }
+
+    public void RequestCapture(CapturePriority priority = CapturePriority.High)
+    {
+        if (!texture) {
+            CreateWindowTexture();
+        }
+        Lib.RequestCaptureWindow(id, priority);
+    }
+
+    public int RequestCaptureAsync(CapturePriority priority = CapturePriority.High)
+    {
+        if (!texture) {
+            CreateWindowTexture();
+        }
+        return Lib.RequestCaptureAsync(id, priority);
+    }
+
+    void OnSizeChanged()
+    {
+        // size changes are coalesced per frame, so do not skip any of them;
+        // CreateWindowTexture() does nothing if the texture already has the size.
+        CreateWindowTexture();
+    }
+
+    void OnCaptured()
+    {
+        UpdateWindowTexture();
+    }
+
+    void OnIconCaptured()
+    {
+        hasIconTextureCaptured_ = true;
+    }
+
+    void CreateWindowTexture(bool force = false)
+    {
+        var w = width;
+        var h = height;
+        if (w <= 0 || h <= 0) return;
+
+        var current = willTextureSizeChange_ ? backTexture_ : texture;
+        if (force || !current || current.width != w || current.height != h) {
+            if (backTexture_) {
+                Object.DestroyImmediate(backTexture_);
+            }
+            try {
+                backTexture_ = new Texture2D(w, h, TextureFormat.BGRA32, false);
+                Lib.SetWindowTexturePtr(id, backTexture_.GetNativeTexturePtr());
+                willTextureSizeChange_ = true;
+            } catch (System.Exception e) {
+                Debug.LogError(e.Message);
+                Debug.LogErrorFormat("Width: {0}, Height: {1}", w, h);
+            }
+        }
+    }
+
+    void UpdateWindowTexture()
+    {
+        if (willTextureSizeChange_) {
+            if (texture) {
+                Object.DestroyImmediate(texture);
+            }
+            texture = backTexture_;
+            backTexture_ = null;
+            willTextureSizeChange_ = false;
+        }
+    }
+
+    public void ResetWindowTexture()
+    {
+        CreateWindowTexture(true);
+    }
+
+    void CreateIconTexture()
+    {
+        var w = iconWidth;
+        var h = iconHeight;
+        if (w == 0 || h == 0) return;
+        iconTexture_ = new Texture2D(w, h, TextureFormat.BGRA32, false);
+        iconTexture_.filterMode = FilterMode.Point;
+        Lib.SetWindowIconTexturePtr(id, iconTexture_.GetNativeTexturePtr());
+        errorIconTexture_ = Resources.Load<Texture2D>("uWindowCapture/Textures/uWC_No_Image");
+    }
+
+    public Color32[] GetPixels(int x, int y, int width, int height)
+    {
+        return Lib.GetWindowPixels(id, x, y, width, height);
+    }
+
+    public bool GetPixels(Color32[] colors, int x, int y, int width, int height)
+    {
+        return Lib.GetWindowPixels(id, colors, x, y, width, height);
+    }
+
+    public Color32 GetPixel(int x, int y)
+    {
+        return Lib.GetWindowPixel(id, x, y);
+    }
+}
+
 }
\ No newline at end of file
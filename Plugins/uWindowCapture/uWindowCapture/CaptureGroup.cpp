@@ -0,0 +1,80 @@
+#include "CaptureGroup.h"
+
+
+
+void CaptureGroup::SetMembers(const std::vector<int>& ids)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    memberIds_ = ids;
+}
+
+
+std::vector<int> CaptureGroup::GetMembers() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return memberIds_;
+}
+
+
+void CaptureGroup::Publish(UINT64 timestamp, const std::vector<CaptureGroupMember>& members)
+{
+    UINT capturedCount = 0;
+    UINT64 firstCaptureTime = 0;
+    UINT64 lastCaptureTime = 0;
+    for (const auto& member : members)
+    {
+        if (!member.isCaptured) continue;
+
+        const auto captureTime = member.frame.captureTime;
+        firstCaptureTime = capturedCount == 0 ? captureTime : min(firstCaptureTime, captureTime);
+        lastCaptureTime = capturedCount == 0 ? captureTime : max(lastCaptureTime, captureTime);
+        ++capturedCount;
+    }
+    const auto skew = std::chrono::microseconds(lastCaptureTime - firstCaptureTime);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    frame_.sequence++;
+    frame_.timestamp = timestamp;
+    frame_.memberCount = static_cast<UINT>(members.size());
+    frame_.capturedCount = capturedCount;
+    frame_.skew = skew.count() / 1000.f;
+    frameMembers_ = members;
+
+    if (capturedCount < members.size())
+    {
+        incompleteFrameCount_++;
+    }
+    skew_.Add(skew);
+}
+
+
+void CaptureGroup::GetFrame(CaptureGroupFrame* frame) const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    *frame = frame_;
+}
+
+
+UINT CaptureGroup::GetFrameMembers(CaptureGroupMember* members, UINT capacity) const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    const UINT n = min(capacity, static_cast<UINT>(frameMembers_.size()));
+    for (UINT i = 0; i < n; ++i)
+    {
+        members[i] = frameMembers_[i];
+    }
+
+    return n;
+}
+
+
+void CaptureGroup::GetStats(CaptureGroupStats* stats) const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    stats->frameCount = frame_.sequence;
+    stats->incompleteFrameCount = incompleteFrameCount_;
+    skew_.Get(stats->skewHistogram, &stats->averageSkew, &stats->maxSkew);
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <Windows.h>
+#include <vector>
+#include <mutex>
+
+#include "CaptureRequest.h"
+#include "FrameClock.h"
+
+
+struct CaptureGroupFrame
+{
+    UINT64 sequence;
+    UINT64 timestamp; // [us] when the members were dispatched
+    UINT memberCount;
+    UINT capturedCount;
+    float skew; // [ms] between the captures of the first and the last member
+};
+
+
+struct CaptureGroupMember
+{
+    int windowId;
+    BOOL isCaptured;
+    FrameInfo frame;
+};
+
+
+struct CaptureGroupStats
+{
+    UINT64 frameCount;
+    UINT64 incompleteFrameCount;
+    float averageSkew; // [ms]
+    float maxSkew; // [ms]
+    UINT skewHistogram[kFrameClockHistogramSize];
+};
+
+
+// A set of windows captured at the same instant. A group frame is published
+// at once after all the members have been captured, so readers never see a mix
+// of the members of different group frames. The captured members skip their own
+// captures until the batch of the group frame is uploaded, so their textures show
+// the same group frame too (a member whose capture failed keeps its previous frame).
+class CaptureGroup
+{
+public:
+    void SetMembers(const std::vector<int>& ids);
+    std::vector<int> GetMembers() const;
+
+    void Publish(UINT64 timestamp, const std::vector<CaptureGroupMember>& members);
+    void GetFrame(CaptureGroupFrame* frame) const;
+    UINT GetFrameMembers(CaptureGroupMember* members, UINT capacity) const;
+    void GetStats(CaptureGroupStats* stats) const;
+
+private:
+    mutable std::mutex mutex_;
+    std::vector<int> memberIds_;
+    CaptureGroupFrame frame_ = {};
+    std::vector<CaptureGroupMember> frameMembers_;
+    UINT64 incompleteFrameCount_ = 0;
+    TimeHistogram skew_;
+};
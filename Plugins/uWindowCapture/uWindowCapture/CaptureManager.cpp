@@ -1,103 +1,499 @@
-#include <algorithm>
-#include "CaptureManager.h"
-#include "WindowManager.h"
-#include "Window.h"
-#include "Debug.h"
-#include "Util.h"
-
-using namespace Microsoft::WRL;
-
-
-
-namespace
-{
-    constexpr int kLoopMinTime = 100;
-}
-
-
-// ---
-
-
-CaptureManager::CaptureManager()
-{
-    windowCaptureThreadLoop_.Start([this] 
-    {
-        // at first, check high queue.
-        int id = highPriorityQueue_.Dequeue();
-
-        // move middle queue item to high queue to give chance to middle priority one.
-        if (id >= 0 && !middlePriorityQueue_.Empty())
-        {
-            const auto midId = middlePriorityQueue_.Dequeue();
-            highPriorityQueue_.Enqueue(midId);
-        }
-
-        // second, check imddle queue.
-        if (id < 0)
-        {
-            id = middlePriorityQueue_.Dequeue();
-        }
-
-        // at last, check imddle queue.
-        if (id < 0)
-        {
-            id = lowPriorityQueue_.Dequeue();
-        }
-
-        // update if needed.
-        if (id >= 0 && WindowManager::Get().CheckExistence(id))
-        {
-            if (auto window = WindowManager::Get().GetWindow(id))
-            {
-                window->Capture();
-            }
-        }
-    }, std::chrono::microseconds(kLoopMinTime));
-
-    iconCaptureThreadLoop_.Start([this] 
-    {
-        int id = iconQueue_.Dequeue();
-        if (id >= 0 && WindowManager::Get().CheckExistence(id))
-        {
-            if (auto window = WindowManager::Get().GetWindow(id))
-            {
-                window->CaptureIcon();
-            }
-        }
-    }, std::chrono::microseconds(kLoopMinTime));
-}
-
-
-CaptureManager::~CaptureManager()
-{
-    windowCaptureThreadLoop_.Stop();
-}
-
-
-void CaptureManager::RequestCapture(int id, CapturePriority priority)
-{
-    switch (priority)
-    {
-        case CapturePriority::High:
-        {
-            highPriorityQueue_.Enqueue(id);
-            break;
-        }
-        case CapturePriority::Middle:
-        {
-            middlePriorityQueue_.Enqueue(id);
-            break;
-        }
-        case CapturePriority::Low:
-        {
-            lowPriorityQueue_.Enqueue(id);
-            break;
-        }
-    }
-}
-
-
-void CaptureManager::RequestCaptureIcon(int id)
-{
-    iconQueue_.Enqueue(id);
+#include <algorithm>
+#include "CaptureManager.h"
+#include "WindowManager.h"
+#include "Window.h"
+#include "Debug.h"
+#include "Util.h"
+
+
+
+namespace
+{
+    constexpr int kLoopMinTime = 100;
+    constexpr int kQuarantineLoopMinTime = 10'000;
+    constexpr int kMaxPacingWaitTime = 100'000;
+    constexpr UINT kGroupCaptureWorkerCount = 4;
+}
+
+
+// ---
+
+
+CaptureManager::CaptureManager()
+    : groupCaptureWorkers_(kGroupCaptureWorkerCount)
+{
+    windowCaptureThreadLoop_.Start([this] 
+    {
+        if (!HasQueuedWindow()) return;
+
+        WaitForCaptureDeadline();
+
+        const UINT budget = metrics_.GetBudget();
+        for (UINT i = 0; budget == 0 || i < budget; ++i)
+        {
+            // stop here if the upload stage cannot accept more frames (back-pressure).
+            auto& uploader = WindowManager::GetUploadManager();
+            if (uploader && !uploader->CanRequestUploadWindow()) break;
+
+            // a group takes a single slot of the budget since its members are captured at once.
+            const int groupId = groupQueue_.Dequeue();
+            if (groupId >= 0)
+            {
+                CaptureWindowGroup(groupId);
+                continue;
+            }
+
+            const int id = DequeueWindow();
+            if (id < 0) break;
+
+            CaptureWindow(id);
+        }
+    }, std::chrono::microseconds(kLoopMinTime));
+
+    iconCaptureThreadLoop_.Start([this] 
+    {
+        const int id = iconQueue_.Dequeue();
+        if (id >= 0)
+        {
+            CaptureIcon(id);
+        }
+    }, std::chrono::microseconds(kLoopMinTime));
+
+    // Hung or slow windows are retried here so that they never stall the loops above.
+    quarantineThreadLoop_.Start([this] 
+    {
+        RetryQuarantinedWindows();
+    }, std::chrono::microseconds(kQuarantineLoopMinTime));
+    quarantineThreadLoop_.SetPriority(THREAD_PRIORITY_BELOW_NORMAL);
+}
+
+
+CaptureManager::~CaptureManager()
+{
+    windowCaptureThreadLoop_.Stop();
+    iconCaptureThreadLoop_.Stop();
+    quarantineThreadLoop_.Stop();
+}
+
+
+bool CaptureManager::HasQueuedWindow() const
+{
+    return 
+        !groupQueue_.Empty() || 
+        !highPriorityQueue_.Empty() || 
+        !middlePriorityQueue_.Empty() || 
+        !lowPriorityQueue_.Empty();
+}
+
+
+void CaptureManager::WaitForCaptureDeadline() const
+{
+    if (!isFramePacingEnabled_) return;
+
+    // captures are held back until just before the next render event so that
+    // the frames are as fresh as possible when they are uploaded and rendered.
+    const auto& frameClock = WindowManager::GetFrameClock();
+    if (!frameClock.IsStable()) return;
+
+    const auto now = FrameClock::clock::now();
+    const auto deadline = frameClock.GetNextCaptureDeadline();
+    SleepUntil(min(deadline, now + std::chrono::microseconds(kMaxPacingWaitTime)));
+}
+
+
+int CaptureManager::DequeueWindow()
+{
+    // at first, check high queue.
+    int id = highPriorityQueue_.Dequeue();
+
+    // move middle queue item to high queue to give chance to middle priority one.
+    if (id >= 0 && !middlePriorityQueue_.Empty())
+    {
+        const auto midId = middlePriorityQueue_.Dequeue();
+        highPriorityQueue_.Enqueue(midId);
+    }
+
+    // second, check imddle queue.
+    if (id < 0)
+    {
+        id = middlePriorityQueue_.Dequeue();
+    }
+
+    // at last, check imddle queue.
+    if (id < 0)
+    {
+        id = lowPriorityQueue_.Dequeue();
+    }
+
+    return id;
+}
+
+
+void CaptureManager::CaptureWindow(int id)
+{
+    auto window = WindowManager::Get().GetWindow(id);
+    if (!window)
+    {
+        metrics_.AddDropped();
+        return;
+    }
+
+    const auto attemptTime = GetTimestamp();
+
+    if (window->IsQuarantined())
+    {
+        window->DeferCapture();
+        metrics_.AddDropped();
+        requests_.Fail(id, attemptTime);
+        return;
+    }
+
+    if (IsLateGroupMember(id))
+    {
+        metrics_.AddDropped();
+        requests_.Fail(id, attemptTime);
+        return;
+    }
+
+    ScopedTimer timer([this](std::chrono::microseconds us) 
+    { 
+        metrics_.AddProcessed(us); 
+        WindowManager::GetFrameClock().AddCaptureTime(us);
+    });
+
+    if (!window->Capture())
+    {
+        metrics_.AddDropped();
+        requests_.Fail(id, attemptTime);
+    }
+}
+
+
+void CaptureManager::CaptureIcon(int id)
+{
+    if (auto window = WindowManager::Get().GetWindow(id))
+    {
+        if (window->IsQuarantined())
+        {
+            window->DeferCaptureIcon();
+            return;
+        }
+
+        window->CaptureIcon();
+    }
+}
+
+
+void CaptureManager::CaptureWindowGroup(int groupId)
+{
+    const auto group = GetCaptureGroup(groupId);
+    if (!group) return;
+
+    const auto ids = group->GetMembers();
+    const auto n = ids.size();
+
+    // shared with the tasks since a member which misses the deadline is still running after this returns.
+    const auto captures = std::make_shared<std::vector<GroupMemberCapture>>(n);
+    for (size_t i = 0; i < n; ++i)
+    {
+        auto window = WindowManager::Get().GetWindow(ids[i]);
+        if (!window || IsLateGroupMember(ids[i])) continue;
+
+        if (window->IsQuarantined())
+        {
+            window->DeferCapture();
+            continue;
+        }
+
+        (*captures)[i].window = window;
+    }
+
+    std::vector<WorkerPool::Task> tasks;
+    for (size_t i = 0; i < n; ++i)
+    {
+        if (!(*captures)[i].window) continue;
+
+        tasks.push_back([this, captures, i]
+        {
+            auto& capture = (*captures)[i];
+
+            auto state = GroupMemberState::Pending;
+            if (!capture.state.compare_exchange_strong(state, GroupMemberState::Running)) return;
+
+            {
+                ScopedTimer timer([this](std::chrono::microseconds us) 
+                { 
+                    metrics_.AddProcessed(us); 
+                });
+                capture.hasCaptured = capture.window->CaptureFrame();
+            }
+
+            state = GroupMemberState::Running;
+            if (!capture.state.compare_exchange_strong(state, GroupMemberState::Done))
+            {
+                std::lock_guard<std::mutex> lock(lateGroupMembersMutex_);
+                lateGroupMemberIds_.erase(capture.window->GetId());
+            }
+        });
+    }
+
+    // a hung member must not stall the capture thread, so the group is published without the members
+    // which miss the deadline. the watchdog quarantines them when their calls return.
+    const auto timestamp = GetTimestamp();
+    {
+        ScopedTimer timer([](std::chrono::microseconds us) 
+        { 
+            WindowManager::GetFrameClock().AddCaptureTime(us);
+        });
+        groupCaptureWorkers_.Run(tasks, Watchdog::GetThreshold());
+    }
+
+    std::vector<CaptureGroupMember> members(n);
+    std::vector<int> capturedIds;
+    for (size_t i = 0; i < n; ++i)
+    {
+        auto& capture = (*captures)[i];
+        const bool hasCaptured = capture.window && FinishGroupMemberCapture(capture);
+
+        auto& member = members[i];
+        member.windowId = ids[i];
+        member.isCaptured = hasCaptured;
+        member.frame = hasCaptured ? capture.window->GetCapturedFrame() : FrameInfo();
+
+        if (hasCaptured)
+        {
+            capture.window->OnGroupFrameCaptured();
+            capturedIds.push_back(ids[i]);
+        }
+        else
+        {
+            metrics_.AddDropped();
+            requests_.Fail(ids[i], timestamp);
+        }
+    }
+
+    group->Publish(timestamp, members);
+
+    // the members are uploaded together so that they are rendered in the same frame.
+    if (auto& uploader = WindowManager::GetUploadManager())
+    {
+        uploader->RequestUploadWindows(capturedIds);
+    }
+}
+
+
+bool CaptureManager::FinishGroupMemberCapture(GroupMemberCapture& capture)
+{
+    std::lock_guard<std::mutex> lock(lateGroupMembersMutex_);
+
+    auto state = GroupMemberState::Pending;
+    if (capture.state.compare_exchange_strong(state, GroupMemberState::Abandoned)) return false;
+
+    if (state == GroupMemberState::Running && capture.state.compare_exchange_strong(state, GroupMemberState::Abandoned))
+    {
+        // skipped by the next captures until the running call returns.
+        lateGroupMemberIds_.insert(capture.window->GetId());
+        return false;
+    }
+
+    return capture.hasCaptured;
+}
+
+
+bool CaptureManager::IsLateGroupMember(int id) const
+{
+    std::lock_guard<std::mutex> lock(lateGroupMembersMutex_);
+    return lateGroupMemberIds_.find(id) != lateGroupMemberIds_.end();
+}
+
+
+void CaptureManager::RetryQuarantinedWindows()
+{
+    const UINT n = quarantineQueue_.Size();
+    for (UINT i = 0; i < n; ++i)
+    {
+        const int id = quarantineQueue_.Dequeue();
+        if (id < 0) break;
+
+        auto window = WindowManager::Get().GetWindow(id);
+        if (!window || !window->IsQuarantined()) continue;
+
+        if (window->IsQuarantineRetryDue())
+        {
+            window->RetryInQuarantine();
+        }
+
+        if (window->IsQuarantined())
+        {
+            quarantineQueue_.Enqueue(id);
+        }
+    }
+}
+
+
+bool CaptureManager::RequestCapture(int id, CapturePriority priority)
+{
+    switch (priority)
+    {
+        case CapturePriority::High:
+        {
+            return highPriorityQueue_.Enqueue(id);
+        }
+        case CapturePriority::Middle:
+        {
+            return middlePriorityQueue_.Enqueue(id);
+        }
+        case CapturePriority::Low:
+        {
+            return lowPriorityQueue_.Enqueue(id);
+        }
+    }
+
+    return false;
+}
+
+
+void CaptureManager::RequestCaptureIcon(int id)
+{
+    iconQueue_.Enqueue(id);
+}
+
+
+void CaptureManager::RequestQuarantine(int id)
+{
+    quarantineQueue_.Enqueue(id);
+}
+
+
+int CaptureManager::RequestCaptureAsync(int id, CapturePriority priority)
+{
+    if (!WindowManager::Get().CheckExistence(id)) return -1;
+
+    const int token = requests_.Add(id);
+    if (!RequestCapture(id, priority))
+    {
+        // refused by a full queue (back-pressure).
+        requests_.Fail(id, GetTimestamp());
+    }
+
+    return token;
+}
+
+
+void CaptureManager::CompleteCaptureRequests(int id, const FrameInfo& frame)
+{
+    requests_.Complete(id, frame);
+}
+
+
+void CaptureManager::FailCaptureRequests(int id)
+{
+    requests_.Fail(id);
+}
+
+
+void CaptureManager::FailCaptureRequests(int id, UINT64 requestTime)
+{
+    requests_.Fail(id, requestTime);
+}
+
+
+CaptureRequestState CaptureManager::PollCapture(int token, CaptureResult* result) const
+{
+    return requests_.Poll(token, result);
+}
+
+
+CaptureRequestState CaptureManager::WaitCapture(int token, UINT timeout, CaptureResult* result) const
+{
+    return requests_.Wait(token, timeout, result);
+}
+
+
+UINT CaptureManager::WaitCaptures(const int* tokens, UINT count, UINT timeout, CaptureResult* results) const
+{
+    return requests_.WaitAll(tokens, count, timeout, results);
+}
+
+
+int CaptureManager::CreateCaptureGroup()
+{
+    std::lock_guard<std::mutex> lock(groupsMutex_);
+
+    const int groupId = lastGroupId_++;
+    groups_.emplace(groupId, std::make_shared<CaptureGroup>());
+
+    return groupId;
+}
+
+
+void CaptureManager::DestroyCaptureGroup(int groupId)
+{
+    std::lock_guard<std::mutex> lock(groupsMutex_);
+    groups_.erase(groupId);
+}
+
+
+bool CaptureManager::SetCaptureGroupMembers(int groupId, const std::vector<int>& ids)
+{
+    if (const auto group = GetCaptureGroup(groupId))
+    {
+        group->SetMembers(ids);
+        return true;
+    }
+    return false;
+}
+
+
+void CaptureManager::RequestCaptureGroup(int groupId)
+{
+    groupQueue_.Enqueue(groupId);
+}
+
+
+std::shared_ptr<CaptureGroup> CaptureManager::GetCaptureGroup(int groupId) const
+{
+    std::lock_guard<std::mutex> lock(groupsMutex_);
+
+    const auto it = groups_.find(groupId);
+    if (it == groups_.end()) return nullptr;
+
+    return it->second;
+}
+
+
+void CaptureManager::SetFramePacing(bool enabled)
+{
+    isFramePacingEnabled_ = enabled;
+}
+
+
+bool CaptureManager::IsFramePacingEnabled() const
+{
+    return isFramePacingEnabled_;
+}
+
+
+void CaptureManager::SetBudget(UINT budget)
+{
+    metrics_.SetBudget(budget);
+}
+
+
+void CaptureManager::SetQueue(UINT capacity, QueuePolicy policy)
+{
+    for (auto* queue : { &highPriorityQueue_, &middlePriorityQueue_, &lowPriorityQueue_ })
+    {
+        queue->SetCapacity(capacity);
+        queue->SetPolicy(policy);
+    }
+}
+
+
+void CaptureManager::GetStats(PipelineStageStats* stats) const
+{
+    const auto queueStats = MergeQueueStats(
+        MergeQueueStats(highPriorityQueue_.GetStats(), middlePriorityQueue_.GetStats()),
+        lowPriorityQueue_.GetStats());
+    metrics_.GetStats(stats, queueStats, highPriorityQueue_.GetCapacity());
 }
\ No newline at end of file
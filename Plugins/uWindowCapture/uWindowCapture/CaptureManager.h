@@ -1,34 +1,107 @@
-#pragma once
-
-#include <Windows.h>
-#include <deque>
-#include <mutex>
-
-#include "WindowQueue.h"
-#include "Thread.h"
-
-
-enum class CapturePriority
-{
-    High = 0,
-    Middle = 1,
-    Low  = 2,
-};
-
-
-class CaptureManager
-{
-public:
-    CaptureManager();
-    ~CaptureManager();
-    void RequestCapture(int id, CapturePriority priority);
-    void RequestCaptureIcon(int id);
-
-private:
-    ThreadLoop windowCaptureThreadLoop_;
-    ThreadLoop iconCaptureThreadLoop_;
-    WindowQueue highPriorityQueue_;
-    WindowQueue middlePriorityQueue_;
-    WindowQueue lowPriorityQueue_;
-    WindowQueue iconQueue_;
+#pragma once
+
+#include <Windows.h>
+#include <deque>
+#include <mutex>
+#include <atomic>
+#include <map>
+#include <unordered_set>
+#include <memory>
+#include <vector>
+
+#include "WindowQueue.h"
+#include "CaptureRequest.h"
+#include "CaptureGroup.h"
+#include "Pipeline.h"
+#include "Thread.h"
+
+
+class Window;
+
+
+enum class CapturePriority
+{
+    High = 0,
+    Middle = 1,
+    Low  = 2,
+};
+
+
+enum class GroupMemberState
+{
+    Pending,
+    Running,
+    Done,
+    Abandoned, // missed the deadline of the group
+};
+
+
+struct GroupMemberCapture
+{
+    std::shared_ptr<Window> window;
+    std::atomic<GroupMemberState> state = GroupMemberState::Pending;
+    bool hasCaptured = false;
+};
+
+
+class CaptureManager
+{
+public:
+    CaptureManager();
+    ~CaptureManager();
+    bool RequestCapture(int id, CapturePriority priority);
+    void RequestCaptureIcon(int id);
+    void RequestQuarantine(int id);
+
+    int RequestCaptureAsync(int id, CapturePriority priority);
+    void CompleteCaptureRequests(int id, const FrameInfo& frame);
+    void FailCaptureRequests(int id);
+    void FailCaptureRequests(int id, UINT64 requestTime);
+    CaptureRequestState PollCapture(int token, CaptureResult* result) const;
+    CaptureRequestState WaitCapture(int token, UINT timeout, CaptureResult* result) const;
+    UINT WaitCaptures(const int* tokens, UINT count, UINT timeout, CaptureResult* results) const;
+
+    int CreateCaptureGroup();
+    void DestroyCaptureGroup(int groupId);
+    bool SetCaptureGroupMembers(int groupId, const std::vector<int>& ids);
+    void RequestCaptureGroup(int groupId);
+    std::shared_ptr<CaptureGroup> GetCaptureGroup(int groupId) const;
+
+    void SetFramePacing(bool enabled);
+    bool IsFramePacingEnabled() const;
+
+    void SetBudget(UINT budget);
+    void SetQueue(UINT capacity, QueuePolicy policy);
+    void GetStats(PipelineStageStats* stats) const;
+
+private:
+    bool HasQueuedWindow() const;
+    void WaitForCaptureDeadline() const;
+    int DequeueWindow();
+    void CaptureWindow(int id);
+    void CaptureIcon(int id);
+    void CaptureWindowGroup(int groupId);
+    bool FinishGroupMemberCapture(GroupMemberCapture& capture);
+    bool IsLateGroupMember(int id) const;
+    void RetryQuarantinedWindows();
+
+    ThreadLoop windowCaptureThreadLoop_;
+    ThreadLoop iconCaptureThreadLoop_;
+    ThreadLoop quarantineThreadLoop_;
+    WindowQueue highPriorityQueue_;
+    WindowQueue middlePriorityQueue_;
+    WindowQueue lowPriorityQueue_;
+    WindowQueue iconQueue_;
+    WindowQueue quarantineQueue_;
+    WindowQueue groupQueue_;
+    StageMetrics metrics_ { 1 };
+    CaptureRequestTracker requests_;
+    std::atomic<bool> isFramePacingEnabled_ = false;
+
+    std::map<int, std::shared_ptr<CaptureGroup>> groups_;
+    int lastGroupId_ = 0;
+    mutable std::mutex groupsMutex_;
+    std::unordered_set<int> lateGroupMemberIds_;
+    mutable std::mutex lateGroupMembersMutex_;
+    WorkerPool groupCaptureWorkers_; // destroyed first since the tasks touch the members above.
 };
\ No newline at end of file
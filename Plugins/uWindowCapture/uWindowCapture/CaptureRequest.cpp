@@ -0,0 +1,223 @@
+#include <algorithm>
+#include <chrono>
+#include "CaptureRequest.h"
+#include "Util.h"
+
+
+
+namespace
+{
+    // results of finished requests are kept until this many newer ones have finished.
+    constexpr size_t kMaxFinishedRequests = 1024;
+
+    // requests which have not finished within this time are failed.
+    constexpr UINT64 kRequestTimeout = 10'000'000; // [us]
+}
+
+
+// ---
+
+
+int CaptureRequestTracker::Add(int windowId)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    ExpirePendingTokens();
+
+    const int token = ++lastToken_;
+
+    CaptureResult result = {};
+    result.state = CaptureRequestState::Pending;
+    result.windowId = windowId;
+    result.requestTime = GetTimestamp();
+    results_.emplace(token, result);
+    pendingTokens_[windowId].push_back(token);
+
+    return token;
+}
+
+
+void CaptureRequestTracker::Complete(int windowId, const FrameInfo& frame)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        auto it = pendingTokens_.find(windowId);
+        if (it == pendingTokens_.end()) return;
+
+        auto& tokens = it->second;
+        const auto last = std::remove_if(tokens.begin(), tokens.end(), [&](int token)
+        {
+            // frames whose capture started before the request do not satisfy it.
+            if (frame.captureTime < results_[token].requestTime) return false;
+            Finish(token, CaptureRequestState::Completed, frame);
+            return true;
+        });
+        if (last == tokens.end()) return;
+
+        tokens.erase(last, tokens.end());
+        if (tokens.empty())
+        {
+            pendingTokens_.erase(it);
+        }
+    }
+
+    cv_.notify_all();
+}
+
+
+void CaptureRequestTracker::Fail(int windowId)
+{
+    Fail(windowId, ~0ull);
+}
+
+
+void CaptureRequestTracker::Fail(int windowId, UINT64 requestTime)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        auto it = pendingTokens_.find(windowId);
+        if (it == pendingTokens_.end()) return;
+
+        auto& tokens = it->second;
+        const auto last = std::remove_if(tokens.begin(), tokens.end(), [&](int token)
+        {
+            // requests issued after the failed attempt may still be satisfied by the next frame.
+            if (results_[token].requestTime > requestTime) return false;
+            Finish(token, CaptureRequestState::Failed, FrameInfo());
+            return true;
+        });
+        if (last == tokens.end()) return;
+
+        tokens.erase(last, tokens.end());
+        if (tokens.empty())
+        {
+            pendingTokens_.erase(it);
+        }
+    }
+
+    cv_.notify_all();
+}
+
+
+void CaptureRequestTracker::ExpirePendingTokens()
+{
+    const UINT64 now = GetTimestamp();
+    if (now < kRequestTimeout) return;
+
+    for (auto it = pendingTokens_.begin(); it != pendingTokens_.end();)
+    {
+        auto& tokens = it->second;
+        const auto last = std::remove_if(tokens.begin(), tokens.end(), [&](int token)
+        {
+            if (results_[token].requestTime > now - kRequestTimeout) return false;
+            Finish(token, CaptureRequestState::Failed, FrameInfo());
+            return true;
+        });
+        tokens.erase(last, tokens.end());
+
+        if (tokens.empty())
+        {
+            it = pendingTokens_.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+}
+
+
+void CaptureRequestTracker::Finish(int token, CaptureRequestState state, const FrameInfo& frame)
+{
+    auto& result = results_[token];
+    result.state = state;
+    result.frameSequence = frame.sequence;
+    result.captureTime = frame.captureTime;
+    result.uploadTime = frame.uploadTime;
+    result.renderTime = frame.renderTime;
+
+    finishedTokens_.push_back(token);
+    while (finishedTokens_.size() > kMaxFinishedRequests)
+    {
+        results_.erase(finishedTokens_.front());
+        finishedTokens_.pop_front();
+    }
+}
+
+
+CaptureRequestState CaptureRequestTracker::GetResult(int token, CaptureResult* result) const
+{
+    const auto it = results_.find(token);
+    if (it == results_.end())
+    {
+        if (result)
+        {
+            *result = {};
+            result->state = CaptureRequestState::Unknown;
+            result->windowId = -1;
+        }
+        return CaptureRequestState::Unknown;
+    }
+
+    // expired requests are reported as failed before the next Add() removes them.
+    auto state = it->second.state;
+    if (state == CaptureRequestState::Pending && GetTimestamp() > it->second.requestTime + kRequestTimeout)
+    {
+        state = CaptureRequestState::Failed;
+    }
+
+    if (result)
+    {
+        *result = it->second;
+        result->state = state;
+    }
+    return state;
+}
+
+
+CaptureRequestState CaptureRequestTracker::Poll(int token, CaptureResult* result) const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return GetResult(token, result);
+}
+
+
+CaptureRequestState CaptureRequestTracker::Wait(int token, UINT timeout, CaptureResult* result) const
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    cv_.wait_for(lock, std::chrono::milliseconds(timeout), [&]
+    {
+        return GetResult(token, nullptr) != CaptureRequestState::Pending;
+    });
+
+    return GetResult(token, result);
+}
+
+
+UINT CaptureRequestTracker::WaitAll(const int* tokens, UINT count, UINT timeout, CaptureResult* results) const
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    cv_.wait_for(lock, std::chrono::milliseconds(timeout), [&]
+    {
+        for (UINT i = 0; i < count; ++i)
+        {
+            if (GetResult(tokens[i], nullptr) == CaptureRequestState::Pending) return false;
+        }
+        return true;
+    });
+
+    UINT finishedCount = 0;
+    for (UINT i = 0; i < count; ++i)
+    {
+        if (GetResult(tokens[i], results ? &results[i] : nullptr) != CaptureRequestState::Pending)
+        {
+            ++finishedCount;
+        }
+    }
+
+    return finishedCount;
+}
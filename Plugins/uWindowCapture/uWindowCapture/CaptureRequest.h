@@ -0,0 +1,70 @@
+#pragma once
+
+#include <Windows.h>
+#include <map>
+#include <deque>
+#include <vector>
+#include <mutex>
+#include <condition_variable>
+
+
+struct FrameInfo
+{
+    UINT64 sequence = 0;
+    UINT64 captureTime = 0; // [us]
+    UINT64 uploadTime = 0; // [us]
+    UINT64 renderTime = 0; // [us]
+};
+
+
+enum class CaptureRequestState
+{
+    Unknown = -1,
+    Pending = 0,
+    Completed = 1,
+    Failed = 2,
+};
+
+
+struct CaptureResult
+{
+    CaptureRequestState state;
+    int windowId;
+    UINT64 frameSequence;
+    UINT64 requestTime; // [us]
+    UINT64 captureTime; // [us]
+    UINT64 uploadTime; // [us]
+    UINT64 renderTime; // [us]
+};
+
+
+// Keeps track of the capture requests issued through the async API.
+// A request completes when a frame whose capture has started after the request reaches
+// the last stage it can (render, or upload when no texture has been set for the window).
+// It fails when the capture or the upload of that frame fails, when the window goes away,
+// or when nothing has finished it within the timeout.
+// Textured windows complete only after TriggerGpuUpload() and the render event,
+// so waiting for them on Unity's main thread never succeeds before the timeout.
+class CaptureRequestTracker
+{
+public:
+    int Add(int windowId);
+    void Complete(int windowId, const FrameInfo& frame);
+    void Fail(int windowId);
+    void Fail(int windowId, UINT64 requestTime); // only the requests issued until requestTime [us]
+    CaptureRequestState Poll(int token, CaptureResult* result) const;
+    CaptureRequestState Wait(int token, UINT timeout, CaptureResult* result) const;
+    UINT WaitAll(const int* tokens, UINT count, UINT timeout, CaptureResult* results) const;
+
+private:
+    CaptureRequestState GetResult(int token, CaptureResult* result) const;
+    void Finish(int token, CaptureRequestState state, const FrameInfo& frame);
+    void ExpirePendingTokens();
+
+    mutable std::mutex mutex_;
+    mutable std::condition_variable cv_;
+    int lastToken_ = 0;
+    std::map<int, CaptureResult> results_;
+    std::map<int, std::vector<int>> pendingTokens_;
+    std::deque<int> finishedTokens_;
+};
@@ -0,0 +1,341 @@
+#include "D3D11GraphicsBackend.h"
+#include "Unity.h"
+#include "Debug.h"
+
+#pragma comment(lib, "d3d11.lib")
+
+using namespace Microsoft::WRL;
+
+
+
+D3D11SharedTexture::D3D11SharedTexture(const ComPtr<ID3D11Texture2D>& texture, HANDLE handle)
+    : texture_(texture)
+    , handle_(handle)
+{
+    texture_->GetDesc(&desc_);
+}
+
+
+UINT D3D11SharedTexture::GetWidth() const
+{
+    return desc_.Width;
+}
+
+
+UINT D3D11SharedTexture::GetHeight() const
+{
+    return desc_.Height;
+}
+
+
+SharedTextureDesc D3D11SharedTexture::GetDesc() const
+{
+    return { desc_.Width, desc_.Height, static_cast<UINT>(desc_.Format) };
+}
+
+
+ID3D11Texture2D* D3D11SharedTexture::GetTexture() const
+{
+    return texture_.Get();
+}
+
+
+HANDLE D3D11SharedTexture::GetHandle() const
+{
+    return handle_;
+}
+
+
+ID3D11Texture2D* D3D11SharedTexture::GetOpenedTexture(ID3D11Device* device) const
+{
+    return (device == openedDevice_) ? openedTexture_.Get() : nullptr;
+}
+
+
+void D3D11SharedTexture::SetOpenedTexture(ID3D11Device* device, const ComPtr<ID3D11Texture2D>& texture)
+{
+    openedDevice_ = device;
+    openedTexture_ = texture;
+}
+
+
+// ---
+
+
+D3D11GpuFence::D3D11GpuFence(const ComPtr<ID3D11DeviceContext>& context, const ComPtr<ID3D11Query>& query)
+    : context_(context)
+    , query_(query)
+{
+}
+
+
+void D3D11GpuFence::Signal()
+{
+    context_->End(query_.Get());
+    isSignaled_ = true;
+}
+
+
+bool D3D11GpuFence::IsCompleted()
+{
+    if (!isSignaled_) return true;
+
+    // DONOTFLUSH since the queue is flushed by its owner anyway.
+    if (context_->GetData(query_.Get(), nullptr, 0, D3D11_ASYNC_GETDATA_DONOTFLUSH) != S_OK) return false;
+
+    isSignaled_ = false;
+    return true;
+}
+
+
+// ---
+
+
+D3D11GraphicsBackend::D3D11GraphicsBackend()
+{
+    CreateDevice();
+}
+
+
+void D3D11GraphicsBackend::CreateDevice()
+{
+    ComPtr<IDXGIDevice1> dxgiDevice;
+    if (FAILED(GetUnityDevice()->QueryInterface(IID_PPV_ARGS(&dxgiDevice)))) {
+        Debug::Error(__FUNCTION__, " => QueryInterface from IUnityGraphicsD3D11 to IDXGIDevice1 failed.");
+        return;
+    }
+
+    ComPtr<IDXGIAdapter> dxgiAdapter;
+    if (FAILED(dxgiDevice->GetAdapter(&dxgiAdapter))) {
+        Debug::Error(__FUNCTION__, " => QueryInterface from IDXGIDevice1 to IDXGIAdapter failed.");
+        return;
+    }
+
+    const auto driverType = D3D_DRIVER_TYPE_UNKNOWN;
+    const auto flags = D3D11_CREATE_DEVICE_BGRA_SUPPORT;
+    const D3D_FEATURE_LEVEL featureLevelsRequested[] =
+    {
+        D3D_FEATURE_LEVEL_11_0,
+        D3D_FEATURE_LEVEL_10_1,
+        D3D_FEATURE_LEVEL_10_0,
+        D3D_FEATURE_LEVEL_9_3,
+        D3D_FEATURE_LEVEL_9_2,
+        D3D_FEATURE_LEVEL_9_1
+    };
+    const UINT numLevelsRequested = sizeof(featureLevelsRequested) / sizeof(D3D_FEATURE_LEVEL);
+    D3D_FEATURE_LEVEL featureLevelsSupported;
+
+    D3D11CreateDevice(
+        dxgiAdapter.Get(),
+        driverType,
+        nullptr,
+        flags,
+        featureLevelsRequested,
+        numLevelsRequested,
+        D3D11_SDK_VERSION,
+        &device_,
+        &featureLevelsSupported,
+        nullptr);
+
+    if (device_)
+    {
+        device_->GetImmediateContext(&context_);
+    }
+}
+
+
+bool D3D11GraphicsBackend::IsValid() const
+{
+    return device_ && context_;
+}
+
+
+const char* D3D11GraphicsBackend::GetName() const
+{
+    return "D3D11";
+}
+
+
+bool D3D11GraphicsBackend::GetUnityTextureSize(ID3D11Texture2D* unityTexture, UINT* width, UINT* height) const
+{
+    if (!unityTexture) return false;
+
+    D3D11_TEXTURE2D_DESC desc;
+    unityTexture->GetDesc(&desc);
+    *width = desc.Width;
+    *height = desc.Height;
+    return true;
+}
+
+
+bool D3D11GraphicsBackend::GetUnityTextureDesc(ID3D11Texture2D* unityTexture, SharedTextureDesc* desc) const
+{
+    if (!unityTexture) return false;
+
+    D3D11_TEXTURE2D_DESC textureDesc;
+    unityTexture->GetDesc(&textureDesc);
+    *desc = { textureDesc.Width, textureDesc.Height, static_cast<UINT>(textureDesc.Format) };
+    return true;
+}
+
+
+std::shared_ptr<IGpuFence> D3D11GraphicsBackend::CreateFence(GpuQueue queue)
+{
+    ComPtr<ID3D11Device> device;
+    ComPtr<ID3D11DeviceContext> context;
+    if (queue == GpuQueue::Upload)
+    {
+        device = device_;
+        context = context_;
+    }
+    else
+    {
+        device = GetUnityDevice();
+        if (device) context = GetUnityContext(device.Get());
+    }
+
+    if (!device || !context) return nullptr;
+
+    D3D11_QUERY_DESC desc;
+    desc.Query = D3D11_QUERY_EVENT;
+    desc.MiscFlags = 0;
+
+    ComPtr<ID3D11Query> query;
+    if (FAILED(device->CreateQuery(&desc, &query)))
+    {
+        Debug::Error(__FUNCTION__, " => CreateQuery() failed.");
+        return nullptr;
+    }
+
+    return std::make_shared<D3D11GpuFence>(context, query);
+}
+
+
+std::shared_ptr<ISharedTexture> D3D11GraphicsBackend::CreateSharedTexture(ID3D11Texture2D* unityTexture)
+{
+    if (!device_)
+    {
+        Debug::Error(__FUNCTION__, "device has not been created yet.");
+        return nullptr;
+    }
+
+    D3D11_TEXTURE2D_DESC desc;
+    unityTexture->GetDesc(&desc);
+    desc.MiscFlags = D3D11_RESOURCE_MISC_SHARED;
+
+    ComPtr<ID3D11Texture2D> texture;
+    if (FAILED(device_->CreateTexture2D(&desc, nullptr, &texture)))
+    {
+        Debug::Error(__FUNCTION__, " => CreateTexture2D() failed.");
+        return nullptr;
+    }
+
+    ComPtr<IDXGIResource> dxgiResource;
+    texture.As(&dxgiResource);
+
+    HANDLE handle;
+    if (FAILED(dxgiResource->GetSharedHandle(&handle)))
+    {
+        Debug::Error(__FUNCTION__, " => GetSharedHandle() failed.");
+        return nullptr;
+    }
+
+    return std::make_shared<D3D11SharedTexture>(texture, handle);
+}
+
+
+bool D3D11GraphicsBackend::UpdateSharedTexture(ISharedTexture* texture, const BYTE* data, UINT pitch)
+{
+    const auto sharedTexture = static_cast<D3D11SharedTexture*>(texture);
+    if (!context_ || !sharedTexture) return false;
+
+    context_->UpdateSubresource(sharedTexture->GetTexture(), 0, nullptr, data, pitch, 0);
+    return true;
+}
+
+
+bool D3D11GraphicsBackend::UpdateSharedTextureRegion(ISharedTexture* texture, const RECT& region, const BYTE* data, UINT pitch)
+{
+    const auto sharedTexture = static_cast<D3D11SharedTexture*>(texture);
+    if (!context_ || !sharedTexture) return false;
+
+    if (region.left < 0 || region.top < 0 ||
+        region.right <= region.left || region.bottom <= region.top ||
+        static_cast<UINT>(region.right) > sharedTexture->GetWidth() ||
+        static_cast<UINT>(region.bottom) > sharedTexture->GetHeight())
+    {
+        Debug::Error(__FUNCTION__, " => Region is out of the texture.");
+        return false;
+    }
+
+    D3D11_BOX box;
+    box.left = region.left;
+    box.top = region.top;
+    box.front = 0;
+    box.right = region.right;
+    box.bottom = region.bottom;
+    box.back = 1;
+    context_->UpdateSubresource(sharedTexture->GetTexture(), 0, &box, data, pitch, 0);
+    return true;
+}
+
+
+void D3D11GraphicsBackend::Flush()
+{
+    if (context_)
+    {
+        context_->Flush();
+    }
+}
+
+
+bool D3D11GraphicsBackend::CopyToUnityTexture(ISharedTexture* texture, ID3D11Texture2D* unityTexture)
+{
+    const auto sharedTexture = static_cast<D3D11SharedTexture*>(texture);
+    if (!sharedTexture || !unityTexture) return false;
+
+    const auto unityDevice = GetUnityDevice();
+    if (!unityDevice) return false;
+
+    auto openedTexture = sharedTexture->GetOpenedTexture(unityDevice);
+    if (openedTexture)
+    {
+        reuseCount_++;
+    }
+    else
+    {
+        ComPtr<ID3D11Texture2D> texture;
+        if (FAILED(unityDevice->OpenSharedResource(sharedTexture->GetHandle(), __uuidof(ID3D11Texture2D), &texture)))
+        {
+            Debug::Error(__FUNCTION__, " => OpenSharedResource() failed.");
+            return false;
+        }
+        sharedTexture->SetOpenedTexture(unityDevice, texture);
+        openedTexture = texture.Get();
+        openCount_++;
+    }
+
+    GetUnityContext(unityDevice)->CopyResource(unityTexture, openedTexture);
+    return true;
+}
+
+
+ID3D11DeviceContext* D3D11GraphicsBackend::GetUnityContext(ID3D11Device* unityDevice)
+{
+    // Unity recreates its device only in rare cases such as a device lost.
+    if (unityDevice != unityDevice_ || !unityContext_)
+    {
+        unityContext_.Reset();
+        unityDevice->GetImmediateContext(&unityContext_);
+        unityDevice_ = unityDevice;
+    }
+
+    return unityContext_.Get();
+}
+
+
+void D3D11GraphicsBackend::GetSharedResourceStats(UINT64* openCount, UINT64* reuseCount) const
+{
+    *openCount = openCount_;
+    *reuseCount = reuseCount_;
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <d3d11.h>
+#include <wrl/client.h>
+#include <atomic>
+
+#include "GraphicsBackend.h"
+
+
+class D3D11SharedTexture : public ISharedTexture
+{
+public:
+    D3D11SharedTexture(const Microsoft::WRL::ComPtr<ID3D11Texture2D>& texture, HANDLE handle);
+    UINT GetWidth() const override;
+    UINT GetHeight() const override;
+    SharedTextureDesc GetDesc() const override;
+
+    ID3D11Texture2D* GetTexture() const;
+    HANDLE GetHandle() const;
+
+    // render thread
+    ID3D11Texture2D* GetOpenedTexture(ID3D11Device* device) const;
+    void SetOpenedTexture(ID3D11Device* device, const Microsoft::WRL::ComPtr<ID3D11Texture2D>& texture);
+
+private:
+    Microsoft::WRL::ComPtr<ID3D11Texture2D> texture_;
+    HANDLE handle_ = nullptr;
+    D3D11_TEXTURE2D_DESC desc_;
+
+    // a new shared texture is created when the size changes, so this is never stale.
+    ID3D11Device* openedDevice_ = nullptr;
+    Microsoft::WRL::ComPtr<ID3D11Texture2D> openedTexture_;
+};
+
+
+class D3D11GpuFence : public IGpuFence
+{
+public:
+    D3D11GpuFence(const Microsoft::WRL::ComPtr<ID3D11DeviceContext>& context, const Microsoft::WRL::ComPtr<ID3D11Query>& query);
+    void Signal() override;
+    bool IsCompleted() override;
+
+private:
+    Microsoft::WRL::ComPtr<ID3D11DeviceContext> context_;
+    Microsoft::WRL::ComPtr<ID3D11Query> query_;
+    bool isSignaled_ = false;
+};
+
+
+// Uploads with its own device on the same adapter as Unity's one, 
+// and the render thread opens the shared texture on Unity's device to copy it.
+class D3D11GraphicsBackend : public IGraphicsBackend
+{
+public:
+    D3D11GraphicsBackend();
+    bool IsValid() const;
+
+    const char* GetName() const override;
+    bool GetUnityTextureSize(ID3D11Texture2D* unityTexture, UINT* width, UINT* height) const override;
+    bool GetUnityTextureDesc(ID3D11Texture2D* unityTexture, SharedTextureDesc* desc) const override;
+    std::shared_ptr<IGpuFence> CreateFence(GpuQueue queue) override;
+
+    std::shared_ptr<ISharedTexture> CreateSharedTexture(ID3D11Texture2D* unityTexture) override;
+    bool UpdateSharedTexture(ISharedTexture* texture, const BYTE* data, UINT pitch) override;
+    bool UpdateSharedTextureRegion(ISharedTexture* texture, const RECT& region, const BYTE* data, UINT pitch) override;
+    void Flush() override;
+
+    bool CopyToUnityTexture(ISharedTexture* texture, ID3D11Texture2D* unityTexture) override;
+    void GetSharedResourceStats(UINT64* openCount, UINT64* reuseCount) const override;
+
+private:
+    void CreateDevice();
+    ID3D11DeviceContext* GetUnityContext(ID3D11Device* unityDevice);
+
+    Microsoft::WRL::ComPtr<ID3D11Device> device_;
+    Microsoft::WRL::ComPtr<ID3D11DeviceContext> context_;
+
+    // render thread
+    ID3D11Device* unityDevice_ = nullptr;
+    Microsoft::WRL::ComPtr<ID3D11DeviceContext> unityContext_;
+    std::atomic<UINT64> openCount_ = 0;
+    std::atomic<UINT64> reuseCount_ = 0;
+};
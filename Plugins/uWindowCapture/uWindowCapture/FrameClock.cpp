@@ -0,0 +1,167 @@
+#include <cmath>
+#include "FrameClock.h"
+
+
+
+namespace
+{
+    constexpr double kSmoothingFactor = 0.1;
+    constexpr UINT64 kMinFrameCountToPace = 8;
+    constexpr double kOutlierRatio = 3.0;
+    constexpr UINT kOutlierCountToReset = 3;
+    constexpr int kLeadMargin = 1000; // [us]
+    constexpr double kMaxLeadRatio = 0.9;
+
+    float ToMilliseconds(std::chrono::microseconds us)
+    {
+        return us.count() / 1000.f;
+    }
+}
+
+
+// ---
+
+
+void TimeHistogram::Add(microseconds time)
+{
+    UINT i = 0;
+    auto upper = microseconds(250);
+    while (i < kFrameClockHistogramSize - 1 && time >= upper)
+    {
+        ++i;
+        upper *= 2;
+    }
+
+    buckets_[i]++;
+    count_++;
+    total_ += time;
+    max_ = max(max_, time);
+}
+
+
+void TimeHistogram::Get(UINT* buckets, float* average, float* maxTime) const
+{
+    for (UINT i = 0; i < kFrameClockHistogramSize; ++i)
+    {
+        buckets[i] = buckets_[i];
+    }
+    *average = count_ > 0 ? ToMilliseconds(total_) / count_ : 0.f;
+    *maxTime = ToMilliseconds(max_);
+}
+
+
+// ---
+
+
+void FrameClock::Tick()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    const auto now = clock::now();
+
+    if (frameCount_ > 0)
+    {
+        const auto interval = std::chrono::duration_cast<microseconds>(now - lastTickTime_);
+        const double intervalUs = static_cast<double>(interval.count());
+
+        if (period_ == 0.0)
+        {
+            period_ = intervalUs;
+        }
+        else
+        {
+            jitter_.Add(microseconds(std::llround(std::abs(intervalUs - period_))));
+
+            // a hitch (or a pause of the app) should not disturb the estimate,
+            // but a lasting change of the frame rate should be followed quickly.
+            if (intervalUs > period_ * kOutlierRatio || intervalUs < period_ / kOutlierRatio)
+            {
+                if (++outlierCount_ >= kOutlierCountToReset)
+                {
+                    period_ = intervalUs;
+                    outlierCount_ = 0;
+                }
+            }
+            else
+            {
+                period_ += (intervalUs - period_) * kSmoothingFactor;
+                outlierCount_ = 0;
+            }
+        }
+
+        const double captureTime = static_cast<double>(captureTimeInFrame_.count());
+        captureTimePerFrame_ += (captureTime - captureTimePerFrame_) * kSmoothingFactor;
+        captureTimeInFrame_ = microseconds::zero();
+    }
+
+    lastTickTime_ = now;
+    frameCount_++;
+}
+
+
+bool FrameClock::IsStable() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    if (frameCount_ < kMinFrameCountToPace || period_ == 0.0) return false;
+
+    // render events have stopped (e.g. the app is minimized), so do not wait for them.
+    return clock::now() - lastTickTime_ < GetPeriod() * kOutlierRatio;
+}
+
+
+FrameClock::clock::time_point FrameClock::GetNextCaptureDeadline() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    const auto now = clock::now();
+    const auto period = GetPeriod();
+    if (period <= microseconds::zero()) return now;
+
+    const auto elapsedFrameCount = (now - lastTickTime_) / period;
+    const auto nextRenderTime = lastTickTime_ + period * (elapsedFrameCount + 1);
+    const auto deadline = nextRenderTime - GetLead();
+
+    // already in the capture window of the next render.
+    return deadline > now ? deadline : now;
+}
+
+
+void FrameClock::AddCaptureTime(microseconds time)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    captureTimeInFrame_ += time;
+}
+
+
+void FrameClock::AddLatency(microseconds latency)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    latency_.Add(latency);
+}
+
+
+void FrameClock::GetStats(FrameClockStats* stats) const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    stats->frameCount = frameCount_;
+    stats->period = ToMilliseconds(GetPeriod());
+    stats->lead = ToMilliseconds(GetLead());
+    jitter_.Get(stats->jitterHistogram, &stats->averageJitter, &stats->maxJitter);
+    latency_.Get(stats->latencyHistogram, &stats->averageLatency, &stats->maxLatency);
+}
+
+
+FrameClock::microseconds FrameClock::GetPeriod() const
+{
+    return microseconds(std::llround(period_));
+}
+
+
+FrameClock::microseconds FrameClock::GetLead() const
+{
+    const auto lead = microseconds(std::llround(captureTimePerFrame_) + kLeadMargin);
+    const auto maxLead = microseconds(std::llround(period_ * kMaxLeadRatio));
+    return min(lead, maxLead);
+}
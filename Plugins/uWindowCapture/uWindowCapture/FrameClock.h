@@ -0,0 +1,71 @@
+#pragma once
+
+#include <Windows.h>
+#include <chrono>
+#include <mutex>
+
+
+// bucket i counts samples below 0.25 * 2^i [ms], and the last one counts the rest.
+constexpr UINT kFrameClockHistogramSize = 12;
+
+
+struct FrameClockStats
+{
+    UINT64 frameCount;
+    float period; // [ms]
+    float lead; // [ms]
+    float averageJitter; // [ms]
+    float maxJitter; // [ms]
+    float averageLatency; // [ms]
+    float maxLatency; // [ms]
+    UINT jitterHistogram[kFrameClockHistogramSize];
+    UINT latencyHistogram[kFrameClockHistogramSize];
+};
+
+
+class TimeHistogram
+{
+public:
+    using microseconds = std::chrono::microseconds;
+
+    void Add(microseconds time);
+    void Get(UINT* buckets, float* average, float* maxTime) const;
+
+private:
+    UINT buckets_[kFrameClockHistogramSize] = {};
+    UINT64 count_ = 0;
+    microseconds total_ = microseconds::zero();
+    microseconds max_ = microseconds::zero();
+};
+
+
+// Records the cadence of the render events issued by Unity and predicts the next one
+// so that captures can be scheduled to complete just before it.
+// Deadlines are anchored to the last render event and never accumulate sleep errors.
+class FrameClock
+{
+public:
+    using clock = std::chrono::steady_clock;
+    using microseconds = std::chrono::microseconds;
+
+    void Tick();
+    bool IsStable() const;
+    clock::time_point GetNextCaptureDeadline() const;
+    void AddCaptureTime(microseconds time);
+    void AddLatency(microseconds latency);
+    void GetStats(FrameClockStats* stats) const;
+
+private:
+    microseconds GetPeriod() const;
+    microseconds GetLead() const;
+
+    mutable std::mutex mutex_;
+    UINT64 frameCount_ = 0;
+    UINT outlierCount_ = 0;
+    clock::time_point lastTickTime_;
+    double period_ = 0.0; // [us]
+    double captureTimePerFrame_ = 0.0; // [us]
+    microseconds captureTimeInFrame_ = microseconds::zero();
+    TimeHistogram jitter_;
+    TimeHistogram latency_;
+};
@@ -0,0 +1,48 @@
+#include <atomic>
+#include "GraphicsBackend.h"
+#include "D3D11GraphicsBackend.h"
+#include "NullGraphicsBackend.h"
+#include "Unity.h"
+#include "Debug.h"
+
+
+
+namespace
+{
+    std::atomic<GraphicsBackendType> g_backendType = GraphicsBackendType::D3D11;
+}
+
+
+// ---
+
+
+void SetGraphicsBackendType(GraphicsBackendType type)
+{
+    g_backendType = type;
+}
+
+
+GraphicsBackendType GetGraphicsBackendType()
+{
+    return g_backendType;
+}
+
+
+std::unique_ptr<IGraphicsBackend> CreateGraphicsBackend()
+{
+    if (g_backendType == GraphicsBackendType::Null)
+    {
+        Debug::Log("The null graphics backend is used.");
+        return std::make_unique<NullGraphicsBackend>();
+    }
+
+    if (GetUnity() && GetUnityDevice())
+    {
+        auto backend = std::make_unique<D3D11GraphicsBackend>();
+        if (backend->IsValid()) return std::move(backend);
+    }
+
+    // without a backend the frames stay in the capture buffers and nothing is uploaded.
+    Debug::Error(__FUNCTION__, " => D3D11 is not available.");
+    return nullptr;
+}
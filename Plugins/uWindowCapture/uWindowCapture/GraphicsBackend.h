@@ -0,0 +1,97 @@
+#pragma once
+
+#include <Windows.h>
+#include <memory>
+#include <tuple>
+
+
+struct ID3D11Texture2D;
+
+
+// Textures with the same description are interchangeable.
+struct SharedTextureDesc
+{
+    UINT width;
+    UINT height;
+    UINT format; // backend specific
+
+    bool operator==(const SharedTextureDesc& other) const
+    {
+        return width == other.width && height == other.height && format == other.format;
+    }
+
+    bool operator<(const SharedTextureDesc& other) const
+    {
+        return std::tie(width, height, format) < std::tie(other.width, other.height, other.format);
+    }
+};
+
+
+// Texture written by the upload thread and copied to the Unity texture on the render thread.
+class ISharedTexture
+{
+public:
+    virtual ~ISharedTexture() {}
+    virtual UINT GetWidth() const = 0;
+    virtual UINT GetHeight() const = 0;
+    virtual SharedTextureDesc GetDesc() const = 0;
+};
+
+
+enum class GpuQueue
+{
+    Upload, // the device of the upload thread
+    Render, // Unity's device on the render thread
+};
+
+
+// Completes when the GPU has finished the commands issued on its queue before Signal().
+// Both must be called on the thread of the queue and never block.
+class IGpuFence
+{
+public:
+    virtual ~IGpuFence() {}
+    virtual void Signal() = 0;
+    virtual bool IsCompleted() = 0;
+};
+
+
+// Everything the upload and render stages need from the GPU.
+// Unity textures are given as the native pointers passed from Unity and are treated as opaque keys
+// by the backends which do not use D3D11.
+class IGraphicsBackend
+{
+public:
+    virtual ~IGraphicsBackend() {}
+
+    virtual const char* GetName() const = 0;
+    virtual bool GetUnityTextureSize(ID3D11Texture2D* unityTexture, UINT* width, UINT* height) const = 0;
+    virtual bool GetUnityTextureDesc(ID3D11Texture2D* unityTexture, SharedTextureDesc* desc) const = 0;
+    virtual std::shared_ptr<IGpuFence> CreateFence(GpuQueue queue) = 0; // on the thread of the queue
+
+    // upload thread
+    virtual std::shared_ptr<ISharedTexture> CreateSharedTexture(ID3D11Texture2D* unityTexture) = 0;
+    virtual bool UpdateSharedTexture(ISharedTexture* texture, const BYTE* data, UINT pitch) = 0;
+    virtual bool UpdateSharedTextureRegion(ISharedTexture* texture, const RECT& region, const BYTE* data, UINT pitch) = 0; // data points at the top left of the region
+    virtual void Flush() = 0;
+
+    // render thread
+    virtual bool CopyToUnityTexture(ISharedTexture* texture, ID3D11Texture2D* unityTexture) = 0;
+    virtual void GetSharedResourceStats(UINT64* openCount, UINT64* reuseCount) const = 0;
+};
+
+
+enum class GraphicsBackendType
+{
+    D3D11 = 0, // default
+    Null = 1, // records the uploads into memory, for headless hosts and the test harness
+};
+
+
+// Selects the backend made by the next CreateGraphicsBackend(), so it has to be set before UwcInitialize().
+// The null backend is only used when it is selected here, never as a fallback.
+void SetGraphicsBackendType(GraphicsBackendType type);
+GraphicsBackendType GetGraphicsBackendType();
+
+// Uses D3D11 when Unity runs on it, and otherwise returns null so that uploads are skipped.
+std::unique_ptr<IGraphicsBackend> CreateGraphicsBackend();
@@ -0,0 +1,123 @@
+#include "IconCache.h"
+
+
+
+namespace
+{
+    constexpr UINT kDefaultCapacity = 256;
+}
+
+
+// ---
+
+
+size_t IconCache::KeyHash::operator()(const IconCacheKey& key) const
+{
+    size_t hash = std::hash<std::wstring>()(key.imagePath);
+    hash ^= std::hash<HICON>()(key.hIcon) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+    hash ^= std::hash<UINT>()(key.width << 16 | key.height) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+    return hash;
+}
+
+
+IconCache::IconCache()
+    : capacity_(kDefaultCapacity)
+{
+}
+
+
+std::shared_ptr<IconCacheEntry> IconCache::Find(const IconCacheKey& key)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    auto it = itemsByKey_.find(key);
+    if (it == itemsByKey_.end())
+    {
+        missCount_++;
+        return nullptr;
+    }
+
+    items_.splice(items_.begin(), items_, it->second);
+    hitCount_++;
+
+    return it->second->second;
+}
+
+
+std::shared_ptr<IconCacheEntry> IconCache::Add(const IconCacheKey& key, const std::shared_ptr<IconCacheEntry>& entry)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    // another window may have added the same icon while this one was extracting it.
+    auto it = itemsByKey_.find(key);
+    if (it != itemsByKey_.end())
+    {
+        items_.splice(items_.begin(), items_, it->second);
+        return it->second->second;
+    }
+
+    items_.emplace_front(key, entry);
+    itemsByKey_.emplace(key, items_.begin());
+    EvictIfNeeded();
+
+    return entry;
+}
+
+
+void IconCache::Clear()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    itemsByKey_.clear();
+    items_.clear();
+}
+
+
+void IconCache::EvictIfNeeded()
+{
+    while (items_.size() > capacity_)
+    {
+        itemsByKey_.erase(items_.back().first);
+        items_.pop_back();
+        evictedCount_++;
+    }
+}
+
+
+void IconCache::AddUpload(bool isShared)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    if (isShared)
+    {
+        sharedUploadCount_++;
+    }
+    else
+    {
+        uploadCount_++;
+    }
+}
+
+
+void IconCache::SetCapacity(UINT capacity)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    capacity_ = capacity;
+    EvictIfNeeded();
+}
+
+
+void IconCache::GetStats(IconCacheStats* stats) const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    stats->hitCount = hitCount_;
+    stats->missCount = missCount_;
+    stats->uploadCount = uploadCount_;
+    stats->sharedUploadCount = sharedUploadCount_;
+    stats->evictedCount = evictedCount_;
+    stats->entryCount = static_cast<UINT>(items_.size());
+    stats->capacity = capacity_;
+
+    const UINT64 lookupCount = hitCount_ + missCount_;
+    stats->hitRate = lookupCount > 0 ? static_cast<float>(hitCount_) / lookupCount : 0.f;
+}
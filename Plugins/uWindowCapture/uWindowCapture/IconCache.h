@@ -0,0 +1,96 @@
+#pragma once
+
+#include <Windows.h>
+#include <string>
+#include <list>
+#include <unordered_map>
+#include <memory>
+#include <mutex>
+
+#include "Buffer.h"
+#include "GraphicsBackend.h"
+
+
+struct IconCacheStats
+{
+    UINT64 hitCount;
+    UINT64 missCount;
+    UINT64 uploadCount;
+    UINT64 sharedUploadCount; // windows which reused an icon already uploaded by another window
+    UINT64 evictedCount;
+    UINT entryCount;
+    UINT capacity;
+    float hitRate;
+};
+
+
+struct IconCacheKey
+{
+    HICON hIcon;
+    std::wstring imagePath; // icon handles may be reused after the owner destroys them
+    UINT width;
+    UINT height;
+
+    bool operator==(const IconCacheKey& other) const
+    {
+        return 
+            hIcon == other.hIcon && 
+            width == other.width && 
+            height == other.height && 
+            imagePath == other.imagePath;
+    }
+};
+
+
+// Composited icon shared by all the windows which have the same icon.
+// The pixels do not change after the entry is added to the cache,
+// and the shared texture is uploaded once by the first window which needs it.
+struct IconCacheEntry
+{
+    UINT width = 0;
+    UINT height = 0;
+    Buffer<BYTE> pixels;
+
+    std::shared_ptr<ISharedTexture> sharedTexture;
+    std::mutex sharedTextureMutex;
+};
+
+
+// Process-wide cache of the window icons, so that many windows of the same application
+// (Explorer, browsers) extract, composite and upload their icon only once.
+// Least recently used entries are dropped over the capacity, while the windows keep theirs.
+class IconCache
+{
+public:
+    IconCache();
+
+    std::shared_ptr<IconCacheEntry> Find(const IconCacheKey& key);
+    std::shared_ptr<IconCacheEntry> Add(const IconCacheKey& key, const std::shared_ptr<IconCacheEntry>& entry);
+    void Clear();
+
+    void AddUpload(bool isShared);
+
+    void SetCapacity(UINT capacity);
+    void GetStats(IconCacheStats* stats) const;
+
+private:
+    struct KeyHash
+    {
+        size_t operator()(const IconCacheKey& key) const;
+    };
+
+    using Item = std::pair<IconCacheKey, std::shared_ptr<IconCacheEntry>>;
+
+    void EvictIfNeeded();
+
+    mutable std::mutex mutex_;
+    std::list<Item> items_; // most recently used first
+    std::unordered_map<IconCacheKey, std::list<Item>::iterator, KeyHash> itemsByKey_;
+    UINT capacity_;
+
+    UINT64 hitCount_ = 0;
+    UINT64 missCount_ = 0;
+    UINT64 uploadCount_ = 0;
+    UINT64 sharedUploadCount_ = 0;
+    UINT64 evictedCount_ = 0;
+};
@@ -1,216 +1,295 @@
-#include "IconTexture.h"
-#include "Window.h"
-#include "WindowManager.h"
-#include "UploadManager.h"
-#include "Debug.h"
-#include "Unity.h"
-#include "Util.h"
-#include "Message.h"
-
-using namespace Microsoft::WRL;
-
-
-
-IconTexture::IconTexture(Window* window)
-    : window_(window)
-{
-}
-
-
-IconTexture::~IconTexture()
-{
-}
-
-
-UINT IconTexture::GetWidth() const
-{
-    return ::GetSystemMetrics(SM_CXICON);
-}
-
-
-UINT IconTexture::GetHeight() const
-{
-    return ::GetSystemMetrics(SM_CYICON);
-}
-
-
-void IconTexture::SetUnityTexturePtr(ID3D11Texture2D* ptr)
-{
-    unityTexture_ = ptr;
-}
-
-
-ID3D11Texture2D* IconTexture::GetUnityTexturePtr() const
-{
-    return unityTexture_;
-}
-
-
-bool IconTexture::CaptureOnce()
-{
-    if (hasCaptured_) return false;
-
-    auto hWnd = window_->GetHandle();
-
-    // TODO: cannot get icon when the window is UWP.
-    auto hIcon = reinterpret_cast<HICON>(::GetClassLongPtr(hWnd, GCLP_HICON));
-    if (hIcon == nullptr)
-    {
-        const UINT timeout = 100;
-        const auto hr = ::SendMessageTimeout(hWnd, WM_GETICON, ICON_BIG, 0, SMTO_ABORTIFHUNG | SMTO_BLOCK, timeout, reinterpret_cast<PDWORD_PTR>(&hIcon));
-        if (FAILED(hr))
-        {
-            hIcon = reinterpret_cast<HICON>(::LoadImage(window_->GetInstance(), IDI_APPLICATION, IMAGE_ICON, 0, 0, LR_SHARED));
-            if (hIcon == nullptr)
-            {
-                Debug::Error(__FUNCTION__, " => Could not get HICON.");
-                return false;
-            }
-        }
-    }
-
-    const auto width = GetWidth();
-    const auto height = GetHeight();
-
-    ICONINFO info;
-    if (!::GetIconInfo(hIcon, &info))
-    {
-        OutputApiError(__FUNCTION__, "GetIconInfo");
-        return false;
-    }
-    ScopedReleaser iconReleaser([&] 
-    { 
-        ::DeleteObject(info.hbmColor); 
-        ::DeleteObject(info.hbmMask); 
-    });
-
-    auto hDcMem = ::CreateCompatibleDC(NULL);
-    ScopedReleaser hDcReleaser([&] { ::DeleteDC(hDcMem); });
-
-    BITMAPINFOHEADER bmi {};
-    bmi.biWidth       = static_cast<LONG>(width);
-    bmi.biHeight      = -static_cast<LONG>(height);
-    bmi.biPlanes      = 1;
-    bmi.biSize        = sizeof(BITMAPINFOHEADER);
-    bmi.biBitCount    = 32;
-    bmi.biCompression = BI_RGB;
-    bmi.biSizeImage   = 0;
-
-    // Get color image
-    Buffer<BYTE> color;
-    color.ExpandIfNeeded(width * height * 4);
-    if (!::GetDIBits(hDcMem, info.hbmColor, 0, height, color.Get(), reinterpret_cast<BITMAPINFO*>(&bmi), DIB_RGB_COLORS))
-    {
-        OutputApiError(__FUNCTION__, "GetDIBits");
-        return false;
-    }
-    
-    // Get mask image
-    Buffer<BYTE> mask;
-    mask.ExpandIfNeeded(width * height * 4);
-    if (!::GetDIBits(hDcMem, info.hbmMask, 0, height, mask.Get(), reinterpret_cast<BITMAPINFO*>(&bmi), DIB_RGB_COLORS))
-    {
-        OutputApiError(__FUNCTION__, "GetDIBits");
-        return false;
-    }
-
-    {
-        std::lock_guard<std::mutex> lock(bufferMutex_);
-        buffer_.ExpandIfNeeded(width * height * 4);
-
-        auto buffer32 = buffer_.As<UINT>();
-        auto color32 = color.As<UINT>();
-        auto mask32 = mask.As<UINT>();
-
-        const auto n = width * height;
-        for (UINT x = 0; x < width; ++x) 
-        {
-            for (UINT y = 0; y < height; ++y)
-            {
-                const auto i = y * width + x;
-                const auto j = (height - 1 - y) * width + x;
-                buffer32[j] = color32[i] ^ mask32[i];
-            }
-        }
-    }
-
-    hasCaptured_ = true;
-
-    return true;
-}
-
-
-bool IconTexture::UploadOnce()
-{
-    if (hasUploaded_) return false;
-
-    if (!unityTexture_.load() || buffer_.Empty()) return false;
-
-    std::lock_guard<std::mutex> lock(sharedTextureMutex_);
-
-    {
-        D3D11_TEXTURE2D_DESC desc;
-        unityTexture_.load()->GetDesc(&desc);
-        if (desc.Width != GetWidth() || desc.Height != GetHeight())
-        {
-            Debug::Error(__FUNCTION__, " => Texture size is wrong.");
-            return false;
-        }
-    }
-
-    auto& uploader = WindowManager::GetUploadManager();
-    if (!uploader) return false;
-
-    sharedTexture_ = uploader->CreateCompatibleSharedTexture(unityTexture_.load());
-    if (!sharedTexture_)
-    {
-        Debug::Error(__FUNCTION__, " => Shared texture is null.");
-        return false;
-    }
-
-    ComPtr<IDXGIResource> dxgiResource;
-    sharedTexture_.As(&dxgiResource);
-    if (FAILED(dxgiResource->GetSharedHandle(&sharedHandle_)))
-    {
-        Debug::Error(__FUNCTION__, " => GetSharedHandle() failed.");
-        return false;
-    }
-
-    {
-        std::lock_guard<std::mutex> lock(bufferMutex_);
-        ComPtr<ID3D11DeviceContext> context;
-        uploader->GetDevice()->GetImmediateContext(&context);
-        context->UpdateSubresource(sharedTexture_.Get(), 0, nullptr, buffer_.Get(), GetWidth() * 4, 0);
-        context->Flush();
-    }
-
-    hasUploaded_ = true;
-
-    return true;
-}
-
-
-bool IconTexture::RenderOnce()
-{
-    if (hasRendered_) return true;
-
-    if (!unityTexture_.load() || !sharedTexture_ || !sharedHandle_) return false;
-
-    std::lock_guard<std::mutex> lock(sharedTextureMutex_);
-
-    ComPtr<ID3D11DeviceContext> context;
-    GetUnityDevice()->GetImmediateContext(&context);
-
-    ComPtr<ID3D11Texture2D> texture;
-    if (FAILED(GetUnityDevice()->OpenSharedResource(sharedHandle_, __uuidof(ID3D11Texture2D), &texture)))
-    {
-        Debug::Error(__FUNCTION__, " => OpenSharedResource() failed.");
-        return false;
-    }
-
-    context->CopyResource(unityTexture_.load(), texture.Get());
-
-    MessageManager::Get().Add({ MessageType::IconCaptured, window_->GetId(), window_->GetHandle() });
-
-    return true;
+#include "IconTexture.h"
+#include "Window.h"
+#include "WindowManager.h"
+#include "UploadManager.h"
+#include "Debug.h"
+#include "Util.h"
+#include "Message.h"
+
+
+
+IconTexture::IconTexture(Window* window)
+    : window_(window)
+{
+}
+
+
+IconTexture::~IconTexture()
+{
+    std::lock_guard<std::mutex> lock(sharedTextureMutex_);
+    ReleaseOwnedSharedTexture();
+}
+
+
+void IconTexture::ReleaseOwnedSharedTexture()
+{
+    // the texture of the cached icon is kept by the icon for the other windows.
+    if (isSharedTextureOwned_)
+    {
+        if (auto& uploader = WindowManager::GetUploadManager())
+        {
+            uploader->ReleaseSharedTexture(std::move(sharedTexture_));
+        }
+        isSharedTextureOwned_ = false;
+    }
+    sharedTexture_.reset();
+}
+
+
+std::shared_ptr<IconCacheEntry> IconTexture::GetIcon() const
+{
+    std::lock_guard<std::mutex> lock(iconMutex_);
+    return icon_;
+}
+
+
+UINT IconTexture::GetWidth() const
+{
+    return ::GetSystemMetrics(SM_CXICON);
+}
+
+
+UINT IconTexture::GetHeight() const
+{
+    return ::GetSystemMetrics(SM_CYICON);
+}
+
+
+void IconTexture::SetUnityTexturePtr(ID3D11Texture2D* ptr)
+{
+    unityTexture_ = ptr;
+}
+
+
+ID3D11Texture2D* IconTexture::GetUnityTexturePtr() const
+{
+    return unityTexture_;
+}
+
+
+bool IconTexture::CaptureOnce()
+{
+    if (hasCaptured_) return false;
+
+    auto hWnd = window_->GetHandle();
+
+    // TODO: cannot get icon when the window is UWP.
+    auto hIcon = reinterpret_cast<HICON>(::GetClassLongPtr(hWnd, GCLP_HICON));
+    if (hIcon == nullptr)
+    {
+        const UINT timeout = 100;
+        const auto hr = ::SendMessageTimeout(hWnd, WM_GETICON, ICON_BIG, 0, SMTO_ABORTIFHUNG | SMTO_BLOCK, timeout, reinterpret_cast<PDWORD_PTR>(&hIcon));
+        if (FAILED(hr))
+        {
+            hIcon = reinterpret_cast<HICON>(::LoadImage(window_->GetInstance(), IDI_APPLICATION, IMAGE_ICON, 0, 0, LR_SHARED));
+            if (hIcon == nullptr)
+            {
+                Debug::Error(__FUNCTION__, " => Could not get HICON.");
+                return false;
+            }
+        }
+    }
+
+    const auto width = GetWidth();
+    const auto height = GetHeight();
+
+    IconCacheKey key { hIcon, L"", width, height };
+    if (const auto process = WindowManager::GetProcessInfo(window_->GetProcessId()))
+    {
+        key.imagePath = process->imagePath;
+    }
+
+    auto& cache = WindowManager::GetIconCache();
+    auto icon = cache ? cache->Find(key) : nullptr;
+    if (!icon)
+    {
+        icon = ExtractIcon(hIcon, width, height);
+        if (!icon) return false;
+
+        if (cache)
+        {
+            icon = cache->Add(key, icon);
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(iconMutex_);
+        icon_ = icon;
+    }
+
+    hasCaptured_ = true;
+
+    return true;
+}
+
+
+std::shared_ptr<IconCacheEntry> IconTexture::ExtractIcon(HICON hIcon, UINT width, UINT height)
+{
+    ICONINFO info;
+    if (!::GetIconInfo(hIcon, &info))
+    {
+        OutputApiError(__FUNCTION__, "GetIconInfo");
+        return nullptr;
+    }
+    ScopedReleaser iconReleaser([&] 
+    { 
+        ::DeleteObject(info.hbmColor); 
+        ::DeleteObject(info.hbmMask); 
+    });
+
+    auto hDcMem = ::CreateCompatibleDC(NULL);
+    ScopedReleaser hDcReleaser([&] { ::DeleteDC(hDcMem); });
+
+    BITMAPINFOHEADER bmi {};
+    bmi.biWidth       = static_cast<LONG>(width);
+    bmi.biHeight      = -static_cast<LONG>(height);
+    bmi.biPlanes      = 1;
+    bmi.biSize        = sizeof(BITMAPINFOHEADER);
+    bmi.biBitCount    = 32;
+    bmi.biCompression = BI_RGB;
+    bmi.biSizeImage   = 0;
+
+    // Get color image
+    Buffer<BYTE> color;
+    color.ExpandIfNeeded(width * height * 4);
+    if (!::GetDIBits(hDcMem, info.hbmColor, 0, height, color.Get(), reinterpret_cast<BITMAPINFO*>(&bmi), DIB_RGB_COLORS))
+    {
+        OutputApiError(__FUNCTION__, "GetDIBits");
+        return nullptr;
+    }
+    
+    // Get mask image
+    Buffer<BYTE> mask;
+    mask.ExpandIfNeeded(width * height * 4);
+    if (!::GetDIBits(hDcMem, info.hbmMask, 0, height, mask.Get(), reinterpret_cast<BITMAPINFO*>(&bmi), DIB_RGB_COLORS))
+    {
+        OutputApiError(__FUNCTION__, "GetDIBits");
+        return nullptr;
+    }
+
+    auto icon = std::make_shared<IconCacheEntry>();
+    icon->width = width;
+    icon->height = height;
+    icon->pixels.ExpandIfNeeded(width * height * 4);
+
+    auto buffer32 = icon->pixels.As<UINT>();
+    auto color32 = color.As<UINT>();
+    auto mask32 = mask.As<UINT>();
+
+    for (UINT x = 0; x < width; ++x) 
+    {
+        for (UINT y = 0; y < height; ++y)
+        {
+            const auto i = y * width + x;
+            const auto j = (height - 1 - y) * width + x;
+            buffer32[j] = color32[i] ^ mask32[i];
+        }
+    }
+
+    return icon;
+}
+
+
+bool IconTexture::UploadOnce()
+{
+    if (hasUploaded_) return false;
+
+    auto icon = GetIcon();
+    if (!unityTexture_.load() || !icon) return false;
+
+    auto& uploader = WindowManager::GetUploadManager();
+    if (!uploader) return false;
+
+    auto backend = uploader->GetBackend();
+    if (!backend) return false;
+
+    {
+        UINT width, height;
+        if (!backend->GetUnityTextureSize(unityTexture_.load(), &width, &height) ||
+            width != icon->width || height != icon->height)
+        {
+            Debug::Error(__FUNCTION__, " => Texture size is wrong.");
+            return false;
+        }
+    }
+
+    SharedTextureDesc desc;
+    if (!backend->GetUnityTextureDesc(unityTexture_.load(), &desc)) return false;
+
+    auto& cache = WindowManager::GetIconCache();
+
+    std::lock_guard<std::mutex> lock(sharedTextureMutex_);
+
+    {
+        std::lock_guard<std::mutex> iconLock(icon->sharedTextureMutex);
+
+        // the first window uploads the icon and the others only copy it in their render.
+        if (!icon->sharedTexture)
+        {
+            auto texture = uploader->AcquireSharedTexture(unityTexture_.load());
+            if (texture && backend->UpdateSharedTexture(texture.get(), icon->pixels.Get(), icon->width * 4))
+            {
+                icon->sharedTexture = std::move(texture);
+                if (cache) cache->AddUpload(false);
+            }
+            else
+            {
+                uploader->ReleaseSharedTexture(std::move(texture));
+                Debug::Error(__FUNCTION__, " => Could not upload the icon.");
+                return false;
+            }
+        }
+        else if (icon->sharedTexture->GetDesc() == desc)
+        {
+            if (cache) cache->AddUpload(true);
+        }
+
+        if (icon->sharedTexture && icon->sharedTexture->GetDesc() == desc)
+        {
+            ReleaseOwnedSharedTexture();
+            sharedTexture_ = icon->sharedTexture;
+            hasUploaded_ = true;
+            return true;
+        }
+    }
+
+    // a texture of another format than the shared one needs an own upload.
+    if (!isSharedTextureOwned_ || !(sharedTexture_->GetDesc() == desc))
+    {
+        ReleaseOwnedSharedTexture();
+        sharedTexture_ = uploader->AcquireSharedTexture(unityTexture_.load());
+        isSharedTextureOwned_ = (sharedTexture_ != nullptr);
+    }
+
+    if (!sharedTexture_)
+    {
+        Debug::Error(__FUNCTION__, " => Shared texture is null.");
+        return false;
+    }
+
+    if (!backend->UpdateSharedTexture(sharedTexture_.get(), icon->pixels.Get(), icon->width * 4)) return false;
+    if (cache) cache->AddUpload(false);
+
+    hasUploaded_ = true;
+
+    return true;
+}
+
+
+bool IconTexture::RenderOnce()
+{
+    if (hasRendered_) return true;
+
+    if (!unityTexture_.load()) return false;
+
+    auto& uploader = WindowManager::GetUploadManager();
+    if (!uploader || !uploader->GetBackend()) return false;
+
+    std::lock_guard<std::mutex> lock(sharedTextureMutex_);
+
+    if (!uploader->GetBackend()->CopyToUnityTexture(sharedTexture_.get(), unityTexture_.load())) return false;
+
+    MessageManager::Get().Add({ MessageType::IconCaptured, window_->GetId(), window_->GetHandle() });
+
+    return true;
 }
\ No newline at end of file
@@ -1,46 +1,50 @@
-#pragma once
-
-#include <Windows.h>
-#include <d3d11.h>
-#include <wrl/client.h>
-#include <string>
-#include <mutex>
-#include <atomic>
-
-#include "Buffer.h"
-
-
-class Window;
-
-
-class IconTexture
-{
-public:
-    explicit IconTexture(Window* window);
-    ~IconTexture();
-
-    UINT GetWidth() const;
-    UINT GetHeight() const;
-
-    void SetUnityTexturePtr(ID3D11Texture2D* ptr);
-    ID3D11Texture2D* GetUnityTexturePtr() const;
-
-    bool CaptureOnce();
-    bool UploadOnce();
-    bool RenderOnce();
-
-private:
-    Window* const window_ = nullptr;
-
-    std::atomic<ID3D11Texture2D*> unityTexture_ = nullptr;
-    Microsoft::WRL::ComPtr<ID3D11Texture2D> sharedTexture_;
-    HANDLE sharedHandle_;
-    std::mutex sharedTextureMutex_;
-
-    Buffer<BYTE> buffer_;
-    std::mutex bufferMutex_;
-
-    std::atomic<bool> hasCaptured_ = false;
-    std::atomic<bool> hasUploaded_ = false;
-    std::atomic<bool> hasRendered_ = false;
+#pragma once
+
+#include <Windows.h>
+#include <string>
+#include <memory>
+#include <mutex>
+#include <atomic>
+
+#include "GraphicsBackend.h"
+#include "IconCache.h"
+
+
+class Window;
+
+
+class IconTexture
+{
+public:
+    explicit IconTexture(Window* window);
+    ~IconTexture();
+
+    UINT GetWidth() const;
+    UINT GetHeight() const;
+
+    void SetUnityTexturePtr(ID3D11Texture2D* ptr);
+    ID3D11Texture2D* GetUnityTexturePtr() const;
+
+    bool CaptureOnce();
+    bool UploadOnce();
+    bool RenderOnce();
+
+private:
+    static std::shared_ptr<IconCacheEntry> ExtractIcon(HICON hIcon, UINT width, UINT height);
+    std::shared_ptr<IconCacheEntry> GetIcon() const;
+    void ReleaseOwnedSharedTexture();
+
+    Window* const window_ = nullptr;
+
+    std::atomic<ID3D11Texture2D*> unityTexture_ = nullptr;
+    std::shared_ptr<ISharedTexture> sharedTexture_; // the one of the icon, or an own one when the format differs
+    bool isSharedTextureOwned_ = false;
+    std::mutex sharedTextureMutex_;
+
+    std::shared_ptr<IconCacheEntry> icon_; // shared with the other windows through IconCache
+    mutable std::mutex iconMutex_;
+
+    std::atomic<bool> hasCaptured_ = false;
+    std::atomic<bool> hasUploaded_ = false;
+    std::atomic<bool> hasRendered_ = false;
 };
\ No newline at end of file
@@ -1,694 +1,1095 @@
-#include <d3d11.h>
-#include <dxgi1_2.h>
-#include <Windows.h>
-#include <memory>
-
-#include "IUnityInterface.h"
-#include "IUnityGraphics.h"
-
-#include "Debug.h"
-#include "Message.h"
-#include "UploadManager.h"
-#include "CaptureManager.h"
-#include "Window.h"
-#include "Cursor.h"
-#include "WindowTexture.h"
-#include "WindowManager.h"
-
-#include "Util.h"
-
-#pragma comment(lib, "dxgi.lib")
-#pragma comment(lib, "Dwmapi.lib")
-
-
-// flag to check if this plugin has initialized.
-bool g_hasInitialized = false;
-
-// unity interafece to access ID3D11Device.
-IUnityInterfaces* g_unity = nullptr;
-
-
-std::shared_ptr<Window> GetWindow(int id)
-{
-    if (WindowManager::IsNull()) return nullptr;
-    return WindowManager::Get().GetWindow(id);
-}
-
-
-extern "C"
-{
-    UNITY_INTERFACE_EXPORT void UNITY_INTERFACE_API UwcInitialize()
-    {
-        if (g_hasInitialized) return;
-        g_hasInitialized = true;
-
-        Debug::Initialize();
-
-        MessageManager::Create();
-
-        WindowManager::Create();
-        WindowManager::Get().Initialize();
-    }
-
-    UNITY_INTERFACE_EXPORT void UNITY_INTERFACE_API UwcFinalize()
-    {
-        if (!g_hasInitialized) return;
-        g_hasInitialized = false;
-
-        WindowManager::Get().Finalize();
-        WindowManager::Destroy();
-
-        MessageManager::Destroy();
-
-        Debug::Finalize();
-    }
-
-    void UNITY_INTERFACE_API OnGraphicsDeviceEvent(UnityGfxDeviceEventType event)
-    {
-        switch (event)
-        {
-        case kUnityGfxDeviceEventInitialize:
-        {
-            UwcInitialize();
-            break;
-        }
-        case kUnityGfxDeviceEventShutdown:
-        {
-            UwcFinalize();
-            break;
-        }
-        }
-    }
-
-    UNITY_INTERFACE_EXPORT void UNITY_INTERFACE_API UnityPluginLoad(IUnityInterfaces* unityInterfaces)
-    {
-        g_unity = unityInterfaces;
-        auto unityGraphics = g_unity->Get<IUnityGraphics>();
-        unityGraphics->RegisterDeviceEventCallback(OnGraphicsDeviceEvent);
-    }
-
-    UNITY_INTERFACE_EXPORT void UNITY_INTERFACE_API UnityPluginUnload()
-    {
-        auto unityGraphics = g_unity->Get<IUnityGraphics>();
-        unityGraphics->UnregisterDeviceEventCallback(OnGraphicsDeviceEvent);
-        g_unity = nullptr;
-    }
-
-    UNITY_INTERFACE_EXPORT void UNITY_INTERFACE_API UwcSetDebugMode(Debug::Mode mode)
-    {
-        Debug::SetMode(mode);
-    }
-
-    UNITY_INTERFACE_EXPORT void UNITY_INTERFACE_API UwcSetLogFunc(Debug::DebugLogFuncPtr func)
-    {
-        Debug::SetLogFunc(func);
-    }
-
-    UNITY_INTERFACE_EXPORT void UNITY_INTERFACE_API UwcSetErrorFunc(Debug::DebugLogFuncPtr func)
-    {
-        Debug::SetErrorFunc(func);
-    }
-
-    void UNITY_INTERFACE_API OnRenderEvent(int id)
-    {
-        if (WindowManager::IsNull()) return;
-        WindowManager::Get().Render();
-    }
-
-    UNITY_INTERFACE_EXPORT UnityRenderingEvent UNITY_INTERFACE_API UwcGetRenderEventFunc()
-    {
-        return OnRenderEvent;
-    }
-
-    UNITY_INTERFACE_EXPORT void UNITY_INTERFACE_API UwcUpdate()
-    {
-        if (WindowManager::IsNull()) return;
-        WindowManager::Get().Update();
-    }
-
-    UNITY_INTERFACE_EXPORT void UNITY_INTERFACE_API UwcTriggerGpuUpload()
-    {
-        if (WindowManager::IsNull()) return;
-        WindowManager::Get().GetUploadManager()->TriggerGpuUpload();
-    }
-
-    UNITY_INTERFACE_EXPORT UINT UNITY_INTERFACE_API UwcGetMessageCount()
-    {
-        if (MessageManager::IsNull()) return 0;
-        return MessageManager::Get().GetCount();
-    }
-
-    UNITY_INTERFACE_EXPORT const Message* UNITY_INTERFACE_API UwcGetMessages()
-    {
-        if (MessageManager::IsNull()) return nullptr;
-        return MessageManager::Get().GetHeadPointer();
-    }
-
-    UNITY_INTERFACE_EXPORT void UNITY_INTERFACE_API UwcClearMessages()
-    {
-        if (MessageManager::IsNull()) return;
-        MessageManager::Get().ClearAll();
-    }
-
-    UNITY_INTERFACE_EXPORT bool UNITY_INTERFACE_API UwcCheckWindowExistence(int id)
-    {
-        if (WindowManager::IsNull()) return false;
-        return WindowManager::Get().CheckExistence(id);
-    }
-
-    UNITY_INTERFACE_EXPORT int UNITY_INTERFACE_API UwcGetWindowParentId(int id)
-    {
-        if (auto window = GetWindow(id))
-        {
-            return window->GetParentId();
-        }
-        return -1;
-    }
-
-    UNITY_INTERFACE_EXPORT HWND UNITY_INTERFACE_API UwcGetWindowHandle(int id)
-    {
-        if (auto window = GetWindow(id))
-        {
-            return window->GetHandle();
-        }
-        return nullptr;
-    }
-
-    UNITY_INTERFACE_EXPORT void UNITY_INTERFACE_API UwcRequestUpdateWindowTitle(int id)
-    {
-        if (auto window = GetWindow(id))
-        {
-            return window->RequestUpdateTitle();
-        }
-    }
-
-    UNITY_INTERFACE_EXPORT void UNITY_INTERFACE_API UwcRequestCaptureWindow(int id, CapturePriority priority)
-    {
-        if (WindowManager::IsNull()) return;
-        WindowManager::GetCaptureManager()->RequestCapture(id, priority);
-    }
-
-    UNITY_INTERFACE_EXPORT void UNITY_INTERFACE_API UwcRequestCaptureIcon(int id)
-    {
-        if (WindowManager::IsNull()) return;
-        WindowManager::GetCaptureManager()->RequestCaptureIcon(id);
-    }
-
-    UNITY_INTERFACE_EXPORT HWND UNITY_INTERFACE_API UwcGetWindowOwnerHandle(int id)
-    {
-        if (auto window = GetWindow(id))
-        {
-            return window->GetOwnerHandle();
-        }
-        return nullptr;
-    }
-
-    UNITY_INTERFACE_EXPORT HWND UNITY_INTERFACE_API UwcGetWindowParentHandle(int id)
-    {
-        if (auto window = GetWindow(id))
-        {
-            return window->GetParentHandle();
-        }
-        return nullptr;
-    }
-
-    UNITY_INTERFACE_EXPORT HINSTANCE UNITY_INTERFACE_API UwcGetWindowInstance(int id)
-    {
-        if (auto window = GetWindow(id))
-        {
-            return window->GetInstance();
-        }
-        return nullptr;
-    }
-
-    UNITY_INTERFACE_EXPORT DWORD UNITY_INTERFACE_API UwcGetWindowProcessId(int id)
-    {
-        if (auto window = GetWindow(id))
-        {
-            return window->GetProcessId();
-        }
-        return -1;
-    }
-
-    UNITY_INTERFACE_EXPORT DWORD UNITY_INTERFACE_API UwcGetWindowThreadId(int id)
-    {
-        if (auto window = GetWindow(id))
-        {
-            return window->GetThreadId();
-        }
-        return -1;
-    }
-
-    UNITY_INTERFACE_EXPORT UINT UNITY_INTERFACE_API UwcGetWindowX(int id)
-    {
-        if (auto window = GetWindow(id))
-        {
-            return window->GetX();
-        }
-        return 0;
-    }
-
-    UNITY_INTERFACE_EXPORT UINT UNITY_INTERFACE_API UwcGetWindowY(int id)
-    {
-        if (auto window = GetWindow(id))
-        {
-            return window->GetY();
-        }
-        return 0;
-    }
-
-    UNITY_INTERFACE_EXPORT UINT UNITY_INTERFACE_API UwcGetWindowWidth(int id)
-    {
-        if (auto window = GetWindow(id))
-        {
-            return window->GetWidth();
-        }
-        return 0;
-    }
-
-    UNITY_INTERFACE_EXPORT UINT UNITY_INTERFACE_API UwcGetWindowHeight(int id)
-    {
-        if (auto window = GetWindow(id))
-        {
-            return window->GetHeight();
-        }
-        return 0;
-    }
-
-    UNITY_INTERFACE_EXPORT UINT UNITY_INTERFACE_API UwcGetWindowZOrder(int id)
-    {
-        if (auto window = GetWindow(id))
-        {
-            return window->GetZOrder();
-        }
-        return 0;
-    }
-
-    UNITY_INTERFACE_EXPORT BYTE* UNITY_INTERFACE_API UwcGetWindowBuffer(int id)
-    {
-        if (auto window = GetWindow(id))
-        {
-            return window->GetBuffer();
-        }
-        return nullptr;
-    }
-
-    UNITY_INTERFACE_EXPORT UINT UNITY_INTERFACE_API UwcGetWindowTextureWidth(int id)
-    {
-        if (auto window = GetWindow(id))
-        {
-            return window->GetTextureWidth();
-        }
-        return 0;
-    }
-
-    UNITY_INTERFACE_EXPORT UINT UNITY_INTERFACE_API UwcGetWindowTextureHeight(int id)
-    {
-        if (auto window = GetWindow(id))
-        {
-            return window->GetTextureHeight();
-        }
-        return 0;
-    }
-
-    UNITY_INTERFACE_EXPORT UINT UNITY_INTERFACE_API UwcGetWindowTextureOffsetX(int id)
-    {
-        if (auto window = GetWindow(id))
-        {
-            return window->GetTextureOffsetX();
-        }
-        return 0;
-    }
-
-    UNITY_INTERFACE_EXPORT UINT UNITY_INTERFACE_API UwcGetWindowTextureOffsetY(int id)
-    {
-        if (auto window = GetWindow(id))
-        {
-            return window->GetTextureOffsetY();
-        }
-        return 0;
-    }
-
-    UNITY_INTERFACE_EXPORT UINT UNITY_INTERFACE_API UwcGetWindowIconWidth(int id)
-    {
-        if (auto window = GetWindow(id))
-        {
-            return window->GetIconWidth();
-        }
-        return 0;
-    }
-
-    UNITY_INTERFACE_EXPORT UINT UNITY_INTERFACE_API UwcGetWindowIconHeight(int id)
-    {
-        if (auto window = GetWindow(id))
-        {
-            return window->GetIconHeight();
-        }
-        return 0;
-    }
-
-    UNITY_INTERFACE_EXPORT UINT UNITY_INTERFACE_API UwcGetWindowTitleLength(int id)
-    {
-        if (auto window = GetWindow(id))
-        {
-            return static_cast<UINT>(window->GetTitle().length());
-        }
-        return 0;
-    }
-
-    UNITY_INTERFACE_EXPORT const WCHAR* UNITY_INTERFACE_API UwcGetWindowTitle(int id)
-    {
-        if (auto window = GetWindow(id))
-        {
-            return window->GetTitle().c_str();
-        }
-        return nullptr;
-    }
-
-    UNITY_INTERFACE_EXPORT UINT UNITY_INTERFACE_API UwcGetWindowClassNameLength(int id)
-    {
-        if (auto window = GetWindow(id))
-        {
-            return static_cast<UINT>(window->GetClass().length());
-        }
-        return 0;
-    }
-
-    UNITY_INTERFACE_EXPORT const CHAR* UNITY_INTERFACE_API UwcGetWindowClassName(int id)
-    {
-        if (auto window = GetWindow(id))
-        {
-            return window->GetClass().c_str();
-        }
-        return nullptr;
-    }
-
-    UNITY_INTERFACE_EXPORT ID3D11Texture2D* UNITY_INTERFACE_API UwcGetWindowTexturePtr(int id)
-    {
-        if (auto window = GetWindow(id))
-        {
-            return window->GetWindowTexture();
-        }
-        return nullptr;
-    }
-
-    UNITY_INTERFACE_EXPORT void UNITY_INTERFACE_API UwcSetWindowTexturePtr(int id, ID3D11Texture2D* ptr)
-    {
-        if (auto window = GetWindow(id))
-        {
-            window->SetWindowTexture(ptr);
-        }
-    }
-
-    UNITY_INTERFACE_EXPORT ID3D11Texture2D* UNITY_INTERFACE_API UwcGetWindowIconTexturePtr(int id)
-    {
-        if (auto window = GetWindow(id))
-        {
-            return window->GetIconTexture();
-        }
-        return nullptr;
-    }
-
-    UNITY_INTERFACE_EXPORT void UNITY_INTERFACE_API UwcSetWindowIconTexturePtr(int id, ID3D11Texture2D* ptr)
-    {
-        if (auto window = GetWindow(id))
-        {
-            window->SetIconTexture(ptr);
-        }
-    }
-
-    UNITY_INTERFACE_EXPORT CaptureMode UNITY_INTERFACE_API UwcGetWindowCaptureMode(int id)
-    {
-        if (auto window = GetWindow(id))
-        {
-            return window->GetCaptureMode();
-        }
-        return CaptureMode::None;
-    }
-
-    UNITY_INTERFACE_EXPORT void UNITY_INTERFACE_API UwcSetWindowCaptureMode(int id, CaptureMode mode)
-    {
-        if (auto window = GetWindow(id))
-        {
-            return window->SetCaptureMode(mode);
-        }
-    }
-
-    UNITY_INTERFACE_EXPORT bool UNITY_INTERFACE_API UwcGetWindowCursorDraw(int id)
-    {
-        if (auto window = GetWindow(id))
-        {
-            return window->GetCursorDraw();
-        }
-        return false;
-    }
-
-    UNITY_INTERFACE_EXPORT void UNITY_INTERFACE_API UwcSetWindowCursorDraw(int id, bool draw)
-    {
-        if (auto window = GetWindow(id))
-        {
-            return window->SetCursorDraw(draw);
-        }
-    }
-
-    UNITY_INTERFACE_EXPORT bool UNITY_INTERFACE_API UwcIsWindow(int id)
-    {
-        if (auto window = GetWindow(id))
-        {
-            return window->IsWindow() > 0;
-        }
-        return false;
-    }
-
-    UNITY_INTERFACE_EXPORT bool UNITY_INTERFACE_API UwcIsAltTabWindow(int id)
-    {
-        if (auto window = GetWindow(id))
-        {
-            return window->IsAltTab();
-        }
-        return false;
-    }
-
-    UNITY_INTERFACE_EXPORT bool UNITY_INTERFACE_API UwcIsDesktop(int id)
-    {
-        if (auto window = GetWindow(id))
-        {
-            return window->IsDesktop();
-        }
-        return false;
-    }
-
-    UNITY_INTERFACE_EXPORT bool UNITY_INTERFACE_API UwcIsWindowVisible(int id)
-    {
-        if (auto window = GetWindow(id))
-        {
-            return window->IsVisible() > 0;
-        }
-        return false;
-    }
-
-    UNITY_INTERFACE_EXPORT bool UNITY_INTERFACE_API UwcIsWindowEnabled(int id)
-    {
-        if (auto window = GetWindow(id))
-        {
-            return window->IsEnabled() > 0;
-        }
-        return false;
-    }
-
-    UNITY_INTERFACE_EXPORT bool UNITY_INTERFACE_API UwcIsWindowUnicode(int id)
-    {
-        if (auto window = GetWindow(id))
-        {
-            return window->IsUnicode() > 0;
-        }
-        return false;
-    }
-
-    UNITY_INTERFACE_EXPORT bool UNITY_INTERFACE_API UwcIsWindowZoomed(int id)
-    {
-        if (auto window = GetWindow(id))
-        {
-            return window->IsZoomed() > 0;
-        }
-        return false;
-    }
-
-    UNITY_INTERFACE_EXPORT bool UNITY_INTERFACE_API UwcIsWindowIconic(int id)
-    {
-        if (auto window = GetWindow(id))
-        {
-            return window->IsIconic() > 0;
-        }
-        return false;
-    }
-
-    UNITY_INTERFACE_EXPORT bool UNITY_INTERFACE_API UwcIsWindowHungUp(int id)
-    {
-        if (auto window = GetWindow(id))
-        {
-            return window->IsHungUp() > 0;
-        }
-        return false;
-    }
-
-    UNITY_INTERFACE_EXPORT bool UNITY_INTERFACE_API UwcIsWindowTouchable(int id)
-    {
-        if (auto window = GetWindow(id))
-        {
-            return window->IsTouchable() > 0;
-        }
-        return false;
-    }
-
-    UNITY_INTERFACE_EXPORT bool UNITY_INTERFACE_API UwcIsWindowApplicationFrameWindow(int id)
-    {
-        if (auto window = GetWindow(id))
-        {
-            return window->IsApplicationFrameWindow() > 0;
-        }
-        return false;
-    }
-
-    UNITY_INTERFACE_EXPORT bool UNITY_INTERFACE_API UwcIsWindowUWP(int id)
-    {
-        if (auto window = GetWindow(id))
-        {
-            return IsUWP(window->GetProcessId());
-        }
-        return false;
-    }
-
-    UNITY_INTERFACE_EXPORT bool UNITY_INTERFACE_API UwcIsWindowBackground(int id)
-    {
-        if (auto window = GetWindow(id))
-        {
-            return window->IsBackground() > 0;
-        }
-        return false;
-    }
-
-    UNITY_INTERFACE_EXPORT UINT UNITY_INTERFACE_API UwcGetWindowPixel(int id, int x, int y)
-    {
-        if (auto window = GetWindow(id))
-        {
-            return window->GetPixel(x, y);
-        }
-        return 0;
-    }
-
-    UNITY_INTERFACE_EXPORT bool UNITY_INTERFACE_API UwcGetWindowPixels(int id, BYTE* output, int x, int y, int width, int height)
-    {
-        if (auto window = GetWindow(id))
-        {
-            return window->GetPixels(output, x, y, width, height);
-        }
-        return false;
-    }
-
-    UNITY_INTERFACE_EXPORT POINT UNITY_INTERFACE_API UwcGetCursorPosition()
-    {
-        POINT point;
-        GetCursorPos(&point);
-        return point;
-    }
-
-    UNITY_INTERFACE_EXPORT int UNITY_INTERFACE_API UwcGetWindowIdFromPoint(int x, int y)
-    {
-        if (WindowManager::IsNull()) return -1;
-        if (auto window = WindowManager::Get().GetWindowFromPoint({ x, y }))
-        {
-            return window->GetId();
-        }
-        return -1;
-    }
-
-    UNITY_INTERFACE_EXPORT int UNITY_INTERFACE_API UwcGetWindowIdUnderCursor()
-    {
-        if (WindowManager::IsNull()) return -1;
-        if (auto window = WindowManager::Get().GetCursorWindow())
-        {
-            return window->GetId();
-        }
-        return -1;
-    }
-
-    UNITY_INTERFACE_EXPORT void UNITY_INTERFACE_API UwcRequestCaptureCursor()
-    {
-        if (WindowManager::IsNull()) return;
-        if (auto& cursor = WindowManager::Get().GetCursor())
-        {
-            return cursor->RequestCapture();
-        }
-    }
-
-    UNITY_INTERFACE_EXPORT UINT UNITY_INTERFACE_API UwcGetCursorX()
-    {
-        if (WindowManager::IsNull()) return -1;
-        if (auto& cursor = WindowManager::Get().GetCursor())
-        {
-            return cursor->GetX();
-        }
-        return -1;
-    }
-
-    UNITY_INTERFACE_EXPORT UINT UNITY_INTERFACE_API UwcGetCursorY()
-    {
-        if (WindowManager::IsNull()) return -1;
-        if (auto& cursor = WindowManager::Get().GetCursor())
-        {
-            return cursor->GetY();
-        }
-        return -1;
-    }
-
-    UNITY_INTERFACE_EXPORT UINT UNITY_INTERFACE_API UwcGetCursorWidth()
-    {
-        if (WindowManager::IsNull()) return -1;
-        if (auto& cursor = WindowManager::Get().GetCursor())
-        {
-            return cursor->GetWidth();
-        }
-        return -1;
-    }
-
-    UNITY_INTERFACE_EXPORT UINT UNITY_INTERFACE_API UwcGetCursorHeight()
-    {
-        if (WindowManager::IsNull()) return -1;
-        if (auto& cursor = WindowManager::Get().GetCursor())
-        {
-            return cursor->GetHeight();
-        }
-        return -1;
-    }
-
-    UNITY_INTERFACE_EXPORT void UNITY_INTERFACE_API UwcSetCursorTexturePtr(ID3D11Texture2D* ptr)
-    {
-        if (WindowManager::IsNull()) return;
-        if (auto& cursor = WindowManager::Get().GetCursor())
-        {
-            cursor->SetUnityTexturePtr(ptr);
-        }
-        return;
-    }
-
-    UNITY_INTERFACE_EXPORT UINT UNITY_INTERFACE_API UwcGetScreenX()
-    {
-        return ::GetSystemMetrics(SM_XVIRTUALSCREEN);
-    }
-
-    UNITY_INTERFACE_EXPORT UINT UNITY_INTERFACE_API UwcGetScreenY()
-    {
-        return ::GetSystemMetrics(SM_YVIRTUALSCREEN);
-    }
-
-    UNITY_INTERFACE_EXPORT UINT UNITY_INTERFACE_API UwcGetScreenWidth()
-    {
-        return ::GetSystemMetrics(SM_CXVIRTUALSCREEN);
-    }
-
-    UNITY_INTERFACE_EXPORT UINT UNITY_INTERFACE_API UwcGetScreenHeight()
-    {
-        return ::GetSystemMetrics(SM_CYVIRTUALSCREEN);
-    }
+#include <d3d11.h>
+#include <dxgi1_2.h>
+#include <Windows.h>
+#include <memory>
+
+#include "IUnityInterface.h"
+#include "IUnityGraphics.h"
+
+#include "Debug.h"
+#include "Message.h"
+#include "UploadManager.h"
+#include "CaptureManager.h"
+#include "Pipeline.h"
+#include "Window.h"
+#include "Watchdog.h"
+#include "Cursor.h"
+#include "WindowTexture.h"
+#include "WindowManager.h"
+#include "NullGraphicsBackend.h"
+
+#include "Util.h"
+
+#pragma comment(lib, "dxgi.lib")
+#pragma comment(lib, "Dwmapi.lib")
+
+
+// flag to check if this plugin has initialized.
+bool g_hasInitialized = false;
+
+// unity interafece to access ID3D11Device.
+IUnityInterfaces* g_unity = nullptr;
+
+
+std::shared_ptr<Window> GetWindow(int id)
+{
+    if (WindowManager::IsNull()) return nullptr;
+    return WindowManager::Get().GetWindow(id);
+}
+
+
+NullGraphicsBackend* GetNullGraphicsBackend()
+{
+    if (WindowManager::IsNull()) return nullptr;
+    auto& uploader = WindowManager::GetUploadManager();
+    return uploader ? dynamic_cast<NullGraphicsBackend*>(uploader->GetBackend()) : nullptr;
+}
+
+
+extern "C"
+{
+    UNITY_INTERFACE_EXPORT void UNITY_INTERFACE_API UwcInitialize()
+    {
+        if (g_hasInitialized) return;
+        g_hasInitialized = true;
+
+        Debug::Initialize();
+
+        MessageManager::Create();
+
+        WindowManager::Create();
+        WindowManager::Get().Initialize();
+    }
+
+    UNITY_INTERFACE_EXPORT void UNITY_INTERFACE_API UwcFinalize()
+    {
+        if (!g_hasInitialized) return;
+        g_hasInitialized = false;
+
+        WindowManager::Get().Finalize();
+        WindowManager::Destroy();
+
+        MessageManager::Destroy();
+
+        Debug::Finalize();
+    }
+
+    void UNITY_INTERFACE_API OnGraphicsDeviceEvent(UnityGfxDeviceEventType event)
+    {
+        switch (event)
+        {
+        case kUnityGfxDeviceEventInitialize:
+        {
+            UwcInitialize();
+            break;
+        }
+        case kUnityGfxDeviceEventShutdown:
+        {
+            UwcFinalize();
+            break;
+        }
+        }
+    }
+
+    UNITY_INTERFACE_EXPORT void UNITY_INTERFACE_API UnityPluginLoad(IUnityInterfaces* unityInterfaces)
+    {
+        g_unity = unityInterfaces;
+        auto unityGraphics = g_unity->Get<IUnityGraphics>();
+        unityGraphics->RegisterDeviceEventCallback(OnGraphicsDeviceEvent);
+    }
+
+    UNITY_INTERFACE_EXPORT void UNITY_INTERFACE_API UnityPluginUnload()
+    {
+        auto unityGraphics = g_unity->Get<IUnityGraphics>();
+        unityGraphics->UnregisterDeviceEventCallback(OnGraphicsDeviceEvent);
+        g_unity = nullptr;
+    }
+
+    UNITY_INTERFACE_EXPORT void UNITY_INTERFACE_API UwcSetDebugMode(Debug::Mode mode)
+    {
+        Debug::SetMode(mode);
+    }
+
+    UNITY_INTERFACE_EXPORT void UNITY_INTERFACE_API UwcSetLogFunc(Debug::DebugLogFuncPtr func)
+    {
+        Debug::SetLogFunc(func);
+    }
+
+    UNITY_INTERFACE_EXPORT void UNITY_INTERFACE_API UwcSetErrorFunc(Debug::DebugLogFuncPtr func)
+    {
+        Debug::SetErrorFunc(func);
+    }
+
+    void UNITY_INTERFACE_API OnRenderEvent(int id)
+    {
+        if (WindowManager::IsNull()) return;
+        WindowManager::Get().Render(id);
+    }
+
+    UNITY_INTERFACE_EXPORT UnityRenderingEvent UNITY_INTERFACE_API UwcGetRenderEventFunc()
+    {
+        return OnRenderEvent;
+    }
+
+    UNITY_INTERFACE_EXPORT void UNITY_INTERFACE_API UwcUpdate()
+    {
+        if (WindowManager::IsNull()) return;
+        WindowManager::Get().Update();
+    }
+
+    UNITY_INTERFACE_EXPORT void UNITY_INTERFACE_API UwcTriggerGpuUpload()
+    {
+        if (WindowManager::IsNull()) return;
+        WindowManager::Get().GetUploadManager()->TriggerGpuUpload();
+    }
+
+    UNITY_INTERFACE_EXPORT void UNITY_INTERFACE_API UwcSetFramePacing(bool enabled)
+    {
+        if (WindowManager::IsNull()) return;
+        WindowManager::GetCaptureManager()->SetFramePacing(enabled);
+    }
+
+    UNITY_INTERFACE_EXPORT bool UNITY_INTERFACE_API UwcGetFrameClockStats(FrameClockStats* stats)
+    {
+        if (WindowManager::IsNull() || !stats) return false;
+        WindowManager::GetFrameClock().GetStats(stats);
+        return true;
+    }
+
+    UNITY_INTERFACE_EXPORT void UNITY_INTERFACE_API UwcSetPipelineStageBudget(PipelineStage stage, UINT budget)
+    {
+        if (WindowManager::IsNull()) return;
+        WindowManager::Get().SetPipelineStageBudget(stage, budget);
+    }
+
+    UNITY_INTERFACE_EXPORT void UNITY_INTERFACE_API UwcSetPipelineStageQueue(PipelineStage stage, UINT capacity, QueuePolicy policy)
+    {
+        if (WindowManager::IsNull()) return;
+        WindowManager::Get().SetPipelineStageQueue(stage, capacity, policy);
+    }
+
+    UNITY_INTERFACE_EXPORT bool UNITY_INTERFACE_API UwcGetPipelineStageStats(PipelineStage stage, PipelineStageStats* stats)
+    {
+        if (WindowManager::IsNull()) return false;
+        return WindowManager::Get().GetPipelineStageStats(stage, stats);
+    }
+
+    UNITY_INTERFACE_EXPORT void UNITY_INTERFACE_API UwcSetAtlasSettings(UINT pageSize, UINT thumbnailSize, UINT maxPageCount)
+    {
+        if (WindowManager::IsNull()) return;
+        WindowManager::GetThumbnailAtlas()->SetSettings(pageSize, thumbnailSize, maxPageCount);
+    }
+
+    UNITY_INTERFACE_EXPORT void UNITY_INTERFACE_API UwcAddAtlasWindow(int id)
+    {
+        if (WindowManager::IsNull()) return;
+        WindowManager::GetThumbnailAtlas()->AddWindow(id);
+    }
+
+    UNITY_INTERFACE_EXPORT void UNITY_INTERFACE_API UwcRemoveAtlasWindow(int id)
+    {
+        if (WindowManager::IsNull()) return;
+        WindowManager::GetThumbnailAtlas()->RemoveWindow(id);
+    }
+
+    UNITY_INTERFACE_EXPORT bool UNITY_INTERFACE_API UwcGetAtlasRect(int id, AtlasRect* rect)
+    {
+        if (WindowManager::IsNull() || !rect) return false;
+        return WindowManager::GetThumbnailAtlas()->GetRect(id, rect);
+    }
+
+    UNITY_INTERFACE_EXPORT UINT64 UNITY_INTERFACE_API UwcGetAtlasVersion()
+    {
+        if (WindowManager::IsNull()) return 0;
+        return WindowManager::GetThumbnailAtlas()->GetVersion();
+    }
+
+    UNITY_INTERFACE_EXPORT UINT UNITY_INTERFACE_API UwcGetAtlasPageSize()
+    {
+        if (WindowManager::IsNull()) return 0;
+        return WindowManager::GetThumbnailAtlas()->GetPageSize();
+    }
+
+    UNITY_INTERFACE_EXPORT UINT UNITY_INTERFACE_API UwcGetAtlasPageCount()
+    {
+        if (WindowManager::IsNull()) return 0;
+        return WindowManager::GetThumbnailAtlas()->GetPageCount();
+    }
+
+    UNITY_INTERFACE_EXPORT void UNITY_INTERFACE_API UwcSetAtlasPageTexture(UINT page, ID3D11Texture2D* ptr)
+    {
+        if (WindowManager::IsNull()) return;
+        WindowManager::GetThumbnailAtlas()->SetPageTexture(page, ptr);
+    }
+
+    UNITY_INTERFACE_EXPORT void UNITY_INTERFACE_API UwcSetRenderByteBudget(UINT64 byteBudget)
+    {
+        if (WindowManager::IsNull()) return;
+        WindowManager::Get().SetRenderByteBudget(byteBudget);
+    }
+
+    UNITY_INTERFACE_EXPORT bool UNITY_INTERFACE_API UwcGetRenderStats(RenderStats* stats)
+    {
+        if (WindowManager::IsNull() || !stats) return false;
+        WindowManager::Get().GetRenderStats(stats);
+        return true;
+    }
+
+    // for hosts without Unity's D3D11 device; call before UwcInitialize().
+    UNITY_INTERFACE_EXPORT void UNITY_INTERFACE_API UwcSetGraphicsBackendType(GraphicsBackendType type)
+    {
+        SetGraphicsBackendType(type);
+    }
+
+    UNITY_INTERFACE_EXPORT bool UNITY_INTERFACE_API UwcRegisterNullBackendTexture(ID3D11Texture2D* ptr, UINT width, UINT height)
+    {
+        if (auto backend = GetNullGraphicsBackend())
+        {
+            backend->RegisterUnityTexture(ptr, width, height);
+            return true;
+        }
+        return false;
+    }
+
+    UNITY_INTERFACE_EXPORT bool UNITY_INTERFACE_API UwcGetNullBackendStats(NullGraphicsBackendStats* stats)
+    {
+        auto backend = GetNullGraphicsBackend();
+        if (!backend || !stats) return false;
+        backend->GetStats(stats);
+        return true;
+    }
+
+    UNITY_INTERFACE_EXPORT void UNITY_INTERFACE_API UwcSetUploadTriggerBudget(UINT timeBudget, UINT64 byteBudget)
+    {
+        if (WindowManager::IsNull()) return;
+        WindowManager::GetUploadManager()->SetTriggerBudget(timeBudget, byteBudget);
+    }
+
+    UNITY_INTERFACE_EXPORT bool UNITY_INTERFACE_API UwcGetUploadStats(UploadStats* stats)
+    {
+        if (WindowManager::IsNull() || !stats) return false;
+        WindowManager::GetUploadManager()->GetUploadStats(stats);
+        return true;
+    }
+
+    UNITY_INTERFACE_EXPORT void UNITY_INTERFACE_API UwcSetIconCacheCapacity(UINT capacity)
+    {
+        if (WindowManager::IsNull()) return;
+        WindowManager::GetIconCache()->SetCapacity(capacity);
+    }
+
+    UNITY_INTERFACE_EXPORT void UNITY_INTERFACE_API UwcClearIconCache()
+    {
+        if (WindowManager::IsNull()) return;
+        WindowManager::GetIconCache()->Clear();
+    }
+
+    UNITY_INTERFACE_EXPORT bool UNITY_INTERFACE_API UwcGetIconCacheStats(IconCacheStats* stats)
+    {
+        if (WindowManager::IsNull() || !stats) return false;
+        WindowManager::GetIconCache()->GetStats(stats);
+        return true;
+    }
+
+    UNITY_INTERFACE_EXPORT UINT UNITY_INTERFACE_API UwcSwapMessages()
+    {
+        if (MessageManager::IsNull()) return 0;
+        return MessageManager::Get().Swap();
+    }
+
+    UNITY_INTERFACE_EXPORT void UNITY_INTERFACE_API UwcSetMessageSubscription(UINT64 mask)
+    {
+        if (MessageManager::IsNull()) return;
+        MessageManager::Get().SetSubscription(mask);
+    }
+
+    // the legacy path (count, pointer, clear) swaps here since its callers never call UwcSwapMessages().
+    UNITY_INTERFACE_EXPORT UINT UNITY_INTERFACE_API UwcGetMessageCount()
+    {
+        if (MessageManager::IsNull()) return 0;
+        return MessageManager::Get().Swap();
+    }
+
+    UNITY_INTERFACE_EXPORT const Message* UNITY_INTERFACE_API UwcGetMessages()
+    {
+        if (MessageManager::IsNull()) return nullptr;
+        return MessageManager::Get().GetHeadPointer();
+    }
+
+    UNITY_INTERFACE_EXPORT UINT UNITY_INTERFACE_API UwcCopyMessages(Message* output, UINT capacity)
+    {
+        if (MessageManager::IsNull() || !output) return 0;
+        return MessageManager::Get().CopyTo(output, capacity);
+    }
+
+    UNITY_INTERFACE_EXPORT void UNITY_INTERFACE_API UwcClearMessages()
+    {
+        if (MessageManager::IsNull()) return;
+        MessageManager::Get().ClearAll();
+    }
+
+    UNITY_INTERFACE_EXPORT bool UNITY_INTERFACE_API UwcCheckWindowExistence(int id)
+    {
+        if (WindowManager::IsNull()) return false;
+        return WindowManager::Get().CheckExistence(id);
+    }
+
+    UNITY_INTERFACE_EXPORT int UNITY_INTERFACE_API UwcGetWindowParentId(int id)
+    {
+        if (auto window = GetWindow(id))
+        {
+            return window->GetParentId();
+        }
+        return -1;
+    }
+
+    UNITY_INTERFACE_EXPORT HWND UNITY_INTERFACE_API UwcGetWindowHandle(int id)
+    {
+        if (auto window = GetWindow(id))
+        {
+            return window->GetHandle();
+        }
+        return nullptr;
+    }
+
+    UNITY_INTERFACE_EXPORT void UNITY_INTERFACE_API UwcRequestUpdateWindowTitle(int id)
+    {
+        if (auto window = GetWindow(id))
+        {
+            return window->RequestUpdateTitle();
+        }
+    }
+
+    UNITY_INTERFACE_EXPORT void UNITY_INTERFACE_API UwcRequestCaptureWindow(int id, CapturePriority priority)
+    {
+        if (WindowManager::IsNull()) return;
+        WindowManager::GetCaptureManager()->RequestCapture(id, priority);
+    }
+
+    UNITY_INTERFACE_EXPORT int UNITY_INTERFACE_API UwcRequestCaptureAsync(int id, CapturePriority priority)
+    {
+        if (WindowManager::IsNull()) return -1;
+        return WindowManager::GetCaptureManager()->RequestCaptureAsync(id, priority);
+    }
+
+    UNITY_INTERFACE_EXPORT UINT UNITY_INTERFACE_API UwcRequestCaptureAsyncBatch(const int* ids, UINT count, CapturePriority priority, int* tokens)
+    {
+        if (WindowManager::IsNull() || !ids || !tokens) return 0;
+        UINT requestedCount = 0;
+        for (UINT i = 0; i < count; ++i)
+        {
+            tokens[i] = WindowManager::GetCaptureManager()->RequestCaptureAsync(ids[i], priority);
+            if (tokens[i] >= 0) ++requestedCount;
+        }
+        return requestedCount;
+    }
+
+    UNITY_INTERFACE_EXPORT CaptureRequestState UNITY_INTERFACE_API UwcPollCapture(int token, CaptureResult* result)
+    {
+        if (WindowManager::IsNull()) return CaptureRequestState::Unknown;
+        return WindowManager::GetCaptureManager()->PollCapture(token, result);
+    }
+
+    UNITY_INTERFACE_EXPORT UINT UNITY_INTERFACE_API UwcPollCaptureBatch(const int* tokens, UINT count, CaptureResult* results)
+    {
+        if (WindowManager::IsNull() || !tokens) return 0;
+        return WindowManager::GetCaptureManager()->WaitCaptures(tokens, count, 0, results);
+    }
+
+    UNITY_INTERFACE_EXPORT CaptureRequestState UNITY_INTERFACE_API UwcWaitCapture(int token, UINT timeout, CaptureResult* result)
+    {
+        if (WindowManager::IsNull()) return CaptureRequestState::Unknown;
+        return WindowManager::GetCaptureManager()->WaitCapture(token, timeout, result);
+    }
+
+    UNITY_INTERFACE_EXPORT UINT UNITY_INTERFACE_API UwcWaitCaptureBatch(const int* tokens, UINT count, UINT timeout, CaptureResult* results)
+    {
+        if (WindowManager::IsNull() || !tokens) return 0;
+        return WindowManager::GetCaptureManager()->WaitCaptures(tokens, count, timeout, results);
+    }
+
+    UNITY_INTERFACE_EXPORT int UNITY_INTERFACE_API UwcCreateCaptureGroup()
+    {
+        if (WindowManager::IsNull()) return -1;
+        return WindowManager::GetCaptureManager()->CreateCaptureGroup();
+    }
+
+    UNITY_INTERFACE_EXPORT void UNITY_INTERFACE_API UwcDestroyCaptureGroup(int groupId)
+    {
+        if (WindowManager::IsNull()) return;
+        WindowManager::GetCaptureManager()->DestroyCaptureGroup(groupId);
+    }
+
+    UNITY_INTERFACE_EXPORT bool UNITY_INTERFACE_API UwcSetCaptureGroupMembers(int groupId, const int* ids, UINT count)
+    {
+        if (WindowManager::IsNull() || (!ids && count > 0)) return false;
+        return WindowManager::GetCaptureManager()->SetCaptureGroupMembers(groupId, std::vector<int>(ids, ids + count));
+    }
+
+    UNITY_INTERFACE_EXPORT void UNITY_INTERFACE_API UwcRequestCaptureGroup(int groupId)
+    {
+        if (WindowManager::IsNull()) return;
+        WindowManager::GetCaptureManager()->RequestCaptureGroup(groupId);
+    }
+
+    UNITY_INTERFACE_EXPORT bool UNITY_INTERFACE_API UwcGetCaptureGroupFrame(int groupId, CaptureGroupFrame* frame)
+    {
+        if (WindowManager::IsNull() || !frame) return false;
+        if (const auto group = WindowManager::GetCaptureManager()->GetCaptureGroup(groupId))
+        {
+            group->GetFrame(frame);
+            return true;
+        }
+        return false;
+    }
+
+    UNITY_INTERFACE_EXPORT UINT UNITY_INTERFACE_API UwcGetCaptureGroupFrameMembers(int groupId, CaptureGroupMember* members, UINT capacity)
+    {
+        if (WindowManager::IsNull() || !members) return 0;
+        if (const auto group = WindowManager::GetCaptureManager()->GetCaptureGroup(groupId))
+        {
+            return group->GetFrameMembers(members, capacity);
+        }
+        return 0;
+    }
+
+    UNITY_INTERFACE_EXPORT bool UNITY_INTERFACE_API UwcGetCaptureGroupStats(int groupId, CaptureGroupStats* stats)
+    {
+        if (WindowManager::IsNull() || !stats) return false;
+        if (const auto group = WindowManager::GetCaptureManager()->GetCaptureGroup(groupId))
+        {
+            group->GetStats(stats);
+            return true;
+        }
+        return false;
+    }
+
+    UNITY_INTERFACE_EXPORT bool UNITY_INTERFACE_API UwcGetWindowRenderedFrame(int id, FrameInfo* frame)
+    {
+        if (!frame) return false;
+        if (auto window = GetWindow(id))
+        {
+            *frame = window->GetRenderedFrame();
+            return true;
+        }
+        return false;
+    }
+
+    UNITY_INTERFACE_EXPORT void UNITY_INTERFACE_API UwcRequestCaptureIcon(int id)
+    {
+        if (WindowManager::IsNull()) return;
+        WindowManager::GetCaptureManager()->RequestCaptureIcon(id);
+    }
+
+    UNITY_INTERFACE_EXPORT HWND UNITY_INTERFACE_API UwcGetWindowOwnerHandle(int id)
+    {
+        if (auto window = GetWindow(id))
+        {
+            return window->GetOwnerHandle();
+        }
+        return nullptr;
+    }
+
+    UNITY_INTERFACE_EXPORT HWND UNITY_INTERFACE_API UwcGetWindowParentHandle(int id)
+    {
+        if (auto window = GetWindow(id))
+        {
+            return window->GetParentHandle();
+        }
+        return nullptr;
+    }
+
+    UNITY_INTERFACE_EXPORT HINSTANCE UNITY_INTERFACE_API UwcGetWindowInstance(int id)
+    {
+        if (auto window = GetWindow(id))
+        {
+            return window->GetInstance();
+        }
+        return nullptr;
+    }
+
+    UNITY_INTERFACE_EXPORT DWORD UNITY_INTERFACE_API UwcGetWindowProcessId(int id)
+    {
+        if (auto window = GetWindow(id))
+        {
+            return window->GetProcessId();
+        }
+        return -1;
+    }
+
+    UNITY_INTERFACE_EXPORT DWORD UNITY_INTERFACE_API UwcGetWindowThreadId(int id)
+    {
+        if (auto window = GetWindow(id))
+        {
+            return window->GetThreadId();
+        }
+        return -1;
+    }
+
+    UNITY_INTERFACE_EXPORT UINT UNITY_INTERFACE_API UwcGetWindowX(int id)
+    {
+        if (auto window = GetWindow(id))
+        {
+            return window->GetX();
+        }
+        return 0;
+    }
+
+    UNITY_INTERFACE_EXPORT UINT UNITY_INTERFACE_API UwcGetWindowY(int id)
+    {
+        if (auto window = GetWindow(id))
+        {
+            return window->GetY();
+        }
+        return 0;
+    }
+
+    UNITY_INTERFACE_EXPORT UINT UNITY_INTERFACE_API UwcGetWindowWidth(int id)
+    {
+        if (auto window = GetWindow(id))
+        {
+            return window->GetWidth();
+        }
+        return 0;
+    }
+
+    UNITY_INTERFACE_EXPORT UINT UNITY_INTERFACE_API UwcGetWindowHeight(int id)
+    {
+        if (auto window = GetWindow(id))
+        {
+            return window->GetHeight();
+        }
+        return 0;
+    }
+
+    UNITY_INTERFACE_EXPORT UINT UNITY_INTERFACE_API UwcGetWindowZOrder(int id)
+    {
+        if (auto window = GetWindow(id))
+        {
+            return window->GetZOrder();
+        }
+        return 0;
+    }
+
+    UNITY_INTERFACE_EXPORT BYTE* UNITY_INTERFACE_API UwcGetWindowBuffer(int id)
+    {
+        if (auto window = GetWindow(id))
+        {
+            return window->GetBuffer();
+        }
+        return nullptr;
+    }
+
+    UNITY_INTERFACE_EXPORT UINT UNITY_INTERFACE_API UwcGetWindowTextureWidth(int id)
+    {
+        if (auto window = GetWindow(id))
+        {
+            return window->GetTextureWidth();
+        }
+        return 0;
+    }
+
+    UNITY_INTERFACE_EXPORT UINT UNITY_INTERFACE_API UwcGetWindowTextureHeight(int id)
+    {
+        if (auto window = GetWindow(id))
+        {
+            return window->GetTextureHeight();
+        }
+        return 0;
+    }
+
+    UNITY_INTERFACE_EXPORT UINT UNITY_INTERFACE_API UwcGetWindowTextureOffsetX(int id)
+    {
+        if (auto window = GetWindow(id))
+        {
+            return window->GetTextureOffsetX();
+        }
+        return 0;
+    }
+
+    UNITY_INTERFACE_EXPORT UINT UNITY_INTERFACE_API UwcGetWindowTextureOffsetY(int id)
+    {
+        if (auto window = GetWindow(id))
+        {
+            return window->GetTextureOffsetY();
+        }
+        return 0;
+    }
+
+    UNITY_INTERFACE_EXPORT UINT UNITY_INTERFACE_API UwcGetWindowIconWidth(int id)
+    {
+        if (auto window = GetWindow(id))
+        {
+            return window->GetIconWidth();
+        }
+        return 0;
+    }
+
+    UNITY_INTERFACE_EXPORT UINT UNITY_INTERFACE_API UwcGetWindowIconHeight(int id)
+    {
+        if (auto window = GetWindow(id))
+        {
+            return window->GetIconHeight();
+        }
+        return 0;
+    }
+
+    UNITY_INTERFACE_EXPORT UINT UNITY_INTERFACE_API UwcGetWindowTitleLength(int id)
+    {
+        if (auto window = GetWindow(id))
+        {
+            return static_cast<UINT>(window->GetTitle().length());
+        }
+        return 0;
+    }
+
+    UNITY_INTERFACE_EXPORT const WCHAR* UNITY_INTERFACE_API UwcGetWindowTitle(int id)
+    {
+        if (auto window = GetWindow(id))
+        {
+            return window->GetTitle().c_str();
+        }
+        return nullptr;
+    }
+
+    UNITY_INTERFACE_EXPORT UINT UNITY_INTERFACE_API UwcGetWindowClassNameLength(int id)
+    {
+        if (auto window = GetWindow(id))
+        {
+            return static_cast<UINT>(window->GetClass().length());
+        }
+        return 0;
+    }
+
+    UNITY_INTERFACE_EXPORT const CHAR* UNITY_INTERFACE_API UwcGetWindowClassName(int id)
+    {
+        if (auto window = GetWindow(id))
+        {
+            return window->GetClass().c_str();
+        }
+        return nullptr;
+    }
+
+    UNITY_INTERFACE_EXPORT ID3D11Texture2D* UNITY_INTERFACE_API UwcGetWindowTexturePtr(int id)
+    {
+        if (auto window = GetWindow(id))
+        {
+            return window->GetWindowTexture();
+        }
+        return nullptr;
+    }
+
+    UNITY_INTERFACE_EXPORT void UNITY_INTERFACE_API UwcSetWindowTexturePtr(int id, ID3D11Texture2D* ptr)
+    {
+        if (auto window = GetWindow(id))
+        {
+            window->SetWindowTexture(ptr);
+        }
+    }
+
+    UNITY_INTERFACE_EXPORT ID3D11Texture2D* UNITY_INTERFACE_API UwcGetWindowIconTexturePtr(int id)
+    {
+        if (auto window = GetWindow(id))
+        {
+            return window->GetIconTexture();
+        }
+        return nullptr;
+    }
+
+    UNITY_INTERFACE_EXPORT void UNITY_INTERFACE_API UwcSetWindowIconTexturePtr(int id, ID3D11Texture2D* ptr)
+    {
+        if (auto window = GetWindow(id))
+        {
+            window->SetIconTexture(ptr);
+        }
+    }
+
+    UNITY_INTERFACE_EXPORT CaptureMode UNITY_INTERFACE_API UwcGetWindowCaptureMode(int id)
+    {
+        if (auto window = GetWindow(id))
+        {
+            return window->GetCaptureMode();
+        }
+        return CaptureMode::None;
+    }
+
+    UNITY_INTERFACE_EXPORT void UNITY_INTERFACE_API UwcSetWindowCaptureMode(int id, CaptureMode mode)
+    {
+        if (auto window = GetWindow(id))
+        {
+            return window->SetCaptureMode(mode);
+        }
+    }
+
+    UNITY_INTERFACE_EXPORT bool UNITY_INTERFACE_API UwcGetWindowCursorDraw(int id)
+    {
+        if (auto window = GetWindow(id))
+        {
+            return window->GetCursorDraw();
+        }
+        return false;
+    }
+
+    UNITY_INTERFACE_EXPORT void UNITY_INTERFACE_API UwcSetWindowCursorDraw(int id, bool draw)
+    {
+        if (auto window = GetWindow(id))
+        {
+            return window->SetCursorDraw(draw);
+        }
+    }
+
+    UNITY_INTERFACE_EXPORT bool UNITY_INTERFACE_API UwcIsWindow(int id)
+    {
+        if (auto window = GetWindow(id))
+        {
+            return window->IsWindow() > 0;
+        }
+        return false;
+    }
+
+    UNITY_INTERFACE_EXPORT bool UNITY_INTERFACE_API UwcIsAltTabWindow(int id)
+    {
+        if (auto window = GetWindow(id))
+        {
+            return window->IsAltTab();
+        }
+        return false;
+    }
+
+    UNITY_INTERFACE_EXPORT bool UNITY_INTERFACE_API UwcIsDesktop(int id)
+    {
+        if (auto window = GetWindow(id))
+        {
+            return window->IsDesktop();
+        }
+        return false;
+    }
+
+    UNITY_INTERFACE_EXPORT bool UNITY_INTERFACE_API UwcIsWindowVisible(int id)
+    {
+        if (auto window = GetWindow(id))
+        {
+            return window->IsVisible() > 0;
+        }
+        return false;
+    }
+
+    UNITY_INTERFACE_EXPORT bool UNITY_INTERFACE_API UwcIsWindowEnabled(int id)
+    {
+        if (auto window = GetWindow(id))
+        {
+            return window->IsEnabled() > 0;
+        }
+        return false;
+    }
+
+    UNITY_INTERFACE_EXPORT bool UNITY_INTERFACE_API UwcIsWindowUnicode(int id)
+    {
+        if (auto window = GetWindow(id))
+        {
+            return window->IsUnicode() > 0;
+        }
+        return false;
+    }
+
+    UNITY_INTERFACE_EXPORT bool UNITY_INTERFACE_API UwcIsWindowZoomed(int id)
+    {
+        if (auto window = GetWindow(id))
+        {
+            return window->IsZoomed() > 0;
+        }
+        return false;
+    }
+
+    UNITY_INTERFACE_EXPORT bool UNITY_INTERFACE_API UwcIsWindowIconic(int id)
+    {
+        if (auto window = GetWindow(id))
+        {
+            return window->IsIconic() > 0;
+        }
+        return false;
+    }
+
+    UNITY_INTERFACE_EXPORT bool UNITY_INTERFACE_API UwcIsWindowHungUp(int id)
+    {
+        if (auto window = GetWindow(id))
+        {
+            return window->IsHungUp() > 0;
+        }
+        return false;
+    }
+
+    UNITY_INTERFACE_EXPORT bool UNITY_INTERFACE_API UwcIsWindowTouchable(int id)
+    {
+        if (auto window = GetWindow(id))
+        {
+            return window->IsTouchable() > 0;
+        }
+        return false;
+    }
+
+    UNITY_INTERFACE_EXPORT bool UNITY_INTERFACE_API UwcIsWindowApplicationFrameWindow(int id)
+    {
+        if (auto window = GetWindow(id))
+        {
+            return window->IsApplicationFrameWindow() > 0;
+        }
+        return false;
+    }
+
+    UNITY_INTERFACE_EXPORT bool UNITY_INTERFACE_API UwcIsWindowUWP(int id)
+    {
+        if (auto window = GetWindow(id))
+        {
+            return IsUWP(window->GetProcessId());
+        }
+        return false;
+    }
+
+    UNITY_INTERFACE_EXPORT bool UNITY_INTERFACE_API UwcIsWindowBackground(int id)
+    {
+        if (auto window = GetWindow(id))
+        {
+            return window->IsBackground() > 0;
+        }
+        return false;
+    }
+
+    UNITY_INTERFACE_EXPORT bool UNITY_INTERFACE_API UwcIsWindowQuarantined(int id)
+    {
+        if (auto window = GetWindow(id))
+        {
+            return window->IsQuarantined();
+        }
+        return false;
+    }
+
+    UNITY_INTERFACE_EXPORT bool UNITY_INTERFACE_API UwcGetWindowQuarantineInfo(int id, QuarantineInfo* info)
+    {
+        if (!info) return false;
+        if (auto window = GetWindow(id))
+        {
+            window->GetQuarantineInfo(info);
+            return true;
+        }
+        return false;
+    }
+
+    UNITY_INTERFACE_EXPORT void UNITY_INTERFACE_API UwcSetWatchdogThreshold(UINT milliseconds)
+    {
+        Watchdog::SetThreshold(std::chrono::milliseconds(milliseconds));
+    }
+
+    UNITY_INTERFACE_EXPORT UINT UNITY_INTERFACE_API UwcGetWindowPixel(int id, int x, int y)
+    {
+        if (auto window = GetWindow(id))
+        {
+            return window->GetPixel(x, y);
+        }
+        return 0;
+    }
+
+    UNITY_INTERFACE_EXPORT bool UNITY_INTERFACE_API UwcGetWindowPixels(int id, BYTE* output, int x, int y, int width, int height)
+    {
+        if (auto window = GetWindow(id))
+        {
+            return window->GetPixels(output, x, y, width, height);
+        }
+        return false;
+    }
+
+    UNITY_INTERFACE_EXPORT POINT UNITY_INTERFACE_API UwcGetCursorPosition()
+    {
+        POINT point;
+        GetCursorPos(&point);
+        return point;
+    }
+
+    UNITY_INTERFACE_EXPORT int UNITY_INTERFACE_API UwcGetWindowIdFromPoint(int x, int y)
+    {
+        if (WindowManager::IsNull()) return -1;
+        if (auto window = WindowManager::Get().GetWindowFromPoint({ x, y }))
+        {
+            return window->GetId();
+        }
+        return -1;
+    }
+
+    UNITY_INTERFACE_EXPORT void UNITY_INTERFACE_API UwcGetWindowIdsFromPoints(const POINT* points, UINT count, int* ids)
+    {
+        if (WindowManager::IsNull() || !points || !ids) return;
+        WindowManager::Get().GetWindowIdsFromPoints(points, count, ids);
+    }
+
+    UNITY_INTERFACE_EXPORT UINT UNITY_INTERFACE_API UwcGetWindowIdsInRect(int x, int y, int width, int height, int* ids, UINT capacity)
+    {
+        if (WindowManager::IsNull()) return 0;
+
+        // returns the total count so that the caller can retry with a larger buffer.
+        const auto windowIds = WindowManager::Get().GetWindowIdsInRect({ x, y, x + width, y + height });
+        const UINT n = min(capacity, static_cast<UINT>(windowIds.size()));
+        for (UINT i = 0; ids && i < n; ++i)
+        {
+            ids[i] = windowIds[i];
+        }
+        return static_cast<UINT>(windowIds.size());
+    }
+
+    UNITY_INTERFACE_EXPORT void UNITY_INTERFACE_API UwcSetWindowFilter(
+        UINT flags, 
+        UINT minWidth, 
+        UINT minHeight, 
+        const DWORD* processIds, 
+        UINT processIdCount, 
+        const wchar_t** processNames, 
+        UINT processNameCount, 
+        const wchar_t* classPattern, 
+        const wchar_t* titlePattern)
+    {
+        if (WindowManager::IsNull()) return;
+
+        WindowFilterSettings settings;
+        settings.flags = flags;
+        settings.minWidth = minWidth;
+        settings.minHeight = minHeight;
+        if (processIds)
+        {
+            settings.processIds.assign(processIds, processIds + processIdCount);
+        }
+        for (UINT i = 0; processNames && i < processNameCount; ++i)
+        {
+            if (processNames[i]) settings.processNames.push_back(processNames[i]);
+        }
+        if (classPattern) settings.classPattern = classPattern;
+        if (titlePattern) settings.titlePattern = titlePattern;
+
+        WindowManager::Get().SetWindowFilter(settings);
+    }
+
+    UNITY_INTERFACE_EXPORT void UNITY_INTERFACE_API UwcClearWindowFilter()
+    {
+        if (WindowManager::IsNull()) return;
+        WindowManager::Get().SetWindowFilter(WindowFilterSettings());
+    }
+
+    UNITY_INTERFACE_EXPORT UINT UNITY_INTERFACE_API UwcGetWindowSnapshot(WindowSnapshotEntry* buffer, UINT capacity, UINT64* version)
+    {
+        if (WindowManager::IsNull()) return 0;
+
+        // returns the total count so that the caller can retry with a larger buffer.
+        const auto snapshot = WindowManager::Get().GetSnapshot();
+        const UINT n = min(capacity, static_cast<UINT>(snapshot->entries.size()));
+        if (buffer && n > 0)
+        {
+            memcpy(buffer, &snapshot->entries[0], n * sizeof(WindowSnapshotEntry));
+        }
+        if (version)
+        {
+            *version = snapshot->version;
+        }
+        return static_cast<UINT>(snapshot->entries.size());
+    }
+
+    UNITY_INTERFACE_EXPORT UINT UNITY_INTERFACE_API UwcGetWindowsOfProcess(DWORD processId, int* ids, UINT capacity)
+    {
+        if (WindowManager::IsNull()) return 0;
+
+        // returns the total count so that the caller can retry with a larger buffer.
+        const auto windowIds = WindowManager::Get().GetWindowsOfProcess(processId);
+        const UINT n = min(capacity, static_cast<UINT>(windowIds.size()));
+        for (UINT i = 0; ids && i < n; ++i)
+        {
+            ids[i] = windowIds[i];
+        }
+        return static_cast<UINT>(windowIds.size());
+    }
+
+    UNITY_INTERFACE_EXPORT int UNITY_INTERFACE_API UwcGetWindowIdUnderCursor()
+    {
+        if (WindowManager::IsNull()) return -1;
+        if (auto window = WindowManager::Get().GetCursorWindow())
+        {
+            return window->GetId();
+        }
+        return -1;
+    }
+
+    UNITY_INTERFACE_EXPORT void UNITY_INTERFACE_API UwcRequestCaptureCursor()
+    {
+        if (WindowManager::IsNull()) return;
+        if (auto& cursor = WindowManager::Get().GetCursor())
+        {
+            return cursor->RequestCapture();
+        }
+    }
+
+    UNITY_INTERFACE_EXPORT UINT UNITY_INTERFACE_API UwcGetCursorX()
+    {
+        if (WindowManager::IsNull()) return -1;
+        if (auto& cursor = WindowManager::Get().GetCursor())
+        {
+            return cursor->GetX();
+        }
+        return -1;
+    }
+
+    UNITY_INTERFACE_EXPORT UINT UNITY_INTERFACE_API UwcGetCursorY()
+    {
+        if (WindowManager::IsNull()) return -1;
+        if (auto& cursor = WindowManager::Get().GetCursor())
+        {
+            return cursor->GetY();
+        }
+        return -1;
+    }
+
+    UNITY_INTERFACE_EXPORT UINT UNITY_INTERFACE_API UwcGetCursorWidth()
+    {
+        if (WindowManager::IsNull()) return -1;
+        if (auto& cursor = WindowManager::Get().GetCursor())
+        {
+            return cursor->GetWidth();
+        }
+        return -1;
+    }
+
+    UNITY_INTERFACE_EXPORT UINT UNITY_INTERFACE_API UwcGetCursorHeight()
+    {
+        if (WindowManager::IsNull()) return -1;
+        if (auto& cursor = WindowManager::Get().GetCursor())
+        {
+            return cursor->GetHeight();
+        }
+        return -1;
+    }
+
+    UNITY_INTERFACE_EXPORT void UNITY_INTERFACE_API UwcSetCursorTexturePtr(ID3D11Texture2D* ptr)
+    {
+        if (WindowManager::IsNull()) return;
+        if (auto& cursor = WindowManager::Get().GetCursor())
+        {
+            cursor->SetUnityTexturePtr(ptr);
+        }
+        return;
+    }
+
+    UNITY_INTERFACE_EXPORT UINT UNITY_INTERFACE_API UwcGetScreenX()
+    {
+        return ::GetSystemMetrics(SM_XVIRTUALSCREEN);
+    }
+
+    UNITY_INTERFACE_EXPORT UINT UNITY_INTERFACE_API UwcGetScreenY()
+    {
+        return ::GetSystemMetrics(SM_YVIRTUALSCREEN);
+    }
+
+    UNITY_INTERFACE_EXPORT UINT UNITY_INTERFACE_API UwcGetScreenWidth()
+    {
+        return ::GetSystemMetrics(SM_CXVIRTUALSCREEN);
+    }
+
+    UNITY_INTERFACE_EXPORT UINT UNITY_INTERFACE_API UwcGetScreenHeight()
+    {
+        return ::GetSystemMetrics(SM_CYVIRTUALSCREEN);
+    }
 }
\ No newline at end of file
@@ -1,34 +1,112 @@
-#include "Message.h"
-
-
-
-UWC_SINGLETON_INSTANCE(MessageManager)
-
-
-UINT MessageManager::GetCount() const
-{
-    std::lock_guard<std::mutex> lock(mutex_);
-    return static_cast<UINT>(messages_.size());
-}
-
-
-const Message* MessageManager::GetHeadPointer() const
-{
-    std::lock_guard<std::mutex> lock(mutex_);
-    if (messages_.empty()) return nullptr;
-    return &messages_[0];
-}
-
-
-void MessageManager::Add(Message message)
-{
-    std::lock_guard<std::mutex> lock(mutex_);
-    messages_.push_back(message);
-}
-
-
-void MessageManager::ClearAll()
-{
-    std::lock_guard<std::mutex> lock(mutex_);
-    messages_.clear();
-}
\ No newline at end of file
+#include "Message.h"
+
+
+
+UWC_SINGLETON_INSTANCE(MessageManager)
+
+
+UINT64 MessageManager::GetTypeBit(MessageType type)
+{
+    const int index = static_cast<int>(type);
+    if (index >= static_cast<int>(MessageType::Error)) return kErrorTypeBit;
+    if (index < 0 || index >= 63) return 0;
+    return 1ull << index;
+}
+
+
+bool MessageManager::IsCoalescable(MessageType type)
+{
+    switch (type)
+    {
+        case MessageType::WindowCaptured:
+        case MessageType::WindowSizeChanged:
+        case MessageType::IconCaptured:
+        case MessageType::CursorCaptured:
+        case MessageType::WindowMoved:
+        case MessageType::WindowZOrderChanged:
+        case MessageType::WindowTitleChanged:
+        case MessageType::WindowIconicChanged:
+        case MessageType::WindowMonitorChanged:
+            return true;
+        default:
+            return false;
+    }
+}
+
+
+void MessageManager::SetSubscription(UINT64 mask)
+{
+    subscription_ = mask;
+}
+
+
+UINT64 MessageManager::GetSubscription() const
+{
+    return subscription_;
+}
+
+
+UINT MessageManager::GetCount() const
+{
+    return static_cast<UINT>(frontMessages_.size());
+}
+
+
+const Message* MessageManager::GetHeadPointer() const
+{
+    if (frontMessages_.empty()) return nullptr;
+    return &frontMessages_[0];
+}
+
+
+UINT MessageManager::CopyTo(Message* output, UINT capacity) const
+{
+    // Message is a plain struct, so the front buffer is copied into the pinned managed array at once.
+    const UINT count = min(static_cast<UINT>(frontMessages_.size()), capacity);
+    if (count > 0)
+    {
+        memcpy(output, &frontMessages_[0], sizeof(Message) * count);
+    }
+    return count;
+}
+
+
+void MessageManager::Add(Message message)
+{
+    if ((subscription_ & GetTypeBit(message.type)) == 0) return;
+
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    if (IsCoalescable(message.type))
+    {
+        // keep the position of the first one so that the order against the other messages does not change.
+        const auto key = (static_cast<UINT64>(message.type) << 32) | static_cast<UINT32>(message.windowId);
+        const auto it = backIndices_.find(key);
+        if (it != backIndices_.end())
+        {
+            backMessages_[it->second] = message;
+            return;
+        }
+        backIndices_.emplace(key, backMessages_.size());
+    }
+
+    backMessages_.push_back(message);
+}
+
+
+UINT MessageManager::Swap()
+{
+    // the front buffer is read only by the consumer, so it can be cleared without the lock.
+    frontMessages_.clear();
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    frontMessages_.swap(backMessages_);
+    backIndices_.clear();
+    return static_cast<UINT>(frontMessages_.size());
+}
+
+
+void MessageManager::ClearAll()
+{
+    frontMessages_.clear();
+}
@@ -1,49 +1,86 @@
-#pragma once
-
-#include <Windows.h>
-#include <vector>
-#include <mutex>
-
-#include "Singleton.h"
-
-
-
-enum class MessageType : int
-{
-    None = -1,
-    WindowAdded = 0,
-    WindowRemoved = 1,
-    WindowCaptured = 2,
-    WindowSizeChanged = 3,
-    IconCaptured = 4,
-    CursorCaptured = 5,
-    Error = 1000,
-    TextureNullError = 1001,
-    TextureSizeError = 1002,
-};
-
-
-struct Message
-{
-    MessageType type = MessageType::None;
-    int windowId = -1;
-    void* userData = nullptr;
-    Message(MessageType type, int id, void* userData)
-        : type(type), windowId(id), userData(userData) {}
-};
-
-
-class MessageManager
-{
-    UWC_SINGLETON(MessageManager)
-
-public:
-    void Add(Message message);
-    void ClearAll();
-    UINT GetCount() const;
-    const Message* GetHeadPointer() const;
-
-private:
-    std::vector<Message> messages_;
-    mutable std::mutex mutex_;
+#pragma once
+
+#include <Windows.h>
+#include <vector>
+#include <unordered_map>
+#include <mutex>
+#include <atomic>
+
+#include "Singleton.h"
+
+
+
+enum class MessageType : int
+{
+    None = -1,
+    WindowAdded = 0,
+    WindowRemoved = 1,
+    WindowCaptured = 2,
+    WindowSizeChanged = 3,
+    IconCaptured = 4,
+    CursorCaptured = 5,
+    WindowQuarantined = 6,
+    WindowRecovered = 7,
+    WindowMoved = 8,
+    WindowZOrderChanged = 9,
+    WindowTitleChanged = 10,
+    WindowIconicChanged = 11,
+    WindowMonitorChanged = 12,
+    WindowAttributesChanged = 13,
+    Error = 1000,
+    TextureNullError = 1001,
+    TextureSizeError = 1002,
+};
+
+
+// values hold the changed fields of the window messages:
+//   WindowMoved: x, y, width, height
+//   WindowZOrderChanged: zOrder
+//   WindowTitleChanged: titleVersion
+//   WindowIconicChanged: isIconic
+//   WindowMonitorChanged: userData is the new HMONITOR
+//   WindowAttributesChanged: isAltTabWindow, isUWP, isBackground, isTransparent
+struct Message
+{
+    MessageType type = MessageType::None;
+    int windowId = -1;
+    void* userData = nullptr;
+    int values[4] = { 0, 0, 0, 0 };
+    Message(MessageType type, int id, void* userData)
+        : type(type), windowId(id), userData(userData) {}
+    Message(MessageType type, int id, void* userData, int value0, int value1 = 0, int value2 = 0, int value3 = 0)
+        : type(type), windowId(id), userData(userData), values{ value0, value1, value2, value3 } {}
+};
+
+
+// Messages are added to the back buffer from any thread. The consumer swaps the buffers once per frame
+// and copies the front buffer at once, which stays untouched until the next Swap().
+// Messages which only tell the latest state of a window (captured, moved and so on) are coalesced,
+// and message types which are not subscribed are never added.
+class MessageManager
+{
+    UWC_SINGLETON(MessageManager)
+
+public:
+    static constexpr UINT64 kErrorTypeBit = 1ull << 63; // all the error types share one bit
+
+    void Add(Message message);
+    UINT Swap();
+    void ClearAll();
+    UINT GetCount() const;
+    const Message* GetHeadPointer() const;
+    UINT CopyTo(Message* output, UINT capacity) const;
+
+    void SetSubscription(UINT64 mask);
+    UINT64 GetSubscription() const;
+    static UINT64 GetTypeBit(MessageType type);
+
+private:
+    static bool IsCoalescable(MessageType type);
+
+    std::vector<Message> backMessages_;
+    std::vector<Message> frontMessages_;
+    std::unordered_map<UINT64, size_t> backIndices_; // (type, window id) -> index of the coalescable message
+    std::atomic<UINT64> subscription_ = ~0ull;
+    mutable std::mutex mutex_;
 };
\ No newline at end of file
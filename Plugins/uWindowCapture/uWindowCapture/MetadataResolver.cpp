@@ -0,0 +1,124 @@
+#include "MetadataResolver.h"
+#include "Util.h"
+
+
+
+namespace
+{
+    constexpr unsigned int kResolverWorkerCount = 2;
+    constexpr int kTitleTimeout = 100; // [ms]
+}
+
+
+// ---
+
+
+MetadataResolver::MetadataResolver()
+    : workers_(kResolverWorkerCount)
+{
+}
+
+
+bool MetadataResolver::MarkPending(int id)
+{
+    std::lock_guard<std::mutex> lock(pendingMutex_);
+    return pendingIds_.insert(id).second;
+}
+
+
+void MetadataResolver::AddResult(WindowMetadata&& metadata)
+{
+    {
+        std::lock_guard<std::mutex> lock(pendingMutex_);
+        pendingIds_.erase(metadata.windowId);
+    }
+
+    std::lock_guard<std::mutex> lock(resultMutex_);
+    results_.push_back(std::move(metadata));
+}
+
+
+void MetadataResolver::ResolveTitle(WindowMetadata& metadata)
+{
+    ScopedTimer timer([&](std::chrono::microseconds us) { metadata.titleCallTime = us; });
+    metadata.hasTitle = GetWindowTitle(metadata.hWnd, metadata.title, kTitleTimeout);
+}
+
+
+void MetadataResolver::RequestAttributes(int id, HWND hWnd, DWORD processId)
+{
+    if (!MarkPending(id)) return;
+
+    workers_.Push([this, id, hWnd, processId]
+    {
+        WindowMetadata metadata;
+        metadata.windowId = id;
+        metadata.hWnd = hWnd;
+
+        GetWindowClassName(hWnd, metadata.className);
+        metadata.isAltTabWindow = IsAltTabWindow(hWnd);
+        metadata.isApplicationFrameWindow = IsApplicationFrameWindow(metadata.className);
+        if (const auto process = GetProcessInfo(processId))
+        {
+            metadata.isUWP = process->isUWP;
+        }
+        metadata.hasAttributes = true;
+
+        ResolveTitle(metadata);
+
+        AddResult(std::move(metadata));
+    });
+}
+
+
+bool MetadataResolver::RequestTitle(int id, HWND hWnd)
+{
+    // refused while another request of the window is running, so the caller asks again later.
+    if (!MarkPending(id)) return false;
+
+    workers_.Push([this, id, hWnd]
+    {
+        WindowMetadata metadata;
+        metadata.windowId = id;
+        metadata.hWnd = hWnd;
+        ResolveTitle(metadata);
+        AddResult(std::move(metadata));
+    });
+
+    return true;
+}
+
+
+std::vector<WindowMetadata> MetadataResolver::TakeResults()
+{
+    std::vector<WindowMetadata> results;
+    std::lock_guard<std::mutex> lock(resultMutex_);
+    results.swap(results_);
+    return results;
+}
+
+
+std::shared_ptr<const ProcessInfo> MetadataResolver::GetProcessInfo(DWORD processId)
+{
+    {
+        std::lock_guard<std::mutex> lock(processMutex_);
+        const auto it = processes_.find(processId);
+        if (it != processes_.end()) return it->second;
+    }
+
+    // resolved without the lock since OpenProcess() can be slow; the first result wins.
+    auto info = std::make_shared<ProcessInfo>();
+    info->isUWP = IsUWP(processId);
+    GetProcessImagePath(processId, info->imagePath);
+
+    std::lock_guard<std::mutex> lock(processMutex_);
+    return processes_.emplace(processId, info).first->second;
+}
+
+
+void MetadataResolver::ForgetProcess(DWORD processId)
+{
+    // process ids are reused after the process exits.
+    std::lock_guard<std::mutex> lock(processMutex_);
+    processes_.erase(processId);
+}
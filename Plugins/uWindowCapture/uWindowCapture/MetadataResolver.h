@@ -0,0 +1,70 @@
+#pragma once
+
+#include <Windows.h>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "Thread.h"
+
+
+// Shared by all the windows of a process.
+struct ProcessInfo
+{
+    bool isUWP;
+    std::wstring imagePath;
+};
+
+
+struct WindowMetadata
+{
+    int windowId = -1;
+    HWND hWnd = NULL;
+
+    bool hasAttributes = false;
+    std::string className;
+    bool isAltTabWindow = false;
+    bool isApplicationFrameWindow = false;
+    bool isUWP = false;
+
+    bool hasTitle = false;
+    std::wstring title;
+    std::chrono::microseconds titleCallTime = std::chrono::microseconds::zero();
+};
+
+
+// Resolves the window properties which may block (WM_GETTEXT to a hung window, process queries)
+// on worker threads so that one unresponsive application does not stall the window list.
+// Results are collected by the window thread with TakeResults().
+class MetadataResolver
+{
+public:
+    MetadataResolver();
+
+    void RequestAttributes(int id, HWND hWnd, DWORD processId);
+    bool RequestTitle(int id, HWND hWnd);
+    std::vector<WindowMetadata> TakeResults();
+
+    std::shared_ptr<const ProcessInfo> GetProcessInfo(DWORD processId);
+    void ForgetProcess(DWORD processId);
+
+private:
+    bool MarkPending(int id);
+    void AddResult(WindowMetadata&& metadata);
+    static void ResolveTitle(WindowMetadata& metadata);
+
+    std::mutex pendingMutex_;
+    std::unordered_set<int> pendingIds_;
+
+    std::mutex resultMutex_;
+    std::vector<WindowMetadata> results_;
+
+    std::mutex processMutex_;
+    std::unordered_map<DWORD, std::shared_ptr<const ProcessInfo>> processes_;
+
+    WorkerPool workers_; // destroyed first since the tasks touch the members above.
+};
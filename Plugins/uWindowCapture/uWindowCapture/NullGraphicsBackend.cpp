@@ -0,0 +1,223 @@
+#include "NullGraphicsBackend.h"
+#include "Debug.h"
+
+
+
+NullSharedTexture::NullSharedTexture(UINT width, UINT height)
+    : width_(width)
+    , height_(height)
+    , pixels_(width * height * 4)
+{
+}
+
+
+UINT NullSharedTexture::GetWidth() const
+{
+    return width_;
+}
+
+
+UINT NullSharedTexture::GetHeight() const
+{
+    return height_;
+}
+
+
+SharedTextureDesc NullSharedTexture::GetDesc() const
+{
+    return { width_, height_, 0 };
+}
+
+
+void NullSharedTexture::Write(const BYTE* data, UINT pitch)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    const UINT rowSize = width_ * 4;
+    for (UINT y = 0; y < height_; ++y)
+    {
+        memcpy(&pixels_[y * rowSize], data + y * pitch, rowSize);
+    }
+}
+
+
+bool NullSharedTexture::WriteRegion(const RECT& region, const BYTE* data, UINT pitch)
+{
+    if (region.left < 0 || region.top < 0 ||
+        region.right <= region.left || region.bottom <= region.top ||
+        static_cast<UINT>(region.right) > width_ ||
+        static_cast<UINT>(region.bottom) > height_)
+    {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    const UINT rowSize = (region.right - region.left) * 4;
+    for (LONG y = region.top; y < region.bottom; ++y)
+    {
+        memcpy(&pixels_[(region.left + y * width_) * 4], data + (y - region.top) * pitch, rowSize);
+    }
+    return true;
+}
+
+
+std::vector<BYTE> NullSharedTexture::GetPixels() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return pixels_;
+}
+
+
+// ---
+
+
+NullGpuFence::NullGpuFence(UINT latency)
+    : latency_(latency)
+{
+}
+
+
+void NullGpuFence::Signal()
+{
+    remainingPollCount_ = latency_;
+}
+
+
+bool NullGpuFence::IsCompleted()
+{
+    if (remainingPollCount_ == 0) return true;
+
+    remainingPollCount_--;
+    return false;
+}
+
+
+// ---
+
+
+void NullGraphicsBackend::RegisterUnityTexture(ID3D11Texture2D* unityTexture, UINT width, UINT height)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    unityTextureSizes_[unityTexture] = { width, height };
+}
+
+
+void NullGraphicsBackend::GetStats(NullGraphicsBackendStats* stats) const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    *stats = stats_;
+}
+
+
+void NullGraphicsBackend::SetFenceLatency(UINT pollCount)
+{
+    fenceLatency_ = pollCount;
+}
+
+
+const char* NullGraphicsBackend::GetName() const
+{
+    return "Null";
+}
+
+
+bool NullGraphicsBackend::GetUnityTextureSize(ID3D11Texture2D* unityTexture, UINT* width, UINT* height) const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    const auto it = unityTextureSizes_.find(unityTexture);
+    if (it == unityTextureSizes_.end()) return false;
+
+    *width = it->second.first;
+    *height = it->second.second;
+    return true;
+}
+
+
+bool NullGraphicsBackend::GetUnityTextureDesc(ID3D11Texture2D* unityTexture, SharedTextureDesc* desc) const
+{
+    UINT width, height;
+    if (!GetUnityTextureSize(unityTexture, &width, &height)) return false;
+
+    *desc = { width, height, 0 };
+    return true;
+}
+
+
+std::shared_ptr<IGpuFence> NullGraphicsBackend::CreateFence(GpuQueue queue)
+{
+    return std::make_shared<NullGpuFence>(fenceLatency_);
+}
+
+
+std::shared_ptr<ISharedTexture> NullGraphicsBackend::CreateSharedTexture(ID3D11Texture2D* unityTexture)
+{
+    UINT width, height;
+    if (!GetUnityTextureSize(unityTexture, &width, &height)) return nullptr;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stats_.createdTextureCount++;
+    }
+
+    return std::make_shared<NullSharedTexture>(width, height);
+}
+
+
+bool NullGraphicsBackend::UpdateSharedTexture(ISharedTexture* texture, const BYTE* data, UINT pitch)
+{
+    const auto sharedTexture = static_cast<NullSharedTexture*>(texture);
+    if (!sharedTexture) return false;
+
+    sharedTexture->Write(data, pitch);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    stats_.uploadCount++;
+    stats_.uploadedBytes += sharedTexture->GetWidth() * sharedTexture->GetHeight() * 4;
+    return true;
+}
+
+
+bool NullGraphicsBackend::UpdateSharedTextureRegion(ISharedTexture* texture, const RECT& region, const BYTE* data, UINT pitch)
+{
+    const auto sharedTexture = static_cast<NullSharedTexture*>(texture);
+    if (!sharedTexture) return false;
+
+    if (!sharedTexture->WriteRegion(region, data, pitch))
+    {
+        Debug::Error(__FUNCTION__, " => Region is out of the texture.");
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    stats_.uploadCount++;
+    stats_.uploadedBytes += static_cast<UINT64>(region.right - region.left) * (region.bottom - region.top) * 4;
+    return true;
+}
+
+
+void NullGraphicsBackend::Flush()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    stats_.flushCount++;
+}
+
+
+bool NullGraphicsBackend::CopyToUnityTexture(ISharedTexture* texture, ID3D11Texture2D* unityTexture)
+{
+    if (!texture || !unityTexture) return false;
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    stats_.renderCount++;
+    return true;
+}
+
+
+void NullGraphicsBackend::GetSharedResourceStats(UINT64* openCount, UINT64* reuseCount) const
+{
+    // nothing has to be opened on the render side.
+    std::lock_guard<std::mutex> lock(mutex_);
+    *openCount = 0;
+    *reuseCount = stats_.renderCount;
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <vector>
+#include <mutex>
+#include <atomic>
+#include <unordered_map>
+
+#include "GraphicsBackend.h"
+
+
+class NullSharedTexture : public ISharedTexture
+{
+public:
+    NullSharedTexture(UINT width, UINT height);
+    UINT GetWidth() const override;
+    UINT GetHeight() const override;
+    SharedTextureDesc GetDesc() const override;
+
+    void Write(const BYTE* data, UINT pitch);
+    bool WriteRegion(const RECT& region, const BYTE* data, UINT pitch);
+    std::vector<BYTE> GetPixels() const;
+
+private:
+    const UINT width_;
+    const UINT height_;
+    std::vector<BYTE> pixels_;
+    mutable std::mutex mutex_;
+};
+
+
+// Completes after being polled the given number of times, to play a GPU running behind.
+class NullGpuFence : public IGpuFence
+{
+public:
+    explicit NullGpuFence(UINT latency);
+    void Signal() override;
+    bool IsCompleted() override;
+
+private:
+    const UINT latency_;
+    UINT remainingPollCount_ = 0;
+};
+
+
+struct NullGraphicsBackendStats
+{
+    UINT64 createdTextureCount;
+    UINT64 uploadCount;
+    UINT64 uploadedBytes;
+    UINT64 flushCount;
+    UINT64 renderCount;
+};
+
+
+// Records the uploads into memory without any GPU so that the capture, upload and render stages
+// can run headless. Never picked automatically; see SetGraphicsBackendType().
+// The sizes of the Unity textures have to be registered since they cannot be queried.
+class NullGraphicsBackend : public IGraphicsBackend
+{
+public:
+    void RegisterUnityTexture(ID3D11Texture2D* unityTexture, UINT width, UINT height);
+    void GetStats(NullGraphicsBackendStats* stats) const;
+    void SetFenceLatency(UINT pollCount);
+
+    const char* GetName() const override;
+    bool GetUnityTextureSize(ID3D11Texture2D* unityTexture, UINT* width, UINT* height) const override;
+    bool GetUnityTextureDesc(ID3D11Texture2D* unityTexture, SharedTextureDesc* desc) const override;
+    std::shared_ptr<IGpuFence> CreateFence(GpuQueue queue) override;
+
+    std::shared_ptr<ISharedTexture> CreateSharedTexture(ID3D11Texture2D* unityTexture) override;
+    bool UpdateSharedTexture(ISharedTexture* texture, const BYTE* data, UINT pitch) override;
+    bool UpdateSharedTextureRegion(ISharedTexture* texture, const RECT& region, const BYTE* data, UINT pitch) override;
+    void Flush() override;
+
+    bool CopyToUnityTexture(ISharedTexture* texture, ID3D11Texture2D* unityTexture) override;
+    void GetSharedResourceStats(UINT64* openCount, UINT64* reuseCount) const override;
+
+private:
+    mutable std::mutex mutex_;
+    std::unordered_map<ID3D11Texture2D*, std::pair<UINT, UINT>> unityTextureSizes_;
+    NullGraphicsBackendStats stats_ = {};
+    std::atomic<UINT> fenceLatency_ = 0;
+};
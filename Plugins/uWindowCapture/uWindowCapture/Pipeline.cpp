@@ -0,0 +1,85 @@
+#include "Pipeline.h"
+
+
+
+namespace
+{
+    float ToMilliseconds(std::chrono::microseconds us)
+    {
+        return us.count() / 1000.f;
+    }
+}
+
+
+// ---
+
+
+StageMetrics::StageMetrics(UINT budget)
+    : budget_(budget)
+{
+}
+
+
+void StageMetrics::SetBudget(UINT budget)
+{
+    budget_ = budget;
+}
+
+
+UINT StageMetrics::GetBudget() const
+{
+    return budget_;
+}
+
+
+void StageMetrics::AddProcessed(microseconds time)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    processed_++;
+    totalProcessTime_ += time;
+    maxProcessTime_ = max(maxProcessTime_, time);
+}
+
+
+void StageMetrics::AddDropped()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    dropped_++;
+}
+
+
+void StageMetrics::GetStats(PipelineStageStats* stats, const WindowQueue::Stats& queueStats, UINT queueCapacity) const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    stats->queueDepth = queueStats.depth;
+    stats->maxQueueDepth = queueStats.maxDepth;
+    stats->queueCapacity = queueCapacity;
+    stats->budget = budget_;
+    stats->processed = processed_;
+    stats->dropped = dropped_ + queueStats.dropped;
+    stats->overwritten = queueStats.coalesced;
+    stats->averageWaitTime = queueStats.dequeued > 0 ?
+        ToMilliseconds(queueStats.totalWaitTime) / queueStats.dequeued :
+        0.f;
+    stats->maxWaitTime = ToMilliseconds(queueStats.maxWaitTime);
+    stats->averageProcessTime = processed_ > 0 ?
+        ToMilliseconds(totalProcessTime_) / processed_ :
+        0.f;
+    stats->maxProcessTime = ToMilliseconds(maxProcessTime_);
+}
+
+
+WindowQueue::Stats MergeQueueStats(const WindowQueue::Stats& a, const WindowQueue::Stats& b)
+{
+    WindowQueue::Stats stats;
+    stats.depth = a.depth + b.depth;
+    stats.maxDepth = max(a.maxDepth, b.maxDepth);
+    stats.enqueued = a.enqueued + b.enqueued;
+    stats.dequeued = a.dequeued + b.dequeued;
+    stats.dropped = a.dropped + b.dropped;
+    stats.coalesced = a.coalesced + b.coalesced;
+    stats.totalWaitTime = a.totalWaitTime + b.totalWaitTime;
+    stats.maxWaitTime = max(a.maxWaitTime, b.maxWaitTime);
+    return stats;
+}
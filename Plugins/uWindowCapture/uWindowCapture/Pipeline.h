@@ -0,0 +1,91 @@
+#pragma once
+
+#include <Windows.h>
+#include <chrono>
+#include <mutex>
+#include <atomic>
+
+#include "WindowQueue.h"
+
+
+// Window frames flow capture -> upload -> render. Each stage pulls window ids
+// from its own bounded queue and processes at most `budget` of them per tick
+// (0 means unlimited, i.e. until the queue becomes empty).
+enum class PipelineStage
+{
+    Capture = 0,
+    Upload = 1,
+    Render = 2,
+};
+
+
+struct PipelineStageStats
+{
+    UINT queueDepth;
+    UINT maxQueueDepth;
+    UINT queueCapacity;
+    UINT budget;
+    UINT64 processed;
+    UINT64 dropped;
+    UINT64 overwritten; // superseded by a newer request for the same window
+    float averageWaitTime; // [ms]
+    float maxWaitTime; // [ms]
+    float averageProcessTime; // [ms]
+    float maxProcessTime; // [ms]
+};
+
+
+// Event ids given to GL.IssuePluginEvent(). Window ids are never negative,
+// so the negative values are left for the per-frame work and the capture groups.
+// kRenderEventFrame ticks the frame clock and copies the cursor and the atlas,
+// and kRenderEventAll does the same and copies all the windows too.
+// One of them must be issued every frame.
+constexpr int kRenderEventAll = -1;
+constexpr int kRenderEventFrame = -2;
+
+inline int GetGroupIdFromRenderEvent(int eventId)
+{
+    return -3 - eventId;
+}
+
+
+// Cost of each render event on Unity's render thread.
+struct RenderStats
+{
+    UINT64 frameCount;
+    UINT lastCopyCount;
+    UINT maxCopyCount;
+    float lastFrameTime; // [ms]
+    float averageFrameTime; // [ms]
+    float maxFrameTime; // [ms]
+    UINT64 openedResourceCount; // shared textures opened on Unity's device
+    UINT64 reusedResourceCount; // copies from an already opened one
+};
+
+
+class StageMetrics
+{
+public:
+    using microseconds = std::chrono::microseconds;
+
+    explicit StageMetrics(UINT budget);
+
+    void SetBudget(UINT budget);
+    UINT GetBudget() const;
+
+    void AddProcessed(microseconds time);
+    void AddDropped();
+    void GetStats(PipelineStageStats* stats, const WindowQueue::Stats& queueStats, UINT queueCapacity) const;
+
+private:
+    std::atomic<UINT> budget_;
+
+    mutable std::mutex mutex_;
+    UINT64 processed_ = 0;
+    UINT64 dropped_ = 0;
+    microseconds totalProcessTime_ = microseconds::zero();
+    microseconds maxProcessTime_ = microseconds::zero();
+};
+
+
+WindowQueue::Stats MergeQueueStats(const WindowQueue::Stats& a, const WindowQueue::Stats& b);
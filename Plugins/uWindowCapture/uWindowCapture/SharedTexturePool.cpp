@@ -0,0 +1,77 @@
+#include "SharedTexturePool.h"
+
+
+
+namespace
+{
+    constexpr UINT kMaxPooledTexturesPerDesc = 4;
+    constexpr UINT kMaxPooledTextures = 64;
+}
+
+
+// ---
+
+
+std::shared_ptr<ISharedTexture> SharedTexturePool::Acquire(IGraphicsBackend* backend, ID3D11Texture2D* unityTexture)
+{
+    SharedTextureDesc desc;
+    if (!backend || !backend->GetUnityTextureDesc(unityTexture, &desc)) return nullptr;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        auto it = textures_.find(desc);
+        if (it != textures_.end() && !it->second.empty())
+        {
+            auto texture = std::move(it->second.back());
+            it->second.pop_back();
+            if (it->second.empty()) textures_.erase(it);
+            pooledCount_--;
+            reusedCount_++;
+            return texture;
+        }
+    }
+
+    auto texture = backend->CreateSharedTexture(unityTexture);
+    if (texture)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        createdCount_++;
+    }
+
+    return texture;
+}
+
+
+void SharedTexturePool::Release(std::shared_ptr<ISharedTexture>&& texture)
+{
+    if (!texture) return;
+
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    // textures over the limits are just destroyed.
+    if (pooledCount_ >= kMaxPooledTextures) return;
+
+    auto& textures = textures_[texture->GetDesc()];
+    if (textures.size() >= kMaxPooledTexturesPerDesc) return;
+
+    textures.push_back(std::move(texture));
+    pooledCount_++;
+}
+
+
+void SharedTexturePool::Clear()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    textures_.clear();
+    pooledCount_ = 0;
+}
+
+
+void SharedTexturePool::GetStats(SharedTexturePoolStats* stats) const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    stats->createdCount = createdCount_;
+    stats->reusedCount = reusedCount_;
+    stats->pooledCount = pooledCount_;
+}
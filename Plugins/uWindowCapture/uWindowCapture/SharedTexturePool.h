@@ -0,0 +1,36 @@
+#pragma once
+
+#include <Windows.h>
+#include <map>
+#include <vector>
+#include <memory>
+#include <mutex>
+
+#include "GraphicsBackend.h"
+
+
+struct SharedTexturePoolStats
+{
+    UINT64 createdCount;
+    UINT64 reusedCount;
+    UINT pooledCount;
+};
+
+
+// Keeps released shared textures to hand them out again for the same description,
+// so that cursor and icon uploads do not allocate a new texture each time.
+class SharedTexturePool
+{
+public:
+    std::shared_ptr<ISharedTexture> Acquire(IGraphicsBackend* backend, ID3D11Texture2D* unityTexture);
+    void Release(std::shared_ptr<ISharedTexture>&& texture);
+    void Clear();
+    void GetStats(SharedTexturePoolStats* stats) const;
+
+private:
+    mutable std::mutex mutex_;
+    std::map<SharedTextureDesc, std::vector<std::shared_ptr<ISharedTexture>>> textures_;
+    UINT pooledCount_ = 0;
+    UINT64 createdCount_ = 0;
+    UINT64 reusedCount_ = 0;
+};
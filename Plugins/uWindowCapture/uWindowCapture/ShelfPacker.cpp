@@ -0,0 +1,196 @@
+#include <algorithm>
+#include "ShelfPacker.h"
+
+
+
+ShelfPacker::ShelfPacker(UINT pageWidth, UINT pageHeight, UINT maxPageCount)
+    : pageWidth_(pageWidth)
+    , pageHeight_(pageHeight)
+    , maxPageCount_(maxPageCount)
+{
+}
+
+
+bool ShelfPacker::Add(int id, UINT width, UINT height, bool* hasRepacked)
+{
+    *hasRepacked = false;
+
+    if (width == 0 || height == 0 || width > pageWidth_ || height > pageHeight_) return false;
+
+    Remove(id);
+
+    if (Place(id, width, height)) return true;
+
+    *hasRepacked = true;
+    return Repack(id, width, height);
+}
+
+
+bool ShelfPacker::Place(int id, UINT width, UINT height)
+{
+    // best fit: the lowest shelf which is high enough and has a wide enough free span.
+    Shelf* bestShelf = nullptr;
+    Span* bestSpan = nullptr;
+    UINT bestPage = 0;
+    for (UINT i = 0; i < pages_.size(); ++i)
+    {
+        for (auto& shelf : pages_[i].shelves)
+        {
+            if (shelf.height < height) continue;
+            if (bestShelf && shelf.height >= bestShelf->height) continue;
+
+            for (auto& span : shelf.freeSpans)
+            {
+                if (span.width < width) continue;
+                bestShelf = &shelf;
+                bestSpan = &span;
+                bestPage = i;
+                break;
+            }
+        }
+    }
+
+    // otherwise open a new shelf on the first page with enough room left, or a new page.
+    if (!bestShelf)
+    {
+        UINT pageIndex = 0;
+        for (; pageIndex < pages_.size(); ++pageIndex)
+        {
+            if (pages_[pageIndex].usedHeight + height <= pageHeight_) break;
+        }
+
+        if (pageIndex == pages_.size())
+        {
+            if (pages_.size() >= maxPageCount_) return false;
+            pages_.emplace_back();
+        }
+
+        auto& page = pages_[pageIndex];
+        page.shelves.push_back({ page.usedHeight, height, { { 0, pageWidth_ } } });
+        page.usedHeight += height;
+
+        bestShelf = &page.shelves.back();
+        bestSpan = &bestShelf->freeSpans.front();
+        bestPage = pageIndex;
+    }
+
+    rects_[id] = { bestPage, bestSpan->x, bestShelf->y, width, height };
+
+    bestSpan->x += width;
+    bestSpan->width -= width;
+    if (bestSpan->width == 0)
+    {
+        bestShelf->freeSpans.erase(bestShelf->freeSpans.begin() + (bestSpan - bestShelf->freeSpans.data()));
+    }
+
+    return true;
+}
+
+
+void ShelfPacker::Remove(int id)
+{
+    const auto it = rects_.find(id);
+    if (it == rects_.end()) return;
+
+    const auto rect = it->second;
+    rects_.erase(it);
+
+    auto& page = pages_[rect.page];
+    auto shelf = std::find_if(page.shelves.begin(), page.shelves.end(), [&rect](const Shelf& shelf) 
+    { 
+        return shelf.y == rect.y; 
+    });
+    if (shelf == page.shelves.end()) return;
+
+    // give the span back and merge it with the neighbors.
+    auto& spans = shelf->freeSpans;
+    auto next = std::find_if(spans.begin(), spans.end(), [&rect](const Span& span) { return span.x > rect.x; });
+    next = spans.insert(next, { rect.x, rect.width });
+    if (next + 1 != spans.end() && next->x + next->width == (next + 1)->x)
+    {
+        next->width += (next + 1)->width;
+        spans.erase(next + 1);
+    }
+    if (next != spans.begin() && (next - 1)->x + (next - 1)->width == next->x)
+    {
+        (next - 1)->width += next->width;
+        spans.erase(next);
+    }
+
+    // empty shelves at the bottom of the page give their height back.
+    while (!page.shelves.empty())
+    {
+        const auto& last = page.shelves.back();
+        if (last.freeSpans.size() != 1 || last.freeSpans.front().width != pageWidth_) break;
+        page.usedHeight = last.y;
+        page.shelves.pop_back();
+    }
+}
+
+
+bool ShelfPacker::Repack(int newId, UINT width, UINT height)
+{
+    struct Item
+    {
+        int id;
+        UINT width;
+        UINT height;
+    };
+
+    std::vector<Item> items;
+    items.reserve(rects_.size() + 1);
+    for (const auto& pair : rects_)
+    {
+        items.push_back({ pair.first, pair.second.width, pair.second.height });
+    }
+    items.push_back({ newId, width, height });
+
+    // taller ones first so that the shelves are filled with rects of similar heights.
+    std::sort(items.begin(), items.end(), [](const Item& a, const Item& b)
+    {
+        return (a.height != b.height) ? (a.height > b.height) : (a.width > b.width);
+    });
+
+    auto pages = std::move(pages_);
+    auto rects = std::move(rects_);
+    pages_.clear();
+    rects_.clear();
+
+    for (const auto& item : items)
+    {
+        if (!Place(item.id, item.width, item.height))
+        {
+            // keep the previous layout without the new one.
+            pages_ = std::move(pages);
+            rects_ = std::move(rects);
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
+const PackedRect* ShelfPacker::Find(int id) const
+{
+    const auto it = rects_.find(id);
+    return (it != rects_.end()) ? &it->second : nullptr;
+}
+
+
+UINT ShelfPacker::GetPageCount() const
+{
+    return static_cast<UINT>(pages_.size());
+}
+
+
+UINT ShelfPacker::GetPageWidth() const
+{
+    return pageWidth_;
+}
+
+
+UINT ShelfPacker::GetPageHeight() const
+{
+    return pageHeight_;
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <Windows.h>
+#include <vector>
+#include <unordered_map>
+
+
+struct PackedRect
+{
+    UINT page;
+    UINT x;
+    UINT y;
+    UINT width;
+    UINT height;
+};
+
+
+// Places rects on horizontal shelves of fixed-size pages. Removed rects give their span back to the shelf
+// so that later rects can reuse it, and everything is packed again only when a new rect fits nowhere.
+class ShelfPacker
+{
+public:
+    ShelfPacker(UINT pageWidth, UINT pageHeight, UINT maxPageCount);
+
+    bool Add(int id, UINT width, UINT height, bool* hasRepacked);
+    void Remove(int id);
+    const PackedRect* Find(int id) const;
+    UINT GetPageCount() const;
+    UINT GetPageWidth() const;
+    UINT GetPageHeight() const;
+
+private:
+    struct Span
+    {
+        UINT x;
+        UINT width;
+    };
+
+    struct Shelf
+    {
+        UINT y;
+        UINT height;
+        std::vector<Span> freeSpans;
+    };
+
+    struct Page
+    {
+        std::vector<Shelf> shelves;
+        UINT usedHeight = 0;
+    };
+
+    bool Place(int id, UINT width, UINT height);
+    bool Repack(int newId, UINT width, UINT height);
+
+    const UINT pageWidth_;
+    const UINT pageHeight_;
+    const UINT maxPageCount_;
+    std::vector<Page> pages_;
+    std::unordered_map<int, PackedRect> rects_;
+};
@@ -0,0 +1,176 @@
+#pragma once
+
+#include <Windows.h>
+#include <vector>
+#include <deque>
+
+
+// Dense storage addressed by generational ids.
+// An id packs the slot index and the generation of the slot, so a lookup is a bounds check and
+// a generation compare, and an id of a removed value is detected as stale even after its slot is reused.
+// Values are kept contiguous (removal moves the last value into the hole), so iteration order is not stable.
+template <class T>
+class SlotMap
+{
+public:
+    static constexpr int kIndexBits = 20;
+    static constexpr int kGenerationBits = 31 - kIndexBits; // ids stay positive
+    static constexpr UINT kIndexMask = (1u << kIndexBits) - 1;
+    static constexpr UINT kGenerationMask = (1u << kGenerationBits) - 1;
+    static constexpr size_t kMinFreeSlots = 64; // delays the reuse of a slot so that generations wrap slowly
+
+    using iterator = typename std::vector<T>::iterator;
+    using const_iterator = typename std::vector<T>::const_iterator;
+
+    // create is called with the new id and returns the value to store.
+    template <class CreateFunc>
+    int Insert(CreateFunc&& create)
+    {
+        UINT index;
+        if (freeSlots_.size() > kMinFreeSlots)
+        {
+            index = freeSlots_.front();
+            freeSlots_.pop_front();
+        }
+        else
+        {
+            index = static_cast<UINT>(slots_.size());
+            if (index > kIndexMask) return -1;
+            slots_.push_back({ 0, 0 });
+        }
+
+        auto& slot = slots_[index];
+        slot.denseIndex = static_cast<UINT>(values_.size());
+
+        const int id = MakeId(index, slot.generation);
+        values_.push_back(create(id));
+        ids_.push_back(id);
+
+        return id;
+    }
+
+    bool Erase(int id)
+    {
+        const auto slot = FindSlot(id);
+        if (!slot) return false;
+
+        EraseDense(slot->denseIndex);
+        return true;
+    }
+
+    // pred is called with each value, and the values for which it returns true are removed.
+    template <class Predicate>
+    void EraseIf(Predicate&& pred)
+    {
+        for (size_t i = 0; i < values_.size();)
+        {
+            if (pred(values_[i]))
+            {
+                EraseDense(static_cast<UINT>(i));
+            }
+            else
+            {
+                ++i;
+            }
+        }
+    }
+
+    T* Find(int id)
+    {
+        const auto slot = FindSlot(id);
+        return slot ? &values_[slot->denseIndex] : nullptr;
+    }
+
+    const T* Find(int id) const
+    {
+        const auto slot = FindSlot(id);
+        return slot ? &values_[slot->denseIndex] : nullptr;
+    }
+
+    bool Contains(int id) const
+    {
+        return FindSlot(id) != nullptr;
+    }
+
+    // true if the id was given by Insert() but its value has been removed since then.
+    bool IsStale(int id) const
+    {
+        if (id < 0) return false;
+        const UINT index = GetIndex(id);
+        return index < slots_.size() && !FindSlot(id);
+    }
+
+    void Clear()
+    {
+        values_.clear();
+        ids_.clear();
+        slots_.clear();
+        freeSlots_.clear();
+    }
+
+    size_t Size() const { return values_.size(); }
+    bool Empty() const { return values_.empty(); }
+
+    iterator begin() { return values_.begin(); }
+    iterator end() { return values_.end(); }
+    const_iterator begin() const { return values_.begin(); }
+    const_iterator end() const { return values_.end(); }
+
+private:
+    struct Slot
+    {
+        UINT generation;
+        UINT denseIndex;
+    };
+
+    static int MakeId(UINT index, UINT generation)
+    {
+        return static_cast<int>(((generation & kGenerationMask) << kIndexBits) | (index & kIndexMask));
+    }
+
+    static UINT GetIndex(int id)
+    {
+        return static_cast<UINT>(id) & kIndexMask;
+    }
+
+    static UINT GetGeneration(int id)
+    {
+        return (static_cast<UINT>(id) >> kIndexBits) & kGenerationMask;
+    }
+
+    const Slot* FindSlot(int id) const
+    {
+        if (id < 0) return nullptr;
+
+        const UINT index = GetIndex(id);
+        if (index >= slots_.size()) return nullptr;
+
+        const auto& slot = slots_[index];
+        if (slot.generation != GetGeneration(id) || slot.denseIndex >= ids_.size() || ids_[slot.denseIndex] != id) return nullptr;
+
+        return &slot;
+    }
+
+    void EraseDense(UINT denseIndex)
+    {
+        const UINT index = GetIndex(ids_[denseIndex]);
+        auto& slot = slots_[index];
+        slot.generation = (slot.generation + 1) & kGenerationMask;
+        freeSlots_.push_back(index);
+
+        const UINT last = static_cast<UINT>(values_.size() - 1);
+        if (denseIndex != last)
+        {
+            values_[denseIndex] = std::move(values_[last]);
+            ids_[denseIndex] = ids_[last];
+            slots_[GetIndex(ids_[denseIndex])].denseIndex = denseIndex;
+        }
+        values_.pop_back();
+        ids_.pop_back();
+    }
+
+    std::vector<T> values_;
+    std::vector<int> ids_; // parallel to values_
+    std::vector<Slot> slots_;
+    std::deque<UINT> freeSlots_;
+};
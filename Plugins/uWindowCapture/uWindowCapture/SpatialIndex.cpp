@@ -0,0 +1,261 @@
+#include <algorithm>
+#include "SpatialIndex.h"
+
+
+
+namespace
+{
+    constexpr int kCellSize = 256;
+    constexpr int kMaxCellCountPerEntry = 1024;
+
+    int ToCell(int x)
+    {
+        // floor division so that negative coordinates of sub monitors are handled.
+        return x >= 0 ? x / kCellSize : -((-x + kCellSize - 1) / kCellSize);
+    }
+
+    bool Contains(const RECT& rect, POINT point)
+    {
+        return 
+            point.x >= rect.left && point.x < rect.right &&
+            point.y >= rect.top && point.y < rect.bottom;
+    }
+
+    bool Intersects(const RECT& a, const RECT& b)
+    {
+        return 
+            a.left < b.right && b.left < a.right &&
+            a.top < b.bottom && b.top < a.bottom;
+    }
+
+    void EraseId(std::vector<int>& ids, int id)
+    {
+        const auto it = std::find(ids.begin(), ids.end(), id);
+        if (it != ids.end())
+        {
+            *it = ids.back();
+            ids.pop_back();
+        }
+    }
+}
+
+
+// ---
+
+
+SpatialIndex::CellRange SpatialIndex::GetCellRange(const RECT& rect)
+{
+    return 
+    { 
+        ToCell(rect.left), 
+        ToCell(rect.top), 
+        ToCell(max(rect.left, rect.right - 1)), 
+        ToCell(max(rect.top, rect.bottom - 1)),
+    };
+}
+
+
+INT64 SpatialIndex::GetCellKey(int x, int y)
+{
+    return (static_cast<INT64>(x) << 32) | static_cast<UINT>(y);
+}
+
+
+bool SpatialIndex::IsAbove(const Entry& a, const Entry& b)
+{
+    if (a.isDesktop != b.isDesktop) return !a.isDesktop;
+    return a.zOrder < b.zOrder;
+}
+
+
+void SpatialIndex::Update(int id, const RECT& rect, UINT zOrder, bool isDesktop)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    auto it = entries_.find(id);
+    if (it != entries_.end())
+    {
+        auto& entry = it->second;
+        entry.zOrder = zOrder;
+        entry.isDesktop = isDesktop;
+
+        // most windows do not move between ticks, so only the z-order is updated.
+        if (::EqualRect(&entry.rect, &rect)) return;
+
+        Erase(id, entry);
+        entry.rect = rect;
+        Insert(id, entry);
+        return;
+    }
+
+    Entry entry = { rect, zOrder, isDesktop, false, {} };
+    Insert(id, entry);
+    entries_.emplace(id, entry);
+}
+
+
+void SpatialIndex::Remove(int id)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    const auto it = entries_.find(id);
+    if (it == entries_.end()) return;
+
+    Erase(id, it->second);
+    entries_.erase(it);
+}
+
+
+void SpatialIndex::Clear()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    entries_.clear();
+    cells_.clear();
+    oversizedIds_.clear();
+}
+
+
+void SpatialIndex::Insert(int id, Entry& entry)
+{
+    entry.cells = GetCellRange(entry.rect);
+
+    const auto& cells = entry.cells;
+    const INT64 cellCount = 
+        static_cast<INT64>(cells.right - cells.left + 1) * 
+        static_cast<INT64>(cells.bottom - cells.top + 1);
+    entry.isOversized = cellCount > kMaxCellCountPerEntry;
+
+    if (entry.isOversized)
+    {
+        oversizedIds_.push_back(id);
+        return;
+    }
+
+    for (int y = cells.top; y <= cells.bottom; ++y)
+    {
+        for (int x = cells.left; x <= cells.right; ++x)
+        {
+            cells_[GetCellKey(x, y)].push_back(id);
+        }
+    }
+}
+
+
+void SpatialIndex::Erase(int id, const Entry& entry)
+{
+    if (entry.isOversized)
+    {
+        EraseId(oversizedIds_, id);
+        return;
+    }
+
+    const auto& cells = entry.cells;
+    for (int y = cells.top; y <= cells.bottom; ++y)
+    {
+        for (int x = cells.left; x <= cells.right; ++x)
+        {
+            const auto it = cells_.find(GetCellKey(x, y));
+            if (it == cells_.end()) continue;
+
+            EraseId(it->second, id);
+            if (it->second.empty())
+            {
+                cells_.erase(it);
+            }
+        }
+    }
+}
+
+
+int SpatialIndex::QueryPointWithoutLock(POINT point) const
+{
+    int topId = -1;
+    const Entry* top = nullptr;
+
+    const auto check = [&](int id)
+    {
+        const auto& entry = entries_.at(id);
+        if (!Contains(entry.rect, point)) return;
+        if (top && !IsAbove(entry, *top)) return;
+        topId = id;
+        top = &entry;
+    };
+
+    const auto it = cells_.find(GetCellKey(ToCell(point.x), ToCell(point.y)));
+    if (it != cells_.end())
+    {
+        for (const int id : it->second) check(id);
+    }
+    for (const int id : oversizedIds_) check(id);
+
+    return topId;
+}
+
+
+int SpatialIndex::QueryPoint(POINT point) const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return QueryPointWithoutLock(point);
+}
+
+
+void SpatialIndex::QueryPoints(const POINT* points, UINT count, int* outIds) const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    for (UINT i = 0; i < count; ++i)
+    {
+        outIds[i] = QueryPointWithoutLock(points[i]);
+    }
+}
+
+
+std::vector<int> SpatialIndex::QueryRect(const RECT& rect) const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    std::vector<int> ids;
+
+    const auto check = [&](int id)
+    {
+        if (Intersects(entries_.at(id).rect, rect))
+        {
+            ids.push_back(id);
+        }
+    };
+
+    const auto cells = GetCellRange(rect);
+    const INT64 cellCount = 
+        static_cast<INT64>(cells.right - cells.left + 1) * 
+        static_cast<INT64>(cells.bottom - cells.top + 1);
+
+    if (cellCount > static_cast<INT64>(entries_.size()))
+    {
+        // cheaper to test every entry than to visit every cell.
+        for (const auto& pair : entries_) check(pair.first);
+    }
+    else
+    {
+        for (int y = cells.top; y <= cells.bottom; ++y)
+        {
+            for (int x = cells.left; x <= cells.right; ++x)
+            {
+                const auto it = cells_.find(GetCellKey(x, y));
+                if (it == cells_.end()) continue;
+                for (const int id : it->second) check(id);
+            }
+        }
+        for (const int id : oversizedIds_) check(id);
+
+        // an entry spanning several cells has been found more than once.
+        std::sort(ids.begin(), ids.end());
+        ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+    }
+
+    std::sort(ids.begin(), ids.end(), [this](int a, int b)
+    {
+        return IsAbove(entries_.at(a), entries_.at(b));
+    });
+
+    return ids;
+}
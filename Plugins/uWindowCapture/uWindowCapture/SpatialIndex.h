@@ -0,0 +1,49 @@
+#pragma once
+
+#include <Windows.h>
+#include <unordered_map>
+#include <vector>
+#include <mutex>
+
+
+// Uniform grid of window rects for hit testing without calling into Win32.
+// Windows are ranked by z-order and desktops always come below windows.
+class SpatialIndex
+{
+public:
+    void Update(int id, const RECT& rect, UINT zOrder, bool isDesktop);
+    void Remove(int id);
+    void Clear();
+
+    int QueryPoint(POINT point) const;
+    void QueryPoints(const POINT* points, UINT count, int* outIds) const;
+    std::vector<int> QueryRect(const RECT& rect) const; // from the top to the bottom
+
+private:
+    struct CellRange
+    {
+        int left, top, right, bottom; // inclusive
+    };
+
+    struct Entry
+    {
+        RECT rect;
+        UINT zOrder;
+        bool isDesktop;
+        bool isOversized;
+        CellRange cells;
+    };
+
+    static CellRange GetCellRange(const RECT& rect);
+    static INT64 GetCellKey(int x, int y);
+    static bool IsAbove(const Entry& a, const Entry& b);
+
+    void Insert(int id, Entry& entry);
+    void Erase(int id, const Entry& entry);
+    int QueryPointWithoutLock(POINT point) const;
+
+    mutable std::mutex mutex_;
+    std::unordered_map<int, Entry> entries_;
+    std::unordered_map<INT64, std::vector<int>> cells_;
+    std::vector<int> oversizedIds_; // too large to register to every cell
+};
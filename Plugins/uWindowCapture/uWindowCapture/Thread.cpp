@@ -1,90 +1,242 @@
-#pragma once
-
-#include "Thread.h"
-#include "Debug.h"
-#include "Util.h"
-
-
-
-class ScopedThreadSleeper : public ScopedTimer
-{
-public:
-    template <class T>
-    explicit ScopedThreadSleeper(const T& duration) : 
-        ScopedTimer([duration] (microseconds us)
-        {
-            const auto waitTime = duration - us;
-            if (waitTime > microseconds::zero())
-            {
-                std::this_thread::sleep_for(waitTime);
-            }
-        }) 
-    {}
-};
-
-
-ThreadLoop::ThreadLoop()
-{
-}
-
-
-ThreadLoop::~ThreadLoop()
-{
-    Stop();
-}
-
-
-void ThreadLoop::Start(const ThreadFunc& func, const microseconds& interval)
-{
-    if (isRunning_) return;
-
-    func_ = func;
-    interval_ = interval;
-    isRunning_ = true;
-
-    if (thread_.joinable())
-    {
-        Debug::Error(__FUNCTION__, " => Thread is running");
-        thread_.join();
-    }
-
-    thread_ = std::thread([this] 
-    {
-        while (isRunning_)
-        {
-            ScopedThreadSleeper sleeper(interval_);
-            func_();
-        }
-    });
-}
-
-
-void ThreadLoop::Restart()
-{
-    Start(func_, interval_);
-}
-
-
-void ThreadLoop::Stop()
-{
-    if (!isRunning_) return;
-
-    isRunning_ = false;
-
-    if (thread_.joinable())
-    {
-        thread_.join();
-    }
-}
-
-
-bool ThreadLoop::IsRunning() const
-{
-    return isRunning_;
-}
-
-
-bool ThreadLoop::HasFunction() const
-{
-    return func_ != nullptr;
-}
\ No newline at end of file
+#pragma once
+
+#include "Thread.h"
+#include "Debug.h"
+#include "Util.h"
+
+
+
+namespace
+{
+    class WaitableTimer
+    {
+    public:
+        WaitableTimer()
+            : handle_(::CreateWaitableTimerExW(nullptr, nullptr, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS))
+        {
+        }
+
+        ~WaitableTimer()
+        {
+            if (handle_) ::CloseHandle(handle_);
+        }
+
+        bool Wait(std::chrono::microseconds duration)
+        {
+            if (!handle_) return false;
+
+            LARGE_INTEGER dueTime;
+            dueTime.QuadPart = -static_cast<LONGLONG>(duration.count() * 10); // relative, 100 [ns]
+            if (!::SetWaitableTimer(handle_, &dueTime, 0, nullptr, nullptr, FALSE)) return false;
+
+            return ::WaitForSingleObject(handle_, INFINITE) == WAIT_OBJECT_0;
+        }
+
+    private:
+        const HANDLE handle_;
+    };
+}
+
+
+// ---
+
+
+void SleepUntil(const std::chrono::steady_clock::time_point& time)
+{
+    // not supported before Windows 10 1803, so fall back to sleep_until() there.
+    thread_local WaitableTimer timer;
+
+    const auto duration = std::chrono::duration_cast<std::chrono::microseconds>(
+        time - std::chrono::steady_clock::now());
+    if (duration <= std::chrono::microseconds::zero()) return;
+
+    if (!timer.Wait(duration))
+    {
+        std::this_thread::sleep_until(time);
+    }
+}
+
+
+ThreadLoop::ThreadLoop()
+{
+}
+
+
+ThreadLoop::~ThreadLoop()
+{
+    Stop();
+}
+
+
+void ThreadLoop::Start(const ThreadFunc& func, const microseconds& interval)
+{
+    if (isRunning_) return;
+
+    func_ = func;
+    interval_ = interval;
+    isRunning_ = true;
+
+    if (thread_.joinable())
+    {
+        Debug::Error(__FUNCTION__, " => Thread is running");
+        thread_.join();
+    }
+
+    thread_ = std::thread([this] 
+    {
+        // deadlines are absolute so that the sleep errors do not accumulate.
+        auto deadline = std::chrono::steady_clock::now();
+        while (isRunning_)
+        {
+            func_();
+
+            deadline += interval_;
+            const auto now = std::chrono::steady_clock::now();
+            if (deadline < now)
+            {
+                // do not run in a burst to catch up after a stall.
+                deadline = now;
+            }
+            SleepUntil(deadline);
+        }
+    });
+}
+
+
+void ThreadLoop::Restart()
+{
+    Start(func_, interval_);
+}
+
+
+void ThreadLoop::Stop()
+{
+    if (!isRunning_) return;
+
+    isRunning_ = false;
+
+    if (thread_.joinable())
+    {
+        thread_.join();
+    }
+}
+
+
+void ThreadLoop::SetPriority(int priority)
+{
+    if (!thread_.joinable()) return;
+
+    if (!::SetThreadPriority(thread_.native_handle(), priority))
+    {
+        OutputApiError(__FUNCTION__, "SetThreadPriority");
+    }
+}
+
+
+bool ThreadLoop::IsRunning() const
+{
+    return isRunning_;
+}
+
+
+bool ThreadLoop::HasFunction() const
+{
+    return func_ != nullptr;
+}
+
+
+WorkerPool::WorkerPool(unsigned int workerCount)
+{
+    for (unsigned int i = 0; i < workerCount; ++i)
+    {
+        threads_.emplace_back([this] { Work(); });
+    }
+}
+
+
+WorkerPool::~WorkerPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        isRunning_ = false;
+        tasks_.clear();
+    }
+    taskCv_.notify_all();
+
+    for (auto& thread : threads_)
+    {
+        if (thread.joinable())
+        {
+            thread.join();
+        }
+    }
+}
+
+
+void WorkerPool::Push(Task&& task)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        tasks_.push_back(std::move(task));
+    }
+    taskCv_.notify_one();
+}
+
+
+bool WorkerPool::Run(const std::vector<Task>& tasks, microseconds timeout)
+{
+    if (tasks.empty()) return true;
+
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    // the tasks may outlive this call, so they own their copies and the counter.
+    const auto taskCount = tasks.size();
+    const auto doneTaskCount = std::make_shared<size_t>(0);
+    for (const auto& task : tasks)
+    {
+        // Work() runs the tasks without the lock, so the counter is updated under it here.
+        tasks_.push_back([this, task, doneTaskCount, taskCount]
+        {
+            task();
+
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (++(*doneTaskCount) == taskCount)
+            {
+                doneCv_.notify_all();
+            }
+        });
+    }
+
+    // all the workers are released at once so that the tasks start as close together as possible.
+    taskCv_.notify_all();
+    return doneCv_.wait_for(lock, timeout, [&] { return *doneTaskCount == taskCount; });
+}
+
+
+size_t WorkerPool::GetCount() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return tasks_.size();
+}
+
+
+void WorkerPool::Work()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    while (isRunning_)
+    {
+        if (tasks_.empty())
+        {
+            taskCv_.wait(lock);
+            continue;
+        }
+
+        auto task = std::move(tasks_.front());
+        tasks_.pop_front();
+
+        lock.unlock();
+        task();
+        lock.lock();
+    }
+}
@@ -1,30 +1,68 @@
-#pragma once
-
-#include <functional>
-#include <chrono>
-#include <thread>
-#include <atomic>
-
-
-class ThreadLoop
-{
-public:
-    using ThreadFunc = std::function<void()>;
-    using microseconds = std::chrono::microseconds;
-
-    ThreadLoop();
-    ~ThreadLoop();
-    void Start(
-        const ThreadFunc& func,
-        const microseconds& interval = microseconds(1'000'000 / 60));
-    void Restart();
-    void Stop();
-    bool IsRunning() const;
-    bool HasFunction() const;
-
-private:
-    std::thread thread_;
-    std::atomic<bool> isRunning_ = false;
-    microseconds interval_ = microseconds::zero();
-    ThreadFunc func_ = nullptr;
-};
+#pragma once
+
+#include <functional>
+#include <chrono>
+#include <thread>
+#include <atomic>
+#include <vector>
+#include <deque>
+#include <mutex>
+#include <condition_variable>
+
+
+// Sleeps until the given time with a high resolution waitable timer when available,
+// since sleep_for() is rounded up to the scheduler quantum on Windows.
+void SleepUntil(const std::chrono::steady_clock::time_point& time);
+
+
+class ThreadLoop
+{
+public:
+    using ThreadFunc = std::function<void()>;
+    using microseconds = std::chrono::microseconds;
+
+    ThreadLoop();
+    ~ThreadLoop();
+    void Start(
+        const ThreadFunc& func,
+        const microseconds& interval = microseconds(1'000'000 / 60));
+    void Restart();
+    void Stop();
+    void SetPriority(int priority);
+    bool IsRunning() const;
+    bool HasFunction() const;
+
+private:
+    std::thread thread_;
+    std::atomic<bool> isRunning_ = false;
+    microseconds interval_ = microseconds::zero();
+    ThreadFunc func_ = nullptr;
+};
+
+
+// Runs tasks on persistent worker threads, either asynchronously in the order they are pushed,
+// or as a batch started at once and waited for.
+class WorkerPool
+{
+public:
+    using Task = std::function<void()>;
+    using microseconds = std::chrono::microseconds;
+
+    explicit WorkerPool(unsigned int workerCount);
+    ~WorkerPool();
+    void Push(Task&& task);
+
+    // returns false if the timeout has passed first; the remaining tasks still run later.
+    bool Run(const std::vector<Task>& tasks, microseconds timeout);
+    size_t GetCount() const;
+
+private:
+    void Work();
+
+    std::vector<std::thread> threads_;
+    mutable std::mutex mutex_;
+    std::condition_variable taskCv_;
+    std::condition_variable doneCv_;
+    std::deque<Task> tasks_;
+    bool isRunning_ = true;
+};
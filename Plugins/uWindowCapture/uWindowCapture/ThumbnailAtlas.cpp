@@ -0,0 +1,432 @@
+#include <algorithm>
+#include "ThumbnailAtlas.h"
+#include "WindowTexture.h"
+
+
+
+namespace
+{
+    constexpr UINT kDefaultPageSize = 2048;
+    constexpr UINT kDefaultThumbnailSize = 256;
+    constexpr UINT kDefaultMaxPageCount = 4;
+    constexpr size_t kMaxDirtyRectsPerSlot = 32;
+}
+
+
+// ---
+
+
+ThumbnailAtlas::ThumbnailAtlas()
+{
+    SetSettings(kDefaultPageSize, kDefaultThumbnailSize, kDefaultMaxPageCount);
+}
+
+
+void ThumbnailAtlas::SetSettings(UINT pageSize, UINT thumbnailSize, UINT maxPageCount)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    packer_ = std::make_unique<ShelfPacker>(pageSize, pageSize, maxPageCount);
+    thumbnailSize_ = min(thumbnailSize, pageSize);
+
+    // the pages are created again with the new size.
+    pages_.clear();
+    for (auto& pair : entries_)
+    {
+        pair.second.isPlaced = false;
+    }
+    version_++;
+}
+
+
+UINT ThumbnailAtlas::GetPageSize() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return packer_->GetPageWidth();
+}
+
+
+UINT ThumbnailAtlas::GetPageCount() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return static_cast<UINT>(pages_.size());
+}
+
+
+void ThumbnailAtlas::SetPageTexture(UINT page, ID3D11Texture2D* ptr)
+{
+    if (auto p = GetPage(page))
+    {
+        p->unityTexture = ptr;
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        p->isDirty = true;
+    }
+}
+
+
+UINT64 ThumbnailAtlas::GetVersion() const
+{
+    return version_;
+}
+
+
+std::shared_ptr<ThumbnailAtlas::Page> ThumbnailAtlas::GetPage(UINT page) const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return (page < pages_.size()) ? pages_[page] : nullptr;
+}
+
+
+void ThumbnailAtlas::AddWindow(int id)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    // placed when the first frame tells the size.
+    entries_.emplace(id, Entry());
+}
+
+
+void ThumbnailAtlas::RemoveWindow(int id)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    const auto it = entries_.find(id);
+    if (it == entries_.end()) return;
+
+    if (const auto rect = packer_->Find(id))
+    {
+        if (rect->page < pages_.size())
+        {
+            pages_[rect->page]->clearRects.push_back(*rect);
+            pages_[rect->page]->isDirty = true;
+        }
+        packer_->Remove(id);
+    }
+
+    entries_.erase(it);
+    version_++;
+}
+
+
+bool ThumbnailAtlas::Contains(int id) const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return entries_.find(id) != entries_.end();
+}
+
+
+bool ThumbnailAtlas::GetRect(int id, AtlasRect* rect) const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    const auto it = entries_.find(id);
+    if (it == entries_.end() || !it->second.isPlaced) return false;
+
+    const auto packed = packer_->Find(id);
+    if (!packed) return false;
+
+    const float size = static_cast<float>(packer_->GetPageWidth());
+    rect->page = static_cast<int>(packed->page);
+    rect->x = packed->x;
+    rect->y = packed->y;
+    rect->width = packed->width;
+    rect->height = packed->height;
+    rect->uvX = packed->x / size;
+    rect->uvY = packed->y / size;
+    rect->uvWidth = packed->width / size;
+    rect->uvHeight = packed->height / size;
+    return true;
+}
+
+
+void ThumbnailAtlas::GetThumbnailSize(UINT width, UINT height, UINT* thumbnailWidth, UINT* thumbnailHeight) const
+{
+    // fit into the thumbnail size keeping the aspect ratio, but never upscale.
+    const UINT longer = max(width, height);
+    if (longer <= thumbnailSize_)
+    {
+        *thumbnailWidth = width;
+        *thumbnailHeight = height;
+        return;
+    }
+
+    *thumbnailWidth = max(1u, width * thumbnailSize_ / longer);
+    *thumbnailHeight = max(1u, height * thumbnailSize_ / longer);
+}
+
+
+void ThumbnailAtlas::Place(int id, Entry& entry)
+{
+    if (const auto rect = packer_->Find(id))
+    {
+        if (rect->page < pages_.size())
+        {
+            pages_[rect->page]->clearRects.push_back(*rect);
+            pages_[rect->page]->isDirty = true;
+        }
+    }
+
+    bool hasRepacked = false;
+    entry.isPlaced = packer_->Add(id, entry.width, entry.height, &hasRepacked);
+    if (!entry.isPlaced)
+    {
+        packer_->Remove(id);
+    }
+
+    while (pages_.size() < packer_->GetPageCount())
+    {
+        auto page = std::make_shared<Page>();
+        const UINT size = packer_->GetPageWidth();
+        page->pixels.resize(size * size * 4);
+        page->isDirty = true;
+        pages_.push_back(page);
+    }
+
+    // every rect may have moved.
+    if (hasRepacked)
+    {
+        MarkAllDirty();
+    }
+
+    version_++;
+}
+
+
+void ThumbnailAtlas::MarkAllDirty()
+{
+    for (auto& page : pages_)
+    {
+        const UINT size = packer_->GetPageWidth();
+        page->clearRects.clear();
+        page->clearRects.push_back({ 0, 0, 0, size, size });
+        page->isDirty = true;
+    }
+
+    for (auto& pair : entries_)
+    {
+        pair.second.isPixelsDirty = true;
+    }
+}
+
+
+bool ThumbnailAtlas::UpdateThumbnail(int id, const WindowTexture& texture)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    const auto it = entries_.find(id);
+    if (it == entries_.end()) return false;
+
+    auto& entry = it->second;
+
+    UINT width, height;
+    GetThumbnailSize(texture.GetWidth(), texture.GetHeight(), &width, &height);
+    if (width == 0 || height == 0) return false;
+
+    if (!entry.isPlaced || width != entry.width || height != entry.height)
+    {
+        entry.width = width;
+        entry.height = height;
+        entry.pixels.resize(width * height * 4);
+        Place(id, entry);
+    }
+
+    if (!entry.isPlaced) return false;
+
+    if (!texture.Downscale(entry.pixels.data(), width, height)) return false;
+
+    entry.isPixelsDirty = true;
+    if (const auto rect = packer_->Find(id))
+    {
+        pages_[rect->page]->isDirty = true;
+    }
+
+    return true;
+}
+
+
+void ThumbnailAtlas::AddDirtyRect(Page& page, const PackedRect& rect) const
+{
+    const UINT size = packer_->GetPageWidth();
+    const PackedRect wholePage { 0, 0, 0, size, size };
+
+    for (auto& rects : page.slotDirtyRects)
+    {
+        const auto isSame = [&](const PackedRect& r)
+        {
+            return r.x == rect.x && r.y == rect.y && r.width == rect.width && r.height == rect.height;
+        };
+        const auto isWholePage = [&](const PackedRect& r)
+        {
+            return r.width == size && r.height == size;
+        };
+
+        if (std::any_of(rects.begin(), rects.end(), isSame) || std::any_of(rects.begin(), rects.end(), isWholePage)) continue;
+
+        // too many small updates cost more than a single upload of the whole page.
+        if (rects.size() >= kMaxDirtyRectsPerSlot || isWholePage(rect))
+        {
+            rects.assign(1, wholePage);
+        }
+        else
+        {
+            rects.push_back(rect);
+        }
+    }
+}
+
+
+void ThumbnailAtlas::Upload(IGraphicsBackend* backend, const UploadedFunc& onUploaded)
+{
+    if (!backend) return;
+
+    std::vector<std::shared_ptr<Page>> dirtyPages;
+    UINT size = 0;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        size = packer_->GetPageWidth();
+
+        for (auto& page : pages_)
+        {
+            if (!page->isDirty || !page->unityTexture.load()) continue;
+            page->isDirty = false;
+
+            for (const auto& rect : page->clearRects)
+            {
+                for (UINT y = rect.y; y < rect.y + rect.height; ++y)
+                {
+                    memset(&page->pixels[(rect.x + y * size) * 4], 0, rect.width * 4);
+                }
+                AddDirtyRect(*page, rect);
+            }
+            page->clearRects.clear();
+
+            dirtyPages.push_back(page);
+        }
+
+        for (auto& pair : entries_)
+        {
+            auto& entry = pair.second;
+            if (!entry.isPlaced || !entry.isPixelsDirty) continue;
+
+            const auto rect = packer_->Find(pair.first);
+            if (!rect) continue;
+
+            auto& page = pages_[rect->page];
+            if (std::find(dirtyPages.begin(), dirtyPages.end(), page) == dirtyPages.end()) continue;
+
+            for (UINT y = 0; y < rect->height; ++y)
+            {
+                memcpy(&page->pixels[(rect->x + (rect->y + y) * size) * 4], &entry.pixels[y * rect->width * 4], rect->width * 4);
+            }
+            AddDirtyRect(*page, *rect);
+            entry.isPixelsDirty = false;
+        }
+    }
+
+    // the page pixels are written only by this thread, so the upload does not hold the lock.
+    // each slot gets only the rects changed since it was written last.
+    for (size_t i = 0; i < dirtyPages.size(); ++i)
+    {
+        auto& page = dirtyPages[i];
+
+        const int slot = page->ring.BeginWrite();
+        if (slot < 0)
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            page->isDirty = true;
+            continue;
+        }
+
+        auto& rects = page->slotDirtyRects[slot];
+        auto& sharedTexture = page->ring.GetTexture(slot);
+        if (!sharedTexture || sharedTexture->GetWidth() != size || sharedTexture->GetHeight() != size)
+        {
+            sharedTexture = backend->CreateSharedTexture(page->unityTexture.load());
+            rects.assign(1, { 0, 0, 0, size, size });
+        }
+
+        bool hasWritten = (sharedTexture != nullptr);
+        UINT64 uploadedBytes = 0;
+        for (const auto& rect : rects)
+        {
+            if (!hasWritten) break;
+
+            RECT region;
+            region.left = static_cast<LONG>(rect.x);
+            region.top = static_cast<LONG>(rect.y);
+            region.right = static_cast<LONG>(rect.x + rect.width);
+            region.bottom = static_cast<LONG>(rect.y + rect.height);
+            hasWritten = backend->UpdateSharedTextureRegion(sharedTexture.get(), region, &page->pixels[(rect.x + rect.y * size) * 4], size * 4);
+            uploadedBytes += static_cast<UINT64>(rect.width) * rect.height * 4;
+        }
+        page->ring.EndWrite(slot, backend, hasWritten);
+
+        if (!hasWritten) continue;
+
+        rects.clear();
+        hasPendingUploads_ = true;
+
+        // the pages over the budget of the trigger are uploaded at the next one.
+        if (uploadedBytes > 0 && !onUploaded(uploadedBytes))
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            for (size_t j = i + 1; j < dirtyPages.size(); ++j)
+            {
+                dirtyPages[j]->isDirty = true;
+            }
+            break;
+        }
+    }
+
+    PollUploads();
+}
+
+
+void ThumbnailAtlas::PollUploads()
+{
+    if (!hasPendingUploads_) return;
+
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    bool hasPendingUploads = false;
+    for (auto& page : pages_)
+    {
+        page->ring.PollWrites();
+        hasPendingUploads |= page->ring.HasPendingWrites();
+    }
+    hasPendingUploads_ = hasPendingUploads;
+}
+
+
+UINT ThumbnailAtlas::Render(IGraphicsBackend* backend)
+{
+    std::vector<std::shared_ptr<Page>> pages;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        pages = pages_;
+    }
+
+    UINT copyCount = 0;
+    for (auto& page : pages)
+    {
+        const auto unityTexture = page->unityTexture.load();
+        if (!unityTexture) continue;
+
+        const int slot = page->ring.BeginRead();
+        if (slot < 0) continue;
+
+        const auto& sharedTexture = page->ring.GetTexture(slot);
+        SharedTextureDesc desc;
+        const bool hasRead =
+            backend->GetUnityTextureDesc(unityTexture, &desc) &&
+            sharedTexture->GetDesc() == desc &&
+            backend->CopyToUnityTexture(sharedTexture.get(), unityTexture);
+        page->ring.EndRead(slot, backend, hasRead);
+
+        if (hasRead) copyCount++;
+    }
+
+    return copyCount;
+}
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <Windows.h>
+#include <vector>
+#include <unordered_map>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <functional>
+
+#include "GraphicsBackend.h"
+#include "ShelfPacker.h"
+#include "UploadRing.h"
+
+
+class WindowTexture;
+
+
+struct AtlasRect
+{
+    int page;
+    UINT x; // [px]
+    UINT y; // [px]
+    UINT width; // [px]
+    UINT height; // [px]
+    float uvX;
+    float uvY;
+    float uvWidth;
+    float uvHeight;
+};
+
+
+// Packs downscaled frames of many windows into a few large textures, so that the thumbnails
+// cost one upload and one copy per page instead of per window. Unity creates the page textures,
+// and the layout version is bumped whenever a rect moves so that the UV rects can be fetched again.
+class ThumbnailAtlas
+{
+public:
+    ThumbnailAtlas();
+
+    void SetSettings(UINT pageSize, UINT thumbnailSize, UINT maxPageCount);
+    UINT GetPageSize() const;
+    UINT GetPageCount() const;
+    void SetPageTexture(UINT page, ID3D11Texture2D* ptr);
+    UINT64 GetVersion() const;
+
+    void AddWindow(int id);
+    void RemoveWindow(int id);
+    bool Contains(int id) const;
+    bool GetRect(int id, AtlasRect* rect) const;
+
+    // upload thread
+    bool UpdateThumbnail(int id, const WindowTexture& texture);
+    using UploadedFunc = std::function<bool(UINT64 uploadedBytes)>; // returns false to leave the rest for the next trigger
+    void Upload(IGraphicsBackend* backend, const UploadedFunc& onUploaded);
+    void PollUploads();
+
+    // render thread
+    UINT Render(IGraphicsBackend* backend);
+
+private:
+    struct Entry
+    {
+        bool isPlaced = false;
+        bool isPixelsDirty = false;
+        UINT width = 0;
+        UINT height = 0;
+        std::vector<BYTE> pixels;
+    };
+
+    struct Page
+    {
+        std::vector<BYTE> pixels; // touched only by the upload thread
+        std::vector<PackedRect> clearRects;
+        std::vector<PackedRect> slotDirtyRects[UploadRing::kSlotCount]; // changed since each slot was written, touched only by the upload thread
+        bool isDirty = false;
+        std::atomic<ID3D11Texture2D*> unityTexture = nullptr;
+        UploadRing ring;
+    };
+
+    void GetThumbnailSize(UINT width, UINT height, UINT* thumbnailWidth, UINT* thumbnailHeight) const;
+    void Place(int id, Entry& entry);
+    void MarkAllDirty();
+    void AddDirtyRect(Page& page, const PackedRect& rect) const;
+    std::shared_ptr<Page> GetPage(UINT page) const;
+
+    mutable std::mutex mutex_;
+    std::unique_ptr<ShelfPacker> packer_;
+    std::unordered_map<int, Entry> entries_;
+    std::vector<std::shared_ptr<Page>> pages_; // never shrinks, Unity owns the textures
+    UINT thumbnailSize_;
+    std::atomic<UINT64> version_ = 0;
+    std::atomic<bool> hasPendingUploads_ = false;
+};
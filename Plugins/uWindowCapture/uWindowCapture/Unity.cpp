@@ -1,22 +1,25 @@
-#pragma once
-
-#include <d3d11.h>
-
-#include "IUnityInterface.h"
-#include "IUnityGraphicsD3D11.h"
-
-
-
-extern IUnityInterfaces* g_unity;
-
-
-IUnityInterfaces* GetUnity()
-{
-    return g_unity;
-}
-
-
-ID3D11Device* GetUnityDevice()
-{
-    return GetUnity()->Get<IUnityGraphicsD3D11>()->GetDevice();
+#pragma once
+
+#include <d3d11.h>
+
+#include "IUnityInterface.h"
+#include "IUnityGraphicsD3D11.h"
+
+
+
+extern IUnityInterfaces* g_unity;
+
+
+IUnityInterfaces* GetUnity()
+{
+    return g_unity;
+}
+
+
+ID3D11Device* GetUnityDevice()
+{
+    if (!GetUnity()) return nullptr;
+
+    const auto d3d11 = GetUnity()->Get<IUnityGraphicsD3D11>();
+    return d3d11 ? d3d11->GetDevice() : nullptr;
 }
\ No newline at end of file
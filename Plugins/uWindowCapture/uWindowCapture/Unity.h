@@ -1,4 +1,4 @@
-#pragma once
-
-struct IUnityInterfaces* GetUnity();
+#pragma once
+
+struct IUnityInterfaces* GetUnity();
 struct ID3D11Device* GetUnityDevice();
\ No newline at end of file
@@ -1,176 +1,390 @@
-#pragma once
-
-#include <d3d11.h>
-
-#include "IUnityInterface.h"
-#include "IUnityGraphicsD3D11.h"
-#include "UploadManager.h"
-#include "WindowManager.h"
-#include "Debug.h"
-#include "Util.h"
-#include "Window.h"
-#include "Unity.h"
-#include "Cursor.h"
-
-#pragma comment(lib, "d3d11.lib")
-
-using namespace Microsoft::WRL;
-using DevicePtr = Microsoft::WRL::ComPtr<ID3D11Device>;
-using TexturePtr = Microsoft::WRL::ComPtr<ID3D11Texture2D>;
-
-
-
-UploadManager::UploadManager()
-{
-    initThread_ = std::thread([this]
-    {
-        CreateDevice();
-        StartUploadThread();
-    });
-}
-
-
-UploadManager::~UploadManager()
-{
-    if (initThread_.joinable())
-    {
-        initThread_.join();
-    }
-
-    StopUploadThread();
-}
-
-
-void UploadManager::CreateDevice()
-{
-    ComPtr<IDXGIDevice1> dxgiDevice;
-    if (FAILED(GetUnityDevice()->QueryInterface(IID_PPV_ARGS(&dxgiDevice)))) {
-        Debug::Error(__FUNCTION__, " => QueryInterface from IUnityGraphicsD3D11 to IDXGIDevice1 failed.");
-        return;
-    }
-
-    ComPtr<IDXGIAdapter> dxgiAdapter;
-    if (FAILED(dxgiDevice->GetAdapter(&dxgiAdapter))) {
-        Debug::Error(__FUNCTION__, " => QueryInterface from IDXGIDevice1 to IDXGIAdapter failed.");
-        return;
-    }
-
-    const auto driverType = D3D_DRIVER_TYPE_UNKNOWN;
-    const auto flags = D3D11_CREATE_DEVICE_BGRA_SUPPORT;
-    const D3D_FEATURE_LEVEL featureLevelsRequested[] =
-    {
-        D3D_FEATURE_LEVEL_11_0,
-        D3D_FEATURE_LEVEL_10_1,
-        D3D_FEATURE_LEVEL_10_0,
-        D3D_FEATURE_LEVEL_9_3,
-        D3D_FEATURE_LEVEL_9_2,
-        D3D_FEATURE_LEVEL_9_1
-    };
-    const UINT numLevelsRequested = sizeof(featureLevelsRequested) / sizeof(D3D_FEATURE_LEVEL);
-    D3D_FEATURE_LEVEL featureLevelsSupported;
-
-    D3D11CreateDevice(
-        dxgiAdapter.Get(),
-        driverType,
-        nullptr,
-        flags,
-        featureLevelsRequested,
-        numLevelsRequested,
-        D3D11_SDK_VERSION,
-        &device_,
-        &featureLevelsSupported,
-        nullptr);
-}
-
-
-DevicePtr UploadManager::GetDevice()
-{ 
-    return device_;
-}
-
-
-TexturePtr UploadManager::CreateCompatibleSharedTexture(const TexturePtr& texture)
-{
-    if (!device_)
-    {
-        Debug::Error(__FUNCTION__, "device has not been created yet.");
-        return nullptr;
-    }
-
-    TexturePtr sharedTexture;
-
-    D3D11_TEXTURE2D_DESC srcDesc;
-    texture->GetDesc(&srcDesc);
-
-    D3D11_TEXTURE2D_DESC desc = srcDesc;
-    desc.MiscFlags = D3D11_RESOURCE_MISC_SHARED;
-
-    if (FAILED(device_->CreateTexture2D(&desc, nullptr, &sharedTexture)))
-    {
-        Debug::Error(__FUNCTION__, " => GetDevice()->CreateTexture2D() failed.");
-        return nullptr;
-    }
-
-    return sharedTexture;
-}
-
-
-void UploadManager::StartUploadThread()
-{
-    threadLoop_.Start([this] 
-    { 
-        // Waiting for being triggered...
-        if (!hasUploadTriggered_) return;
-        hasUploadTriggered_ = false;
-
-        // Check window upload
-        const int windowId = windowUploadQueue_.Dequeue();
-        if (windowId >= 0 && WindowManager::Get().CheckExistence(windowId))
-        {
-            if (auto window = WindowManager::Get().GetWindow(windowId))
-            {
-                window->Upload();
-            }
-        }
-
-        // Check icon upload
-        const int iconId = iconUploadQueue_.Dequeue();
-        if (iconId >= 0 && WindowManager::Get().CheckExistence(iconId))
-        {
-            if (auto window = WindowManager::Get().GetWindow(iconId))
-            {
-                window->UploadIcon();
-            }
-        }
-
-        // Check cursor upload
-        if (auto& cursor = WindowManager::Get().GetCursor())
-        {
-            cursor->Upload();
-        }
-    }, std::chrono::microseconds(10) /* check uploading every 10 us */);
-}
-
-
-void UploadManager::StopUploadThread()
-{
-    threadLoop_.Stop();
-}
-
-
-void UploadManager::RequestUploadWindow(int id)
-{
-    windowUploadQueue_.Enqueue(id);
-}
-
-
-void UploadManager::RequestUploadIcon(int id)
-{
-    iconUploadQueue_.Enqueue(id);
-}
-
-
-void UploadManager::TriggerGpuUpload()
-{
-    hasUploadTriggered_ = true;
+#pragma once
+
+#include <algorithm>
+#include "UploadManager.h"
+#include "WindowManager.h"
+#include "Debug.h"
+#include "Util.h"
+#include "Window.h"
+#include "Cursor.h"
+
+
+
+namespace
+{
+    constexpr UINT kDefaultTimeBudget = 4000; // [us]
+    constexpr UINT64 kDefaultByteBudget = 0; // unlimited
+}
+
+
+// ---
+
+
+UploadManager::UploadManager()
+    : timeBudget_(kDefaultTimeBudget)
+    , byteBudget_(kDefaultByteBudget)
+{
+    initThread_ = std::thread([this]
+    {
+        backend_ = CreateGraphicsBackend();
+        backendPtr_ = backend_.get();
+        StartUploadThread();
+    });
+}
+
+
+UploadManager::~UploadManager()
+{
+    if (initThread_.joinable())
+    {
+        initThread_.join();
+    }
+
+    StopUploadThread();
+    backendPtr_ = nullptr;
+}
+
+
+IGraphicsBackend* UploadManager::GetBackend() const
+{
+    return backendPtr_;
+}
+
+
+std::shared_ptr<ISharedTexture> UploadManager::AcquireSharedTexture(ID3D11Texture2D* unityTexture)
+{
+    return sharedTexturePool_.Acquire(GetBackend(), unityTexture);
+}
+
+
+void UploadManager::ReleaseSharedTexture(std::shared_ptr<ISharedTexture>&& texture)
+{
+    sharedTexturePool_.Release(std::move(texture));
+}
+
+
+void UploadManager::StartUploadThread()
+{
+    threadLoop_.Start([this] 
+    { 
+        PollPendingUploads();
+
+        // Waiting for being triggered...
+        if (!hasUploadTriggered_) return;
+        hasUploadTriggered_ = false;
+
+        UploadTriggered();
+    }, std::chrono::microseconds(10) /* check uploading every 10 us */);
+}
+
+
+void UploadManager::UploadTriggered()
+{
+    Trigger trigger;
+    trigger.startTime = std::chrono::steady_clock::now();
+
+    UploadWindowBatches(trigger);
+    UploadPendingWindows(trigger);
+    UploadPendingIcons(trigger);
+
+    if (auto& atlas = WindowManager::GetThumbnailAtlas())
+    {
+        if (!IsOverBudget(trigger))
+        {
+            atlas->Upload(GetBackend(), [&](UINT64 bytes)
+            {
+                trigger.uploadCount++;
+                trigger.uploadedBytes += bytes;
+                return !IsOverBudget(trigger);
+            });
+        }
+    }
+
+    if (auto& cursor = WindowManager::Get().GetCursor())
+    {
+        if (cursor->Upload())
+        {
+            trigger.uploadCount++;
+            trigger.uploadedBytes += cursor->GetWidth() * cursor->GetHeight() * 4;
+        }
+    }
+
+    // all the updates of this trigger are submitted at once.
+    if (trigger.uploadCount > 0)
+    {
+        if (auto backend = GetBackend())
+        {
+            backend->Flush();
+        }
+    }
+
+    const auto time = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - trigger.startTime);
+    AddTriggerStats(trigger, time);
+}
+
+
+void UploadManager::PollPendingUploads()
+{
+    if (auto& atlas = WindowManager::GetThumbnailAtlas())
+    {
+        atlas->PollUploads();
+    }
+
+    if (pendingUploadIds_.empty()) return;
+
+    auto it = std::remove_if(pendingUploadIds_.begin(), pendingUploadIds_.end(), [](int id)
+    {
+        auto window = WindowManager::Get().GetWindow(id);
+        return !window || window->PollUpload();
+    });
+    pendingUploadIds_.erase(it, pendingUploadIds_.end());
+}
+
+
+void UploadManager::AddPendingUpload(int id)
+{
+    if (std::find(pendingUploadIds_.begin(), pendingUploadIds_.end(), id) == pendingUploadIds_.end())
+    {
+        pendingUploadIds_.push_back(id);
+    }
+}
+
+
+bool UploadManager::IsOverBudget(Trigger& trigger) const
+{
+    // the budget is checked before each upload, so the last one may go over it a little.
+    const UINT64 byteBudget = byteBudget_;
+    if (byteBudget > 0 && trigger.uploadedBytes >= byteBudget)
+    {
+        trigger.isBudgetExceeded = true;
+        return true;
+    }
+
+    const UINT timeBudget = timeBudget_;
+    if (timeBudget > 0 && std::chrono::steady_clock::now() - trigger.startTime > std::chrono::microseconds(timeBudget))
+    {
+        trigger.isBudgetExceeded = true;
+        return true;
+    }
+
+    return false;
+}
+
+
+UINT64 UploadManager::UploadWindow(int id)
+{
+    auto window = WindowManager::Get().GetWindow(id);
+    if (!window)
+    {
+        metrics_.AddDropped();
+        return 0;
+    }
+
+    ScopedTimer timer([this](std::chrono::microseconds us) 
+    { 
+        metrics_.AddProcessed(us); 
+    });
+
+    if (!window->Upload())
+    {
+        metrics_.AddDropped();
+        return 0;
+    }
+
+    return static_cast<UINT64>(window->GetTextureWidth()) * window->GetTextureHeight() * 4;
+}
+
+
+void UploadManager::UploadWindowBatches(Trigger& trigger)
+{
+    const UINT budget = metrics_.GetBudget();
+
+    // a batch is uploaded as a whole so that its members are rendered in the same frame,
+    // and the ones over the budget wait for the next trigger.
+    while (budget == 0 || trigger.windowCount < budget)
+    {
+        if (!WindowManager::Get().CanRequestRenderWindow() || IsOverBudget(trigger)) break;
+
+        std::vector<int> ids;
+        {
+            std::lock_guard<std::mutex> lock(windowUploadBatchesMutex_);
+            if (windowUploadBatches_.empty()) break;
+            ids = std::move(windowUploadBatches_.front());
+            windowUploadBatches_.pop_front();
+        }
+
+        for (const int id : ids)
+        {
+            trigger.windowCount++;
+
+            if (const UINT64 bytes = UploadWindow(id))
+            {
+                trigger.uploadCount++;
+                trigger.uploadedBytes += bytes;
+            }
+        }
+    }
+}
+
+
+void UploadManager::UploadPendingWindows(Trigger& trigger)
+{
+    const UINT budget = metrics_.GetBudget();
+    while (budget == 0 || trigger.windowCount < budget)
+    {
+        // stop here if the render stage cannot accept more frames (back-pressure).
+        if (!WindowManager::Get().CanRequestRenderWindow()) break;
+
+        if (windowUploadQueue_.Empty() || IsOverBudget(trigger)) break;
+
+        const int windowId = windowUploadQueue_.Dequeue();
+        if (windowId < 0) break;
+
+        trigger.windowCount++;
+
+        if (const UINT64 bytes = UploadWindow(windowId))
+        {
+            trigger.uploadCount++;
+            trigger.uploadedBytes += bytes;
+        }
+    }
+}
+
+
+void UploadManager::UploadPendingIcons(Trigger& trigger)
+{
+    for (;;)
+    {
+        if (iconUploadQueue_.Empty() || IsOverBudget(trigger)) break;
+
+        const int iconId = iconUploadQueue_.Dequeue();
+        if (iconId < 0) break;
+
+        auto window = WindowManager::Get().GetWindow(iconId);
+        if (window && window->UploadIcon())
+        {
+            trigger.uploadCount++;
+        }
+    }
+}
+
+
+void UploadManager::AddTriggerStats(const Trigger& trigger, std::chrono::microseconds time)
+{
+    std::lock_guard<std::mutex> lock(uploadStatsMutex_);
+
+    auto& stats = uploadStats_;
+    const float timeMs = time.count() / 1000.f;
+    const float n = static_cast<float>(++stats.triggerCount);
+
+    stats.uploadCount += trigger.uploadCount;
+    stats.uploadedBytes += trigger.uploadedBytes;
+    if (trigger.uploadCount > 0) stats.flushCount++;
+    if (trigger.isBudgetExceeded) stats.budgetExceededCount++;
+
+    stats.lastUploadsPerTrigger = trigger.uploadCount;
+    stats.maxUploadsPerTrigger = max(stats.maxUploadsPerTrigger, trigger.uploadCount);
+    stats.averageUploadsPerTrigger = stats.uploadCount / n;
+    stats.lastBytesPerTrigger = trigger.uploadedBytes;
+    stats.maxBytesPerTrigger = max(stats.maxBytesPerTrigger, trigger.uploadedBytes);
+    stats.averageBytesPerTrigger = stats.uploadedBytes / n;
+    stats.averageTriggerTime += (timeMs - stats.averageTriggerTime) / n;
+    stats.maxTriggerTime = max(stats.maxTriggerTime, timeMs);
+}
+
+
+void UploadManager::StopUploadThread()
+{
+    threadLoop_.Stop();
+}
+
+
+void UploadManager::RequestUploadWindow(int id)
+{
+    windowUploadQueue_.Enqueue(id);
+}
+
+
+void UploadManager::RequestUploadWindows(const std::vector<int>& ids)
+{
+    if (ids.empty()) return;
+
+    // the frames already waiting in the queue are uploaded with the batch instead.
+    for (const int id : ids)
+    {
+        windowUploadQueue_.Remove(id);
+    }
+
+    std::lock_guard<std::mutex> lock(windowUploadBatchesMutex_);
+
+    // a batch still waiting for the same windows uploads their latest buffers, so it covers this one.
+    if (std::find(windowUploadBatches_.begin(), windowUploadBatches_.end(), ids) != windowUploadBatches_.end()) return;
+
+    windowUploadBatches_.push_back(ids);
+}
+
+
+bool UploadManager::CanRequestUploadWindow() const
+{
+    return !(IsBackPressureEnabled() && windowUploadQueue_.Full());
+}
+
+
+bool UploadManager::IsBackPressureEnabled() const
+{
+    return windowUploadQueue_.GetPolicy() == QueuePolicy::DropNewest;
+}
+
+
+void UploadManager::RequestUploadIcon(int id)
+{
+    iconUploadQueue_.Enqueue(id);
+}
+
+
+void UploadManager::TriggerGpuUpload()
+{
+    hasUploadTriggered_ = true;
+}
+
+
+void UploadManager::SetBudget(UINT budget)
+{
+    metrics_.SetBudget(budget);
+}
+
+
+void UploadManager::SetQueue(UINT capacity, QueuePolicy policy)
+{
+    windowUploadQueue_.SetCapacity(capacity);
+    windowUploadQueue_.SetPolicy(policy);
+}
+
+
+void UploadManager::GetStats(PipelineStageStats* stats) const
+{
+    metrics_.GetStats(stats, windowUploadQueue_.GetStats(), windowUploadQueue_.GetCapacity());
+}
+
+
+void UploadManager::SetTriggerBudget(UINT timeBudget, UINT64 byteBudget)
+{
+    timeBudget_ = timeBudget;
+    byteBudget_ = byteBudget;
+}
+
+
+void UploadManager::GetUploadStats(UploadStats* stats) const
+{
+    {
+        std::lock_guard<std::mutex> lock(uploadStatsMutex_);
+        *stats = uploadStats_;
+    }
+
+    SharedTexturePoolStats poolStats;
+    sharedTexturePool_.GetStats(&poolStats);
+    stats->createdSharedTextureCount = poolStats.createdCount;
+    stats->reusedSharedTextureCount = poolStats.reusedCount;
+    stats->pooledSharedTextureCount = poolStats.pooledCount;
 }
\ No newline at end of file
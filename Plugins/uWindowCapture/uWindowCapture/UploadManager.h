@@ -1,40 +1,103 @@
 #pragma once
 
 #include <atomic>
-#include <d3d11.h>
-#include <wrl/client.h>
+#include <chrono>
+#include <deque>
+#include <vector>
+#include <mutex>
+#include <memory>
 
+#include "GraphicsBackend.h"
+#include "SharedTexturePool.h"
 #include "WindowQueue.h"
+#include "Pipeline.h"
 #include "Thread.h"
 
 
 class Window;
 
 
+// Unity triggers the upload once per frame, so the values per trigger are the ones per frame.
+struct UploadStats
+{
+    UINT64 triggerCount;
+    UINT64 uploadCount; // windows, icons and cursor
+    UINT64 uploadedBytes;
+    UINT64 flushCount;
+    UINT64 budgetExceededCount; // triggers which left pending windows for the next one
+    UINT lastUploadsPerTrigger;
+    UINT maxUploadsPerTrigger;
+    float averageUploadsPerTrigger;
+    UINT64 lastBytesPerTrigger;
+    UINT64 maxBytesPerTrigger;
+    float averageBytesPerTrigger;
+    float averageTriggerTime; // [ms]
+    float maxTriggerTime; // [ms]
+    UINT64 createdSharedTextureCount; // by the pool
+    UINT64 reusedSharedTextureCount; // from the pool
+    UINT pooledSharedTextureCount;
+};
+
+
 class UploadManager
 {
 public:
-    using DevicePtr = Microsoft::WRL::ComPtr<ID3D11Device>;
-    using TexturePtr = Microsoft::WRL::ComPtr<ID3D11Texture2D>;
-
     UploadManager();
     ~UploadManager();
 
-    DevicePtr GetDevice();
-    TexturePtr CreateCompatibleSharedTexture(const TexturePtr& texture);
+    IGraphicsBackend* GetBackend() const;
+    std::shared_ptr<ISharedTexture> AcquireSharedTexture(ID3D11Texture2D* unityTexture);
+    void ReleaseSharedTexture(std::shared_ptr<ISharedTexture>&& texture);
     void RequestUploadWindow(int id);
+    void RequestUploadWindows(const std::vector<int>& ids);
+    bool CanRequestUploadWindow() const;
+    bool IsBackPressureEnabled() const;
     void RequestUploadIcon(int id);
+    void AddPendingUpload(int id);
     void StartUploadThread();
     void StopUploadThread();
     void TriggerGpuUpload();
 
+    void SetBudget(UINT budget);
+    void SetQueue(UINT capacity, QueuePolicy policy);
+    void GetStats(PipelineStageStats* stats) const;
+    void SetTriggerBudget(UINT timeBudget, UINT64 byteBudget);
+    void GetUploadStats(UploadStats* stats) const;
+
 private:
-    void CreateDevice();
+    struct Trigger
+    {
+        std::chrono::steady_clock::time_point startTime;
+        UINT uploadCount = 0;
+        UINT windowCount = 0; // counted against the budget of the stage
+        UINT64 uploadedBytes = 0;
+        bool isBudgetExceeded = false;
+    };
 
-    DevicePtr device_;
+    void UploadTriggered();
+    void PollPendingUploads();
+    bool IsOverBudget(Trigger& trigger) const;
+    UINT64 UploadWindow(int id);
+    void UploadWindowBatches(Trigger& trigger);
+    void UploadPendingWindows(Trigger& trigger);
+    void UploadPendingIcons(Trigger& trigger);
+    void AddTriggerStats(const Trigger& trigger, std::chrono::microseconds time);
+
+    std::unique_ptr<IGraphicsBackend> backend_;
+    std::atomic<IGraphicsBackend*> backendPtr_ = nullptr; // read from the render thread while initializing
+    SharedTexturePool sharedTexturePool_; // destroyed before the backend
     std::thread initThread_;
     ThreadLoop threadLoop_;
     WindowQueue windowUploadQueue_;
     WindowQueue iconUploadQueue_;
+    std::deque<std::vector<int>> windowUploadBatches_;
+    std::vector<int> pendingUploadIds_; // waiting for the GPU, touched only by the upload thread
+    std::mutex windowUploadBatchesMutex_;
     std::atomic<bool> hasUploadTriggered_ = false;
+    StageMetrics metrics_ { 0 /* unlimited */ };
+
+    std::atomic<UINT> timeBudget_; // [us], 0 means unlimited
+    std::atomic<UINT64> byteBudget_; // 0 means unlimited
+    mutable std::mutex uploadStatsMutex_;
+    UploadStats uploadStats_ = {};
 };
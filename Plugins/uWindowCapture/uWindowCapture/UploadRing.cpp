@@ -0,0 +1,182 @@
+#include "UploadRing.h"
+
+
+
+int UploadRing::BeginWrite()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    // prefer a free slot, and otherwise overwrite the oldest frame which has not been read yet.
+    int freeSlot = -1;
+    int unreadSlot = -1;
+    for (int i = 0; i < kSlotCount; ++i)
+    {
+        const auto& slot = slots_[i];
+        if (slot.state == SlotState::Free)
+        {
+            if (freeSlot < 0) freeSlot = i;
+        }
+        else if (slot.state == SlotState::Written || slot.state == SlotState::Ready)
+        {
+            if (unreadSlot < 0 || slot.sequence < slots_[unreadSlot].sequence) unreadSlot = i;
+        }
+    }
+
+    const int slot = (freeSlot >= 0) ? freeSlot : unreadSlot;
+    if (slot < 0) return -1;
+
+    slots_[slot].state = SlotState::Writing;
+    return slot;
+}
+
+
+void UploadRing::EndWrite(int slot, IGraphicsBackend* backend, bool hasWritten)
+{
+    auto& s = slots_[slot];
+
+    if (hasWritten)
+    {
+        // issued after the update, so it completes when the GPU has finished writing the slot.
+        if (!s.uploadFence) s.uploadFence = backend->CreateFence(GpuQueue::Upload);
+        if (s.uploadFence) s.uploadFence->Signal();
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    if (hasWritten)
+    {
+        s.state = SlotState::Written;
+        s.sequence = ++lastWrittenSequence_;
+    }
+    else
+    {
+        s.state = SlotState::Free;
+        s.sequence = 0;
+    }
+}
+
+
+bool UploadRing::PollWrites()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    bool hasNewReadySlot = false;
+    for (auto& slot : slots_)
+    {
+        if (slot.state != SlotState::Written) continue;
+
+        if (!slot.uploadFence || slot.uploadFence->IsCompleted())
+        {
+            slot.state = SlotState::Ready;
+            hasNewReadySlot = true;
+        }
+    }
+
+    return hasNewReadySlot;
+}
+
+
+bool UploadRing::HasPendingWrites() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    for (const auto& slot : slots_)
+    {
+        if (slot.state == SlotState::Written) return true;
+    }
+
+    return false;
+}
+
+
+int UploadRing::BeginRead()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    FreeCompletedReads();
+
+    int newestSlot = -1;
+    for (int i = 0; i < kSlotCount; ++i)
+    {
+        const auto& slot = slots_[i];
+        if (slot.state == SlotState::Ready && slot.sequence > lastReadSequence_)
+        {
+            if (newestSlot < 0 || slot.sequence > slots_[newestSlot].sequence) newestSlot = i;
+        }
+    }
+
+    if (newestSlot < 0) return -1;
+
+    // the older frames will never be shown.
+    for (auto& slot : slots_)
+    {
+        if (slot.state == SlotState::Ready && slot.sequence < slots_[newestSlot].sequence)
+        {
+            slot.state = SlotState::Free;
+            slot.sequence = 0;
+        }
+    }
+
+    slots_[newestSlot].state = SlotState::Reading;
+    return newestSlot;
+}
+
+
+void UploadRing::EndRead(int slot, IGraphicsBackend* backend, bool hasRead)
+{
+    auto& s = slots_[slot];
+
+    if (hasRead)
+    {
+        // issued after the copy, so it completes when the GPU has finished reading the slot.
+        if (!s.renderFence) s.renderFence = backend->CreateFence(GpuQueue::Render);
+        if (s.renderFence) s.renderFence->Signal();
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    lastReadSequence_ = max(lastReadSequence_, s.sequence);
+    s.state = hasRead ? SlotState::Released : SlotState::Free;
+    if (!hasRead) s.sequence = 0;
+}
+
+
+void UploadRing::PollReads()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    FreeCompletedReads();
+}
+
+
+bool UploadRing::HasPendingReads() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    for (const auto& slot : slots_)
+    {
+        if (slot.state == SlotState::Released) return true;
+    }
+
+    return false;
+}
+
+
+void UploadRing::FreeCompletedReads()
+{
+    for (auto& slot : slots_)
+    {
+        if (slot.state != SlotState::Released) continue;
+
+        if (!slot.renderFence || slot.renderFence->IsCompleted())
+        {
+            slot.state = SlotState::Free;
+            slot.sequence = 0;
+        }
+    }
+}
+
+
+std::shared_ptr<ISharedTexture>& UploadRing::GetTexture(int slot)
+{
+    return slots_[slot].texture;
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <Windows.h>
+#include <memory>
+#include <mutex>
+
+#include "GraphicsBackend.h"
+
+
+// A few shared textures per window which are written by the upload thread and read by the render thread in turn.
+// Slots move Free -> Writing -> Written -> Ready -> Reading -> Released -> Free, and the GPU fences tell
+// when a written slot can be copied and when a copied slot can be written again.
+// The mutex only guards the slot states and is never held while the GPU commands are issued,
+// and the fences of each queue are polled only on the thread of the queue.
+// So a released slot is freed only by the render thread, and the writer has to ask for PollReads()
+// when BeginWrite() fails because of them (see HasPendingReads()).
+class UploadRing
+{
+public:
+    static constexpr int kSlotCount = 3;
+
+    // upload thread
+    int BeginWrite();
+    void EndWrite(int slot, IGraphicsBackend* backend, bool hasWritten);
+    bool PollWrites();
+    bool HasPendingWrites() const;
+
+    // render thread
+    int BeginRead();
+    void EndRead(int slot, IGraphicsBackend* backend, bool hasRead);
+    void PollReads();
+    bool HasPendingReads() const;
+
+    // only the thread which began the access to the slot can touch its texture.
+    std::shared_ptr<ISharedTexture>& GetTexture(int slot);
+
+private:
+    void FreeCompletedReads();
+
+    enum class SlotState
+    {
+        Free,
+        Writing,
+        Written, // waiting for the upload fence
+        Ready,
+        Reading,
+        Released, // waiting for the render fence
+    };
+
+    struct Slot
+    {
+        SlotState state = SlotState::Free;
+        UINT64 sequence = 0;
+        std::shared_ptr<ISharedTexture> texture;
+        std::shared_ptr<IGpuFence> uploadFence;
+        std::shared_ptr<IGpuFence> renderFence;
+    };
+
+    Slot slots_[kSlotCount];
+    UINT64 lastWrittenSequence_ = 0;
+    UINT64 lastReadSequence_ = 0;
+    mutable std::mutex mutex_;
+};
@@ -0,0 +1,98 @@
+#include "Watchdog.h"
+
+
+
+namespace
+{
+    constexpr int kDefaultThreshold = 200;
+    constexpr int kInitialBackoff = 100;
+    constexpr int kMaxBackoff = 5000;
+    constexpr UINT kFastCallCountToRecover = 3;
+
+    float ToMilliseconds(std::chrono::microseconds us)
+    {
+        return us.count() / 1000.f;
+    }
+}
+
+
+// ---
+
+
+std::atomic<Watchdog::milliseconds::rep> Watchdog::s_threshold = kDefaultThreshold;
+
+
+void Watchdog::SetThreshold(milliseconds threshold)
+{
+    s_threshold = threshold.count();
+}
+
+
+Watchdog::milliseconds Watchdog::GetThreshold()
+{
+    return milliseconds(s_threshold.load());
+}
+
+
+bool Watchdog::Report(microseconds callTime)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    lastCallTime_ = callTime;
+    maxCallTime_ = max(maxCallTime_, callTime);
+
+    if (callTime > GetThreshold())
+    {
+        slowCallCount_++;
+        fastCallCountInQuarantine_ = 0;
+
+        const bool hasJustQuarantined = !isQuarantined_;
+        backoff_ = hasJustQuarantined ?
+            milliseconds(kInitialBackoff) :
+            min(backoff_ * 2, milliseconds(kMaxBackoff));
+        nextRetryTime_ = clock::now() + backoff_;
+        isQuarantined_ = true;
+
+        return hasJustQuarantined;
+    }
+
+    if (isQuarantined_)
+    {
+        if (++fastCallCountInQuarantine_ >= kFastCallCountToRecover)
+        {
+            isQuarantined_ = false;
+            fastCallCountInQuarantine_ = 0;
+            backoff_ = milliseconds::zero();
+        }
+        else
+        {
+            nextRetryTime_ = clock::now() + backoff_;
+        }
+    }
+
+    return false;
+}
+
+
+bool Watchdog::IsQuarantined() const
+{
+    return isQuarantined_;
+}
+
+
+bool Watchdog::IsRetryDue() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return clock::now() >= nextRetryTime_;
+}
+
+
+void Watchdog::GetInfo(QuarantineInfo* info) const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    info->isQuarantined = isQuarantined_;
+    info->slowCallCount = slowCallCount_;
+    info->lastCallTime = ToMilliseconds(lastCallTime_);
+    info->maxCallTime = ToMilliseconds(maxCallTime_);
+    info->backoff = static_cast<float>(backoff_.count());
+}
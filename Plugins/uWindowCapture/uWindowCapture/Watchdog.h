@@ -0,0 +1,50 @@
+#pragma once
+
+#include <Windows.h>
+#include <chrono>
+#include <mutex>
+#include <atomic>
+
+
+struct QuarantineInfo
+{
+    BOOL isQuarantined;
+    UINT slowCallCount;
+    float lastCallTime; // [ms]
+    float maxCallTime; // [ms]
+    float backoff; // [ms]
+};
+
+
+// Times the calls which send messages to a target window (PrintWindow, WM_GETTEXT, WM_GETICON...).
+// A window whose call exceeds the threshold is quarantined and only retried with exponential back-off
+// until it responds quickly several times in a row.
+class Watchdog
+{
+public:
+    using clock = std::chrono::steady_clock;
+    using microseconds = std::chrono::microseconds;
+    using milliseconds = std::chrono::milliseconds;
+
+    static void SetThreshold(milliseconds threshold);
+    static milliseconds GetThreshold();
+
+    // returns true if this call has put the window into quarantine.
+    bool Report(microseconds callTime);
+    bool IsQuarantined() const;
+    bool IsRetryDue() const;
+    void GetInfo(QuarantineInfo* info) const;
+
+private:
+    static std::atomic<milliseconds::rep> s_threshold;
+
+    std::atomic<bool> isQuarantined_ = false;
+    mutable std::mutex mutex_;
+    UINT slowCallCount_ = 0;
+    UINT fastCallCountInQuarantine_ = 0;
+    microseconds lastCallTime_ = microseconds::zero();
+    microseconds maxCallTime_ = microseconds::zero();
+    milliseconds backoff_ = milliseconds::zero();
+    clock::time_point nextRetryTime_;
+};
+
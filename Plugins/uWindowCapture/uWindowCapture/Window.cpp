@@ -1,453 +1,733 @@
-#include <dwmapi.h>
-#include "Window.h"
-#include "WindowTexture.h"
-#include "IconTexture.h"
-#include "WindowManager.h"
-#include "Debug.h"
-#include "Util.h"
-
-
-
-Window::Window(int id)
-    : id_(id)
-{
-}
-
-
-Window::~Window()
-{
-}
-
-
-void Window::SetData(const Data1& data)
-{
-    data1_ = data;
-}
-
-
-int Window::GetId() const
-{
-    return id_;
-}
-
-
-int Window::GetParentId() const
-{
-    return parentId_;
-}
-
-
-HWND Window::GetHandle() const
-{
-    return data1_.hWnd;
-}
-
-
-HWND Window::GetOwnerHandle() const
-{
-    return data1_.hOwner;
-}
-
-
-HWND Window::GetParentHandle() const
-{
-    return data2_.hParent;
-}
-
-
-HINSTANCE Window::GetInstance() const
-{
-    return data2_.hInstance;
-}
-
-
-DWORD Window::GetProcessId() const
-{
-    return data2_.processId;
-}
-
-
-DWORD Window::GetThreadId() const
-{
-    return data2_.threadId;
-}
-
-
-const RECT & Window::GetWindowRect() const
-{
-    return data1_.windowRect;
-}
-
-
-const RECT & Window::GetClientRect() const
-{
-    return data1_.clientRect;
-}
-
-
-bool Window::IsAltTab() const
-{
-    return data2_.isAltTabWindow;
-}
-
-
-bool Window::IsDesktop() const
-{
-    return data1_.isDesktop;
-}
-
-
-BOOL Window::IsWindow() const
-{
-    return ::IsWindow(GetHandle());
-}
-
-
-BOOL Window::IsVisible() const
-{
-    return ::IsWindowVisible(GetHandle());
-}
-
-
-BOOL Window::IsEnabled() const
-{
-    return ::IsWindowEnabled(GetHandle());
-}
-
-
-BOOL Window::IsUnicode() const
-{
-    return ::IsWindowUnicode(GetHandle());
-}
-
-
-BOOL Window::IsZoomed() const
-{
-    return ::IsZoomed(GetHandle());
-}
-
-
-BOOL Window::IsIconic() const
-{
-    return ::IsIconic(GetHandle());
-}
-
-
-BOOL Window::IsHungUp() const
-{
-    return ::IsHungAppWindow(GetHandle());
-}
-
-
-BOOL Window::IsTouchable() const
-{
-    return ::IsTouchWindow(GetHandle(), NULL);
-}
-
-
-BOOL Window::IsApplicationFrameWindow() const
-{
-    return data2_.isApplicationFrameWindow;
-}
-
-
-BOOL Window::IsUWP() const
-{
-    return data2_.isUWP;
-}
-
-
-BOOL Window::IsBackground() const
-{
-    return data2_.isBackground;
-}
-
-
-UINT Window::GetX() const
-{
-    return data1_.windowRect.left;
-}
-
-
-UINT Window::GetY() const
-{
-    return data1_.windowRect.top;
-}
-
-
-UINT Window::GetWidth() const
-{
-    return data1_.windowRect.right - data1_.windowRect.left;
-}
-
-
-UINT Window::GetHeight() const
-{
-    return data1_.windowRect.bottom - data1_.windowRect.top;
-}
-
-
-UINT Window::GetClientWidth() const
-{
-    return data1_.clientRect.right - data1_.clientRect.left;
-}
-
-
-UINT Window::GetClientHeight() const
-{
-    return data1_.clientRect.bottom - data1_.clientRect.top;
-}
-
-
-UINT Window::GetZOrder() const
-{
-    return data1_.zOrder;
-}
-
-
-BYTE* Window::GetBuffer() const
-{
-    return windowTexture_->GetBuffer();
-}
-
-
-UINT Window::GetTextureWidth() const
-{
-    return windowTexture_->GetWidth();
-}
-
-
-UINT Window::GetTextureHeight() const
-{
-    return windowTexture_->GetHeight();
-}
-
-
-UINT Window::GetTextureOffsetX() const
-{
-    return windowTexture_->GetOffsetX();
-}
-
-
-UINT Window::GetTextureOffsetY() const
-{
-    return windowTexture_->GetOffsetY();
-}
-
-
-UINT Window::GetIconWidth() const
-{
-    return iconTexture_->GetWidth();
-}
-
-
-UINT Window::GetIconHeight() const
-{
-    return iconTexture_->GetHeight();
-}
-
-
-const std::wstring& Window::GetTitle() const
-{
-    return data2_.title;
-}
-
-
-const std::string& Window::GetClass() const
-{
-    return data2_.className;
-}
-
-
-void Window::SetWindowTexture(ID3D11Texture2D* ptr)
-{
-    windowTexture_->SetUnityTexturePtr(ptr);
-}
-
-
-ID3D11Texture2D* Window::GetWindowTexture() const
-{
-    return windowTexture_->GetUnityTexturePtr();
-}
-
-
-void Window::SetIconTexture(ID3D11Texture2D* ptr)
-{
-    iconTexture_->SetUnityTexturePtr(ptr);
-}
-
-
-ID3D11Texture2D* Window::GetIconTexture() const
-{
-    return iconTexture_->GetUnityTexturePtr();
-}
-
-
-void Window::SetCaptureMode(CaptureMode mode)
-{
-    windowTexture_->SetCaptureMode(mode);
-}
-
-
-void Window::SetCursorDraw(bool draw)
-{
-    windowTexture_->SetCursorDraw(draw);
-}
-
-
-bool Window::GetCursorDraw() const
-{
-    return windowTexture_->GetCursorDraw();
-}
-
-
-UINT Window::GetPixel(int x, int y) const
-{
-    return windowTexture_->GetPixel(x, y);
-}
-
-
-bool Window::GetPixels(BYTE* output, int x, int y, int width, int height) const
-{
-    return windowTexture_->GetPixels(output, x, y, width, height);
-}
-
-
-CaptureMode Window::GetCaptureMode() const
-{
-    return windowTexture_->GetCaptureMode();
-}
-
-
-void Window::RequestUpdateTitle()
-{
-    hasTitleUpdateRequested_ = true;
-}
-
-
-void Window::UpdateTitle()
-{
-    if (!IsDesktop())
-    {
-        constexpr UINT timeout = 100 /* milliseconds */;
-        GetWindowTitle(data1_.hWnd, data2_.title, timeout);
-    }
-    else
-    {
-        MONITORINFOEX monitor;
-        monitor.cbSize = sizeof(MONITORINFOEX);
-        if (::GetMonitorInfo(data1_.hMonitor, &monitor))
-        {
-            WCHAR buf[_countof(monitor.szDevice)];
-            size_t len;
-            mbstowcs_s(&len, buf, _countof(monitor.szDevice), monitor.szDevice, _TRUNCATE);
-            data2_.title = buf;
-        }
-    }
-}
-
-
-void Window::UpdateIsBackground()
-{
-    if (IsApplicationFrameWindow())
-    {
-        int attr = 0;
-        ::DwmGetWindowAttribute(GetHandle(), DWMWA_CLOAKED, &attr, sizeof(attr));
-        data2_.isBackground = attr;
-    }
-    else
-    {
-        data2_.isBackground = false;
-    }
-}
-
-
-void Window::Capture()
-{
-    // Run this scope in the thread loop managed by CaptureManager.
-
-    if (hasNewWindowTextureCaptured_)
-    {
-        // If it is called before Upload(), skip this frame.
-        return;
-    }
-
-    if (!IsWindow() || !IsVisible())
-    {
-        return;
-    }
-
-    UWC_SCOPE_TIMER(WindowCapture)
-
-    if (windowTexture_->Capture())
-    {
-        if (auto& uploader = WindowManager::GetUploadManager())
-        {
-            uploader->RequestUploadWindow(id_);
-        }
-    }
-}
-
-
-void Window::Upload()
-{
-    // Run this scope in the thread loop managed by UploadManager.
-
-    if (windowTexture_->Upload())
-    {
-        hasNewWindowTextureUploaded_ = true;
-    }
-}
-
-
-void Window::CaptureIcon()
-{
-    if (!IsWindow())
-    {
-        return;
-    }
-
-    if (!iconTexture_->CaptureOnce())
-    {
-        return;
-    }
-
-    if (auto& uploader = WindowManager::GetUploadManager())
-    {
-        uploader->RequestUploadIcon(id_);
-    }
-}
-
-
-void Window::UploadIcon()
-{
-    if (iconTexture_->UploadOnce())
-    {
-        hasNewIconTextureUploaded_ = true;
-    }
-}
-
-
-void Window::RenderIcon()
-{
-    iconTexture_->RenderOnce();
-}
-
-
-void Window::Render()
-{
-    // Run this scope in the unity rendering thread.
-
-    if (hasNewWindowTextureUploaded_)
-    {
-        hasNewWindowTextureUploaded_ = false;
-        windowTexture_->Render();
-        hasNewWindowTextureCaptured_ = false;
-    }
-
-    if (hasNewIconTextureUploaded_)
-    {
-        hasNewIconTextureUploaded_ = false;
-        iconTexture_->RenderOnce();
-    }
-}
+#include <dwmapi.h>
+#include "Window.h"
+#include "WindowTexture.h"
+#include "IconTexture.h"
+#include "WindowManager.h"
+#include "Message.h"
+#include "Debug.h"
+#include "Util.h"
+
+
+
+Window::Window(int id)
+    : id_(id)
+{
+}
+
+
+Window::~Window()
+{
+}
+
+
+void Window::SetData(const Data1& data)
+{
+    data1_ = data;
+}
+
+
+int Window::GetId() const
+{
+    return id_;
+}
+
+
+int Window::GetParentId() const
+{
+    return parentId_;
+}
+
+
+HWND Window::GetHandle() const
+{
+    return data1_.hWnd;
+}
+
+
+HWND Window::GetOwnerHandle() const
+{
+    return data1_.hOwner;
+}
+
+
+HWND Window::GetParentHandle() const
+{
+    return data2_.hParent;
+}
+
+
+HINSTANCE Window::GetInstance() const
+{
+    return data2_.hInstance;
+}
+
+
+DWORD Window::GetProcessId() const
+{
+    return data2_.processId;
+}
+
+
+DWORD Window::GetThreadId() const
+{
+    return data2_.threadId;
+}
+
+
+const RECT & Window::GetWindowRect() const
+{
+    return data1_.windowRect;
+}
+
+
+const RECT & Window::GetClientRect() const
+{
+    return data1_.clientRect;
+}
+
+
+bool Window::IsAltTab() const
+{
+    return data2_.isAltTabWindow;
+}
+
+
+bool Window::IsDesktop() const
+{
+    return data1_.isDesktop;
+}
+
+
+BOOL Window::IsWindow() const
+{
+    return ::IsWindow(GetHandle());
+}
+
+
+BOOL Window::IsVisible() const
+{
+    return ::IsWindowVisible(GetHandle());
+}
+
+
+BOOL Window::IsEnabled() const
+{
+    return ::IsWindowEnabled(GetHandle());
+}
+
+
+BOOL Window::IsUnicode() const
+{
+    return ::IsWindowUnicode(GetHandle());
+}
+
+
+BOOL Window::IsZoomed() const
+{
+    return ::IsZoomed(GetHandle());
+}
+
+
+BOOL Window::IsIconic() const
+{
+    return ::IsIconic(GetHandle());
+}
+
+
+BOOL Window::IsHungUp() const
+{
+    return ::IsHungAppWindow(GetHandle());
+}
+
+
+BOOL Window::IsTouchable() const
+{
+    return ::IsTouchWindow(GetHandle(), NULL);
+}
+
+
+BOOL Window::IsApplicationFrameWindow() const
+{
+    return data2_.isApplicationFrameWindow;
+}
+
+
+BOOL Window::IsUWP() const
+{
+    return data2_.isUWP;
+}
+
+
+BOOL Window::IsBackground() const
+{
+    return data2_.isBackground;
+}
+
+
+UINT Window::GetX() const
+{
+    return data1_.windowRect.left;
+}
+
+
+UINT Window::GetY() const
+{
+    return data1_.windowRect.top;
+}
+
+
+UINT Window::GetWidth() const
+{
+    return data1_.windowRect.right - data1_.windowRect.left;
+}
+
+
+UINT Window::GetHeight() const
+{
+    return data1_.windowRect.bottom - data1_.windowRect.top;
+}
+
+
+UINT Window::GetClientWidth() const
+{
+    return data1_.clientRect.right - data1_.clientRect.left;
+}
+
+
+UINT Window::GetClientHeight() const
+{
+    return data1_.clientRect.bottom - data1_.clientRect.top;
+}
+
+
+UINT Window::GetZOrder() const
+{
+    return data1_.zOrder;
+}
+
+
+BYTE* Window::GetBuffer() const
+{
+    return windowTexture_->GetBuffer();
+}
+
+
+UINT Window::GetTextureWidth() const
+{
+    return windowTexture_->GetWidth();
+}
+
+
+UINT Window::GetTextureHeight() const
+{
+    return windowTexture_->GetHeight();
+}
+
+
+UINT Window::GetTextureOffsetX() const
+{
+    return windowTexture_->GetOffsetX();
+}
+
+
+UINT Window::GetTextureOffsetY() const
+{
+    return windowTexture_->GetOffsetY();
+}
+
+
+UINT Window::GetIconWidth() const
+{
+    return iconTexture_->GetWidth();
+}
+
+
+UINT Window::GetIconHeight() const
+{
+    return iconTexture_->GetHeight();
+}
+
+
+const std::wstring& Window::GetTitle() const
+{
+    return data2_.title;
+}
+
+
+UINT Window::GetTitleVersion() const
+{
+    return titleVersion_;
+}
+
+
+Window::Attributes Window::GetAttributes() const
+{
+    return { data2_.isAltTabWindow, data2_.isUWP, data2_.isBackground, data2_.isTransparent };
+}
+
+
+const std::string& Window::GetClass() const
+{
+    return data2_.className;
+}
+
+
+void Window::SetWindowTexture(ID3D11Texture2D* ptr)
+{
+    windowTexture_->SetUnityTexturePtr(ptr);
+}
+
+
+ID3D11Texture2D* Window::GetWindowTexture() const
+{
+    return windowTexture_->GetUnityTexturePtr();
+}
+
+
+void Window::SetIconTexture(ID3D11Texture2D* ptr)
+{
+    iconTexture_->SetUnityTexturePtr(ptr);
+}
+
+
+ID3D11Texture2D* Window::GetIconTexture() const
+{
+    return iconTexture_->GetUnityTexturePtr();
+}
+
+
+void Window::SetCaptureMode(CaptureMode mode)
+{
+    windowTexture_->SetCaptureMode(mode);
+}
+
+
+void Window::SetCursorDraw(bool draw)
+{
+    windowTexture_->SetCursorDraw(draw);
+}
+
+
+bool Window::GetCursorDraw() const
+{
+    return windowTexture_->GetCursorDraw();
+}
+
+
+UINT Window::GetPixel(int x, int y) const
+{
+    return windowTexture_->GetPixel(x, y);
+}
+
+
+bool Window::GetPixels(BYTE* output, int x, int y, int width, int height) const
+{
+    return windowTexture_->GetPixels(output, x, y, width, height);
+}
+
+
+CaptureMode Window::GetCaptureMode() const
+{
+    return windowTexture_->GetCaptureMode();
+}
+
+
+void Window::RequestUpdateTitle()
+{
+    hasTitleUpdateRequested_ = true;
+}
+
+
+void Window::UpdateTitle()
+{
+    // titles of the other windows are given by MetadataResolver since WM_GETTEXT may block.
+    if (!IsDesktop()) return;
+
+    MONITORINFOEX monitor;
+    monitor.cbSize = sizeof(MONITORINFOEX);
+    if (::GetMonitorInfo(data1_.hMonitor, &monitor))
+    {
+        WCHAR buf[_countof(monitor.szDevice)];
+        size_t len;
+        mbstowcs_s(&len, buf, _countof(monitor.szDevice), monitor.szDevice, _TRUNCATE);
+        SetTitle(buf);
+    }
+}
+
+
+void Window::SetTitle(const std::wstring& title)
+{
+    if (data2_.title == title) return;
+
+    data2_.title = title;
+    titleVersion_++;
+}
+
+
+void Window::UpdateIsBackground()
+{
+    if (IsApplicationFrameWindow())
+    {
+        int attr = 0;
+        ::DwmGetWindowAttribute(GetHandle(), DWMWA_CLOAKED, &attr, sizeof(attr));
+        data2_.isBackground = attr;
+    }
+    else
+    {
+        data2_.isBackground = false;
+    }
+}
+
+
+bool Window::Capture()
+{
+    // Run this scope in the thread loop managed by CaptureManager.
+
+    // the frame captured with the group must not be replaced before the other members are uploaded.
+    if (hasGroupFrameCaptured_)
+    {
+        return false;
+    }
+
+    if (!CaptureFrame())
+    {
+        return false;
+    }
+
+    if (auto& uploader = WindowManager::GetUploadManager())
+    {
+        uploader->RequestUploadWindow(id_);
+    }
+
+    return true;
+}
+
+
+bool Window::CaptureFrame()
+{
+    // Captures into the buffer without requesting the upload,
+    // so that the caller can upload several windows together.
+
+    auto& uploader = WindowManager::GetUploadManager();
+    if (!uploader) return false;
+
+    if (hasNewWindowTextureCaptured_ && uploader->IsBackPressureEnabled())
+    {
+        // The previous frame has not been uploaded yet, so keep it and skip this frame.
+        return false;
+    }
+
+    if (!IsWindow() || !IsVisible())
+    {
+        return false;
+    }
+
+    UWC_SCOPE_TIMER(WindowCapture)
+
+    const auto captureTime = GetTimestamp();
+
+    bool hasCaptured = false;
+    {
+        ScopedTimer timer([this](std::chrono::microseconds us) { ReportCallTime(us); });
+        hasCaptured = windowTexture_->Capture();
+    }
+
+    if (!hasCaptured)
+    {
+        return false;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(frameMutex_);
+        capturedFrame_ = FrameInfo();
+        capturedFrame_.sequence = ++frameSequence_;
+        capturedFrame_.captureTime = captureTime;
+    }
+
+    // If the previous frame is still waiting, it is overwritten by this one (latest wins).
+    hasNewWindowTextureCaptured_ = true;
+
+    return true;
+}
+
+
+void Window::OnGroupFrameCaptured()
+{
+    hasGroupFrameCaptured_ = true;
+}
+
+
+bool Window::Upload()
+{
+    // Run this scope in the thread loop managed by UploadManager.
+
+    // The captured frame is consumed here even if the upload fails.
+    hasNewWindowTextureCaptured_ = false;
+    hasGroupFrameCaptured_ = false;
+
+    FrameInfo frame;
+    {
+        std::lock_guard<std::mutex> lock(frameMutex_);
+        frame = capturedFrame_;
+    }
+
+    // Without a texture the frame goes no further than the buffer,
+    // so async requests complete here once the captured frame reaches the upload stage.
+    if (!GetWindowTexture())
+    {
+        if (auto& capturer = WindowManager::GetCaptureManager())
+        {
+            capturer->CompleteCaptureRequests(id_, frame);
+        }
+    }
+
+    // windows in the atlas are uploaded together with the atlas page, and may have no texture of their own.
+    bool isInAtlas = false;
+    if (auto& atlas = WindowManager::GetThumbnailAtlas())
+    {
+        isInAtlas = atlas->UpdateThumbnail(id_, *windowTexture_);
+    }
+
+    if (isInAtlas && !GetWindowTexture())
+    {
+        return true;
+    }
+
+    if (!windowTexture_->Upload())
+    {
+        // the slots waiting for the render fences are freed only on the render thread,
+        // which is not asked to run for this window until a next upload succeeds.
+        if (windowTexture_->HasPendingRender())
+        {
+            hasWindowTextureRenderToPoll_ = true;
+            WindowManager::Get().RequestRenderWindow(id_);
+        }
+
+        if (auto& capturer = WindowManager::GetCaptureManager())
+        {
+            capturer->FailCaptureRequests(id_, frame.captureTime);
+        }
+        return isInAtlas;
+    }
+
+    frame.uploadTime = GetTimestamp();
+    {
+        std::lock_guard<std::mutex> lock(frameMutex_);
+        uploadedFrame_ = frame;
+    }
+
+    // rendered once the GPU has finished the upload.
+    if (!PollUpload())
+    {
+        if (auto& uploader = WindowManager::GetUploadManager())
+        {
+            uploader->AddPendingUpload(id_);
+        }
+    }
+
+    return true;
+}
+
+
+bool Window::PollUpload()
+{
+    // Run this scope in the thread loop managed by UploadManager.
+
+    if (windowTexture_->PollUpload())
+    {
+        hasNewWindowTextureUploaded_ = true;
+        WindowManager::Get().RequestRenderWindow(id_);
+    }
+
+    return !windowTexture_->HasPendingUpload();
+}
+
+
+void Window::CaptureIcon()
+{
+    if (!IsWindow())
+    {
+        return;
+    }
+
+    bool hasCaptured = false;
+    {
+        ScopedTimer timer([this](std::chrono::microseconds us) { ReportCallTime(us); });
+        hasCaptured = iconTexture_->CaptureOnce();
+    }
+
+    if (!hasCaptured)
+    {
+        return;
+    }
+
+    if (auto& uploader = WindowManager::GetUploadManager())
+    {
+        uploader->RequestUploadIcon(id_);
+    }
+}
+
+
+bool Window::UploadIcon()
+{
+    if (!iconTexture_->UploadOnce()) return false;
+
+    hasNewIconTextureUploaded_ = true;
+    WindowManager::Get().RequestRenderWindow(id_);
+    return true;
+}
+
+
+bool Window::IsQuarantined() const
+{
+    return watchdog_.IsQuarantined();
+}
+
+
+bool Window::IsQuarantineRetryDue() const
+{
+    return watchdog_.IsRetryDue();
+}
+
+
+void Window::GetQuarantineInfo(QuarantineInfo* info) const
+{
+    watchdog_.GetInfo(info);
+}
+
+
+void Window::DeferCapture()
+{
+    hasCaptureDeferred_ = true;
+}
+
+
+void Window::DeferCaptureIcon()
+{
+    hasIconCaptureDeferred_ = true;
+}
+
+
+void Window::RetryInQuarantine()
+{
+    // Run this scope in the quarantine thread loop managed by CaptureManager.
+    // Only one timed call is made per retry so that the back-off is respected.
+
+    if (hasCaptureDeferred_.exchange(false))
+    {
+        Capture();
+    }
+    else if (hasIconCaptureDeferred_.exchange(false))
+    {
+        CaptureIcon();
+    }
+    else
+    {
+        constexpr UINT timeout = 100 /* milliseconds */;
+        ScopedTimer timer([this](std::chrono::microseconds us) { ReportCallTime(us); });
+        PingWindow(GetHandle(), timeout);
+    }
+
+    if (!IsQuarantined() && hasIconCaptureDeferred_.exchange(false))
+    {
+        if (auto& capturer = WindowManager::GetCaptureManager())
+        {
+            capturer->RequestCaptureIcon(id_);
+        }
+    }
+}
+
+
+void Window::ReportCallTime(std::chrono::microseconds callTime)
+{
+    const bool wasQuarantined = watchdog_.IsQuarantined();
+
+    if (watchdog_.Report(callTime))
+    {
+        MessageManager::Get().Add({ MessageType::WindowQuarantined, id_, GetHandle() });
+
+        if (auto& capturer = WindowManager::GetCaptureManager())
+        {
+            capturer->RequestQuarantine(id_);
+        }
+    }
+    else if (wasQuarantined && !watchdog_.IsQuarantined())
+    {
+        MessageManager::Get().Add({ MessageType::WindowRecovered, id_, GetHandle() });
+    }
+}
+
+
+void Window::RenderIcon()
+{
+    iconTexture_->RenderOnce();
+}
+
+
+bool Window::Render()
+{
+    // Run this scope in the unity rendering thread.
+
+    bool hasRendered = false;
+
+    if (hasWindowTextureRenderToPoll_)
+    {
+        hasWindowTextureRenderToPoll_ = false;
+        windowTexture_->PollRender();
+    }
+
+    if (hasNewWindowTextureUploaded_)
+    {
+        hasNewWindowTextureUploaded_ = false;
+        if (windowTexture_->Render())
+        {
+            hasRendered = true;
+            OnWindowTextureRendered();
+        }
+    }
+
+    if (hasNewIconTextureUploaded_)
+    {
+        hasNewIconTextureUploaded_ = false;
+        hasRendered |= iconTexture_->RenderOnce();
+    }
+
+    return hasRendered;
+}
+
+
+void Window::OnWindowTextureRendered()
+{
+    FrameInfo frame;
+    {
+        std::lock_guard<std::mutex> lock(frameMutex_);
+        renderedFrame_ = uploadedFrame_;
+        renderedFrame_.renderTime = GetTimestamp();
+        frame = renderedFrame_;
+    }
+
+    if (frame.captureTime > 0)
+    {
+        const auto latency = frame.renderTime - frame.captureTime;
+        WindowManager::GetFrameClock().AddLatency(std::chrono::microseconds(latency));
+    }
+
+    if (auto& capturer = WindowManager::GetCaptureManager())
+    {
+        capturer->CompleteCaptureRequests(id_, frame);
+    }
+}
+
+
+FrameInfo Window::GetCapturedFrame() const
+{
+    std::lock_guard<std::mutex> lock(frameMutex_);
+    return capturedFrame_;
+}
+
+
+FrameInfo Window::GetRenderedFrame() const
+{
+    std::lock_guard<std::mutex> lock(frameMutex_);
+    return renderedFrame_;
+}
\ No newline at end of file
@@ -1,135 +1,180 @@
-#pragma once
-
-#include <Windows.h>
-#include <d3d11.h>
-#include <string>
-#include <atomic>
-
-#include "Buffer.h"
-
-
-enum class CaptureMode;
-
-
-class Window
-{
-friend class WindowManager;
-public:
-    struct Data1
-    {
-        BOOL isDesktop;
-        HWND hWnd;
-        HMONITOR hMonitor;
-        HWND hOwner;
-        RECT windowRect;
-        RECT clientRect;
-        UINT zOrder;
-    };
-
-    struct Data2
-    {
-        HWND hParent;
-        HINSTANCE hInstance;
-        DWORD processId;
-        DWORD threadId;
-        std::wstring title;
-        std::string className;
-        BOOL isAltTabWindow;
-        BOOL isApplicationFrameWindow;
-        BOOL isUWP;
-        BOOL isBackground;
-    };
-
-    explicit Window(int id);
-    ~Window();
-
-    void SetData(const Data1& data);
-
-    int GetId() const;
-    int GetParentId() const;
-    HWND GetHandle() const;
-    HWND GetOwnerHandle() const;
-    HWND GetParentHandle() const;
-    HINSTANCE GetInstance() const;
-    DWORD GetProcessId() const;
-    DWORD GetThreadId() const;
-
-    const RECT & GetWindowRect() const;
-    const RECT & GetClientRect() const;
-
-    UINT GetX() const;
-    UINT GetY() const;
-    UINT GetWidth() const;
-    UINT GetHeight() const;
-    UINT GetClientWidth() const;
-    UINT GetClientHeight() const;
-    UINT GetZOrder() const;
-    BYTE* GetBuffer() const;
-    UINT GetTextureWidth() const;
-    UINT GetTextureHeight() const;
-    UINT GetTextureOffsetX() const;
-    UINT GetTextureOffsetY() const;
-    UINT GetIconWidth() const;
-    UINT GetIconHeight() const;
-
-    const std::wstring& GetTitle() const;
-    const std::string& GetClass() const;
-
-    void SetWindowTexture(ID3D11Texture2D* ptr);
-    ID3D11Texture2D* GetWindowTexture() const;
-
-    void SetIconTexture(ID3D11Texture2D* ptr);
-    ID3D11Texture2D* GetIconTexture() const;
-
-    void SetCaptureMode(CaptureMode mode);
-    CaptureMode GetCaptureMode() const;
-
-    void SetCursorDraw(bool draw);
-    bool GetCursorDraw() const;
-
-    UINT GetPixel(int x, int y) const;
-    bool GetPixels(BYTE* output, int x, int y, int width, int height) const;
-
-    void RequestUpdateTitle();
-
-    void Capture();
-    void Upload();
-    void Render();
-
-    void CaptureIcon();
-    void UploadIcon();
-    void RenderIcon();
-
-    bool IsAltTab() const;
-    bool IsDesktop() const;
-    BOOL IsWindow() const;
-    BOOL IsVisible() const;
-    BOOL IsEnabled() const;
-    BOOL IsUnicode() const;
-    BOOL IsZoomed() const;
-    BOOL IsIconic() const;
-    BOOL IsHungUp() const;
-    BOOL IsTouchable() const;
-    BOOL IsApplicationFrameWindow() const;
-    BOOL IsUWP() const;
-    BOOL IsBackground() const;
-
-private:
-    void UpdateTitle();
-    void UpdateIsBackground();
-
-    std::shared_ptr<class WindowTexture> windowTexture_ = std::make_shared<WindowTexture>(this);
-    std::shared_ptr<class IconTexture> iconTexture_ = std::make_shared<IconTexture>(this);
-    Data1 data1_;
-    Data2 data2_;
-
-    const int id_ = -1;
-    int parentId_ = -1;
-    int frameCount_ = 0;
-
-    std::atomic<bool> hasTitleUpdateRequested_ = false;
-    std::atomic<bool> hasNewWindowTextureCaptured_ = false;
-    std::atomic<bool> hasNewWindowTextureUploaded_ = false;
-    std::atomic<bool> hasNewIconTextureUploaded_ = false;
-    std::atomic<bool> isAlive_ = true;
-};
+#pragma once
+
+#include <Windows.h>
+#include <d3d11.h>
+#include <string>
+#include <atomic>
+#include <mutex>
+
+#include "Buffer.h"
+#include "Watchdog.h"
+#include "CaptureRequest.h"
+
+
+enum class CaptureMode;
+
+
+class Window
+{
+friend class WindowManager;
+public:
+    struct Data1
+    {
+        BOOL isDesktop;
+        HWND hWnd;
+        HMONITOR hMonitor;
+        HWND hOwner;
+        RECT windowRect;
+        RECT clientRect;
+        UINT zOrder;
+        BOOL isIconic;
+    };
+
+    struct Data2
+    {
+        HWND hParent;
+        HINSTANCE hInstance;
+        DWORD processId;
+        DWORD threadId;
+        std::wstring title;
+        std::string className;
+        BOOL isAltTabWindow;
+        BOOL isApplicationFrameWindow;
+        BOOL isUWP;
+        BOOL isBackground;
+        BOOL isTransparent;
+    };
+
+    // flags of Data2 which may change while the window is alive.
+    struct Attributes
+    {
+        BOOL isAltTabWindow;
+        BOOL isUWP;
+        BOOL isBackground;
+        BOOL isTransparent;
+    };
+
+    explicit Window(int id);
+    ~Window();
+
+    void SetData(const Data1& data);
+
+    int GetId() const;
+    int GetParentId() const;
+    HWND GetHandle() const;
+    HWND GetOwnerHandle() const;
+    HWND GetParentHandle() const;
+    HINSTANCE GetInstance() const;
+    DWORD GetProcessId() const;
+    DWORD GetThreadId() const;
+
+    const RECT & GetWindowRect() const;
+    const RECT & GetClientRect() const;
+
+    UINT GetX() const;
+    UINT GetY() const;
+    UINT GetWidth() const;
+    UINT GetHeight() const;
+    UINT GetClientWidth() const;
+    UINT GetClientHeight() const;
+    UINT GetZOrder() const;
+    BYTE* GetBuffer() const;
+    UINT GetTextureWidth() const;
+    UINT GetTextureHeight() const;
+    UINT GetTextureOffsetX() const;
+    UINT GetTextureOffsetY() const;
+    UINT GetIconWidth() const;
+    UINT GetIconHeight() const;
+
+    const std::wstring& GetTitle() const;
+    UINT GetTitleVersion() const;
+    Attributes GetAttributes() const;
+    const std::string& GetClass() const;
+
+    void SetWindowTexture(ID3D11Texture2D* ptr);
+    ID3D11Texture2D* GetWindowTexture() const;
+
+    void SetIconTexture(ID3D11Texture2D* ptr);
+    ID3D11Texture2D* GetIconTexture() const;
+
+    void SetCaptureMode(CaptureMode mode);
+    CaptureMode GetCaptureMode() const;
+
+    void SetCursorDraw(bool draw);
+    bool GetCursorDraw() const;
+
+    UINT GetPixel(int x, int y) const;
+    bool GetPixels(BYTE* output, int x, int y, int width, int height) const;
+
+    void RequestUpdateTitle();
+
+    bool Capture();
+    bool CaptureFrame();
+    void OnGroupFrameCaptured();
+    bool Upload();
+    bool PollUpload();
+    bool Render();
+    FrameInfo GetCapturedFrame() const;
+    FrameInfo GetRenderedFrame() const;
+
+    void CaptureIcon();
+    bool UploadIcon();
+    void RenderIcon();
+
+    bool IsQuarantined() const;
+    bool IsQuarantineRetryDue() const;
+    void GetQuarantineInfo(QuarantineInfo* info) const;
+    void DeferCapture();
+    void DeferCaptureIcon();
+    void RetryInQuarantine();
+
+    bool IsAltTab() const;
+    bool IsDesktop() const;
+    BOOL IsWindow() const;
+    BOOL IsVisible() const;
+    BOOL IsEnabled() const;
+    BOOL IsUnicode() const;
+    BOOL IsZoomed() const;
+    BOOL IsIconic() const;
+    BOOL IsHungUp() const;
+    BOOL IsTouchable() const;
+    BOOL IsApplicationFrameWindow() const;
+    BOOL IsUWP() const;
+    BOOL IsBackground() const;
+
+private:
+    void UpdateTitle();
+    void SetTitle(const std::wstring& title);
+    void UpdateIsBackground();
+    void ReportCallTime(std::chrono::microseconds callTime);
+    void OnWindowTextureRendered();
+
+    std::shared_ptr<class WindowTexture> windowTexture_ = std::make_shared<WindowTexture>(this);
+    std::shared_ptr<class IconTexture> iconTexture_ = std::make_shared<IconTexture>(this);
+    Data1 data1_;
+    Data2 data2_;
+    Watchdog watchdog_;
+
+    mutable std::mutex frameMutex_;
+    UINT64 frameSequence_ = 0;
+    FrameInfo capturedFrame_;
+    FrameInfo uploadedFrame_;
+    FrameInfo renderedFrame_;
+
+    const int id_ = -1;
+    int parentId_ = -1;
+    int frameCount_ = 0;
+    bool isMetadataResolved_ = false;
+
+    std::atomic<bool> hasTitleUpdateRequested_ = false;
+    std::atomic<bool> hasNewWindowTextureCaptured_ = false;
+    std::atomic<bool> hasGroupFrameCaptured_ = false; // kept until the batch of the group is uploaded
+    std::atomic<bool> hasNewWindowTextureUploaded_ = false;
+    std::atomic<bool> hasWindowTextureRenderToPoll_ = false;
+    std::atomic<bool> hasNewIconTextureUploaded_ = false;
+    std::atomic<bool> hasCaptureDeferred_ = false;
+    std::atomic<bool> hasIconCaptureDeferred_ = false;
+    std::atomic<bool> isAlive_ = true;
+    std::atomic<UINT> titleVersion_ = 0;
+    UINT notifiedTitleVersion_ = 0;
+};
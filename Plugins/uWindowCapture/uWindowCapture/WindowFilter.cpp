@@ -0,0 +1,181 @@
+#include <algorithm>
+#include <cwctype>
+#include "WindowFilter.h"
+#include "WindowSystem.h"
+#include "MetadataResolver.h"
+
+
+
+namespace
+{
+    bool MatchWildcard(const wchar_t* pattern, const wchar_t* text)
+    {
+        const wchar_t* star = nullptr;
+        const wchar_t* retry = nullptr;
+
+        while (*text)
+        {
+            if (*pattern == L'*')
+            {
+                star = pattern++;
+                retry = text;
+            }
+            else if (*pattern == L'?' || std::towlower(*pattern) == std::towlower(*text))
+            {
+                ++pattern;
+                ++text;
+            }
+            else if (star)
+            {
+                pattern = star + 1;
+                text = ++retry;
+            }
+            else
+            {
+                return false;
+            }
+        }
+
+        while (*pattern == L'*') ++pattern;
+        return *pattern == L'\0';
+    }
+
+
+    bool EqualsIgnoreCase(const std::wstring& a, const std::wstring& b)
+    {
+        return a.size() == b.size() && 
+            std::equal(a.begin(), a.end(), b.begin(), [](wchar_t x, wchar_t y) { return std::towlower(x) == std::towlower(y); });
+    }
+}
+
+
+// ---
+
+
+bool WindowFilterSettings::IsEmpty() const
+{
+    return 
+        flags == 0 && 
+        minWidth == 0 && 
+        minHeight == 0 && 
+        processIds.empty() && 
+        processNames.empty() && 
+        classPattern.empty() && 
+        titlePattern.empty();
+}
+
+
+WindowFilter::WindowFilter(MetadataResolver& resolver)
+    : resolver_(resolver)
+{
+}
+
+
+void WindowFilter::SetSettings(const WindowFilterSettings& settings)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    settings_ = std::make_shared<WindowFilterSettings>(settings);
+}
+
+
+WindowFilterSettings WindowFilter::GetSettings() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return *settings_;
+}
+
+
+void WindowFilter::BeginPass()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    passSettings_ = settings_;
+}
+
+
+void WindowFilter::EndPass()
+{
+    // process ids are reused, so forget the processes which had no windows in this pass.
+    // the processes of the tracked windows are forgotten by the window manager as well.
+    for (const auto processId : lastPassProcessIds_)
+    {
+        if (passProcessIds_.find(processId) == passProcessIds_.end())
+        {
+            resolver_.ForgetProcess(processId);
+        }
+    }
+    lastPassProcessIds_.swap(passProcessIds_);
+    passProcessIds_.clear();
+
+    passSettings_.reset();
+}
+
+
+std::wstring WindowFilter::GetProcessName(DWORD processId)
+{
+    passProcessIds_.insert(processId);
+
+    const auto process = resolver_.GetProcessInfo(processId);
+    if (!process) return L"";
+
+    const auto& path = process->imagePath;
+    const auto pos = path.find_last_of(L"\\/");
+    return pos == std::wstring::npos ? path : path.substr(pos + 1);
+}
+
+
+bool WindowFilter::Accept(const IWindowSystem& system, HWND hWnd, const RECT& rect)
+{
+    if (!passSettings_ || passSettings_->IsEmpty()) return true;
+    const auto& settings = *passSettings_;
+
+    // cheaper checks first.
+    const auto width = static_cast<UINT>(max(rect.right - rect.left, 0L));
+    const auto height = static_cast<UINT>(max(rect.bottom - rect.top, 0L));
+    if (width < settings.minWidth || height < settings.minHeight) return false;
+
+    if (!settings.processIds.empty() || !settings.processNames.empty())
+    {
+        const auto processId = system.GetProcessId(hWnd);
+
+        const auto& ids = settings.processIds;
+        const bool isIdAccepted = std::find(ids.begin(), ids.end(), processId) != ids.end();
+
+        bool isNameAccepted = false;
+        if (!isIdAccepted && !settings.processNames.empty())
+        {
+            const auto name = GetProcessName(processId);
+            for (const auto& acceptedName : settings.processNames)
+            {
+                if (EqualsIgnoreCase(name, acceptedName))
+                {
+                    isNameAccepted = true;
+                    break;
+                }
+            }
+        }
+
+        if (!isIdAccepted && !isNameAccepted) return false;
+    }
+
+    if (!settings.classPattern.empty() && !MatchWildcard(settings.classPattern.c_str(), system.GetWindowClass(hWnd).c_str()))
+    {
+        return false;
+    }
+
+    if ((settings.flags & static_cast<UINT>(WindowFilterFlag::AltTabOnly)) && !system.IsAltTabWindow(hWnd))
+    {
+        return false;
+    }
+
+    if ((settings.flags & static_cast<UINT>(WindowFilterFlag::ExcludeCloaked)) && system.IsCloaked(hWnd))
+    {
+        return false;
+    }
+
+    if (!settings.titlePattern.empty() && !MatchWildcard(settings.titlePattern.c_str(), system.GetTitle(hWnd).c_str()))
+    {
+        return false;
+    }
+
+    return true;
+}
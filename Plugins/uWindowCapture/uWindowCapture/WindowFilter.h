@@ -0,0 +1,65 @@
+#pragma once
+
+#include <Windows.h>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <unordered_set>
+
+
+class IWindowSystem;
+class MetadataResolver;
+
+
+enum class WindowFilterFlag : UINT
+{
+    None = 0,
+    AltTabOnly = 1 << 0,
+    ExcludeCloaked = 1 << 1,
+};
+
+
+// Empty lists and patterns accept every window.
+// Patterns are case-insensitive and accept '*' and '?' wildcards.
+struct WindowFilterSettings
+{
+    UINT flags = 0; // WindowFilterFlag
+    UINT minWidth = 0;
+    UINT minHeight = 0;
+    std::vector<DWORD> processIds;
+    std::vector<std::wstring> processNames; // executable file names like "notepad.exe"
+    std::wstring classPattern;
+    std::wstring titlePattern;
+
+    bool IsEmpty() const;
+};
+
+
+// Decides which top-level windows are tracked at all. Settings are changed from the main thread,
+// and Accept() is called from the enumeration thread between BeginPass() and EndPass().
+class WindowFilter
+{
+public:
+    explicit WindowFilter(MetadataResolver& resolver);
+
+    void SetSettings(const WindowFilterSettings& settings);
+    WindowFilterSettings GetSettings() const;
+
+    void BeginPass();
+    void EndPass();
+    bool Accept(const IWindowSystem& system, HWND hWnd, const RECT& rect);
+
+private:
+    std::wstring GetProcessName(DWORD processId);
+
+    MetadataResolver& resolver_;
+
+    mutable std::mutex mutex_;
+    std::shared_ptr<const WindowFilterSettings> settings_ = std::make_shared<WindowFilterSettings>();
+
+    // touched only by the enumeration thread.
+    std::shared_ptr<const WindowFilterSettings> passSettings_;
+    std::unordered_set<DWORD> passProcessIds_;
+    std::unordered_set<DWORD> lastPassProcessIds_;
+};
@@ -1,433 +1,990 @@
-#include <algorithm>
-#include "WindowManager.h"
-#include "WindowTexture.h"
-#include "Message.h"
-#include "Util.h"
-#include "Debug.h"
-
-using namespace Microsoft::WRL;
-
-
-
-UWC_SINGLETON_INSTANCE(WindowManager)
-
-
-void WindowManager::Initialize()
-{
-    {
-        UWC_SCOPE_TIMER(InitUploadManager);
-        uploadManager_ = std::make_unique<UploadManager>();
-    }
-    {
-        UWC_SCOPE_TIMER(InitCaptureManager);
-        captureManager_ = std::make_unique<CaptureManager>();
-    }
-    {
-        UWC_SCOPE_TIMER(Cursor);
-        cursor_ = std::make_unique<Cursor>();
-    }
-    {
-        UWC_SCOPE_TIMER(StartThread);
-        StartWindowHandleListThread();
-    }
-}
-
-
-void WindowManager::Finalize()
-{
-    StopWindowHandleListThread();
-    captureManager_.reset();
-    uploadManager_.reset();
-    cursor_.reset();
-    windows_.clear();
-}
-
-
-void WindowManager::Update()
-{
-}
-
-
-void WindowManager::Render()
-{
-    RenderWindows();
-    cursor_->Render();
-}
-
-
-void WindowManager::StartWindowHandleListThread()
-{
-    windowHandleListThreadLoop_.Start([this]
-    {
-        UpdateWindowHandleList();
-        UpdateWindows();
-    }, std::chrono::milliseconds(16));
-}
-
-
-void WindowManager::StopWindowHandleListThread()
-{
-    windowHandleListThreadLoop_.Stop();
-}
-
-
-const std::unique_ptr<CaptureManager>& WindowManager::GetCaptureManager()
-{
-    return WindowManager::Get().captureManager_;
-}
-
-
-const std::unique_ptr<UploadManager>& WindowManager::GetUploadManager()
-{
-    return WindowManager::Get().uploadManager_;
-}
-
-
-const std::unique_ptr<Cursor>& WindowManager::GetCursor()
-{
-    return WindowManager::Get().cursor_;
-}
-
-
-bool WindowManager::CheckExistence(int id) const
-{
-    return windows_.find(id) != windows_.end();
-}
-
-
-std::shared_ptr<Window> WindowManager::GetWindow(int id) const
-{
-    auto it = windows_.find(id);
-    if (it == windows_.end())
-    {
-        Debug::Error(__FUNCTION__, " => Window whose id is ", id, " does not exist.");
-        return nullptr;
-    }
-    return it->second;
-}
-
-
-std::shared_ptr<Window> WindowManager::GetWindowFromPoint(POINT point) const
-{
-    auto hWnd = ::WindowFromPoint(point);
-
-    while (hWnd != NULL)
-    {
-        DWORD thread, process;
-        thread = ::GetWindowThreadProcessId(hWnd, &process);
-
-        std::shared_ptr<Window> parent;
-        int maxZOrder = INT_MAX;
-
-        for (const auto& pair : windows_)
-        {
-            const auto& window = pair.second;
-
-            // Return the window whose handle is same
-            if (window->GetHandle() == hWnd) 
-            {
-                return window;
-            }
-
-            // Keep windows whose process and thread ids are same
-            if ((window->GetThreadId() == thread) &&
-                (window->GetProcessId() == process))
-            {
-                const int zOrder = window->GetZOrder();
-                if (zOrder > maxZOrder)
-                {
-                    maxZOrder = zOrder;
-                    parent = window;
-                }
-            }
-        }
-
-        // Return parent if found.
-        if (parent)
-        {
-            return parent;
-        }
-
-        // Move next
-        hWnd = ::GetAncestor(hWnd, GA_PARENT);
-    }
-
-    return nullptr;
-}
-
-
-std::shared_ptr<Window> WindowManager::GetCursorWindow() const
-{
-    return cursorWindow_.lock();
-}
-
-
-std::shared_ptr<Window> WindowManager::FindParentWindow(const std::shared_ptr<Window>& window) const
-{
-    std::shared_ptr<Window> parent = nullptr;
-    int minDeltaZOrder = INT_MAX;
-    int selfZOrder = window->GetZOrder();
-
-    for (const auto& pair : windows_)
-    {
-        const auto& other = pair.second;
-
-        if (other->GetId() == window->GetId()) 
-        {
-            continue;
-        }
-
-        if ((
-            other->GetHandle() == window->GetParentHandle() ||
-            other->GetHandle() == window->GetOwnerHandle()
-        ) || 
-        (
-            ((other->GetParentId()  == -1 || other->IsAltTab()) &&
-            other->GetProcessId() == window->GetProcessId() &&
-            other->GetThreadId()  == window->GetThreadId()) 
-        ))
-        {
-            // TODO: This is not accurate, should find the correct way to detect the parent.
-            const int zOrder = other->GetZOrder();
-            const int deltaZOrder = zOrder - selfZOrder;
-            if (deltaZOrder > 0 && deltaZOrder < minDeltaZOrder)
-            {
-                minDeltaZOrder = deltaZOrder;
-                parent = other;
-            }
-        }
-    }
-
-    return parent;
-}
-
-
-std::shared_ptr<Window> WindowManager::FindOrAddWindow(HWND hWnd)
-{
-    const auto it = std::find_if(
-        windows_.begin(),
-        windows_.end(),
-        [hWnd](const auto& pair) { return pair.second->GetHandle() == hWnd; });
-
-    if (it != windows_.end())
-    {
-        return it->second;
-    }
-
-    const auto id = lastWindowId_++;
-    auto window = std::make_shared<Window>(id);
-    windows_.emplace(id, window);
-
-    return window;
-}
-
-
-std::shared_ptr<Window> WindowManager::FindOrAddDesktop(HMONITOR hMonitor)
-{
-    const auto it = std::find_if(
-        windows_.begin(),
-        windows_.end(),
-        [hMonitor](const auto& pair) 
-        { 
-            const auto& window = pair.second;
-            return window->IsDesktop() && window->data1_.hMonitor == hMonitor; 
-        });
-
-    if (it != windows_.end())
-    {
-        return it->second;
-    }
-
-    const auto id = lastWindowId_++;
-    auto window = std::make_shared<Window>(id);
-    window->SetCaptureMode(CaptureMode::BitBlt);
-    windows_.emplace(id, window);
-
-    return window;
-}
-
-
-void WindowManager::UpdateWindows()
-{
-    UWC_SCOPE_TIMER(UpdateWindows);
-
-    for (const auto& pair : windows_)
-    {
-        pair.second->isAlive_ = false;
-    }
-
-    {
-        std::lock_guard<std::mutex> lock(windowsHandleListMutex_);
-        for (auto&& data1 : windowDataList_[0])
-        {
-            auto window = data1.isDesktop ?
-                WindowManager::Get().FindOrAddDesktop(data1.hMonitor) :
-                WindowManager::Get().FindOrAddWindow(data1.hWnd);
-            if (window)
-            {
-                {
-                    window->SetData(data1);
-                }
-                window->isAlive_ = true;
-
-                // Newly added
-                if (window->frameCount_ == 0)
-                {
-                    auto &data2 = window->data2_;
-                    const auto hWnd = window->GetHandle();
-
-                    if (!window->IsDesktop())
-                    {
-                        data2.hParent = ::GetParent(hWnd);
-                        data2.hInstance = reinterpret_cast<HINSTANCE>(::GetWindowLongPtr(hWnd, GWLP_HINSTANCE));
-                        data2.threadId = ::GetWindowThreadProcessId(hWnd, &data2.processId);
-                        data2.isAltTabWindow = IsAltTabWindow(hWnd);
-                        GetWindowClassName(hWnd, data2.className);
-                        data2.isApplicationFrameWindow = IsApplicationFrameWindow(data2.className);
-                        data2.isUWP = IsUWP(data2.processId);
-                        window->UpdateTitle();
-                        window->UpdateIsBackground();
-                    }
-                    else
-                    {
-                        data2.hParent = NULL;
-                        data2.hInstance = NULL;
-                        data2.threadId = ::GetWindowThreadProcessId(hWnd, &data2.processId);
-                        data2.isAltTabWindow = false;
-                        data2.isApplicationFrameWindow = false;
-                        data2.isUWP = false;
-                        data2.isBackground = false;
-                        data2.className = "";
-                        window->UpdateTitle();
-                    }
-
-                    if (auto parent = FindParentWindow(window))
-                    {
-                        window->parentId_ = parent->GetId();
-                    }
-
-                    MessageManager::Get().Add({ MessageType::WindowAdded, window->GetId(), window->GetHandle() });
-                }
-                else
-                {
-                    if (window->hasTitleUpdateRequested_ || window->GetTitle().empty()) 
-                    {
-                        window->hasTitleUpdateRequested_ = false;
-                        window->UpdateTitle();
-                    }
-                    window->UpdateIsBackground();
-                }
-
-                window->frameCount_++;
-            }
-        }
-    }
-
-    for (auto it = windows_.begin(); it != windows_.end();)
-    {
-        const auto id = it->first;
-        auto& window = it->second;
-
-        if (!window->isAlive_)
-        {
-            MessageManager::Get().Add({ MessageType::WindowRemoved, id, window->GetHandle() });
-            windows_.erase(it++);
-        }
-        else
-        {
-            it++;
-        }
-    }
-}
-
-
-void WindowManager::UpdateWindowHandleList()
-{
-    UWC_SCOPE_TIMER(UpdateWindowHandleList);
-
-    static const auto _EnumWindowsCallback = [](HWND hWnd, LPARAM lParam) -> BOOL
-    {
-        if (!::IsWindow(hWnd) || !::IsWindowVisible(hWnd) || ::IsHungAppWindow(hWnd))
-        {
-            return TRUE;
-        }
-
-        Window::Data1 data;
-        data.hWnd = hWnd;
-        data.hOwner = ::GetWindow(hWnd, GW_OWNER);
-        ::GetWindowRect(hWnd, &data.windowRect);
-        ::GetClientRect(hWnd, &data.clientRect);
-        data.zOrder = ::GetWindowZOrder(hWnd);
-        data.hMonitor = ::MonitorFromWindow(hWnd, MONITOR_DEFAULTTOPRIMARY);
-        data.isDesktop = false;
-
-        auto thiz = reinterpret_cast<WindowManager*>(lParam);
-        thiz->windowDataList_[1].push_back(data);
-
-        return TRUE;
-    };
-
-    using EnumWindowsCallbackType = BOOL(CALLBACK *)(HWND, LPARAM);
-    static const auto EnumWindowsCallback = static_cast<EnumWindowsCallbackType>(_EnumWindowsCallback);
-    if (!::EnumWindows(EnumWindowsCallback, reinterpret_cast<LPARAM>(this)))
-    {
-        OutputApiError(__FUNCTION__, "EnumWindows");
-    }
-
-    static const auto _EnumDisplayMonitorsCallback = [](HMONITOR hMonitor, HDC hDc, LPRECT lpRect, LPARAM lParam) -> BOOL
-    {
-        const auto hWnd = GetDesktopWindow();;
-
-        Window::Data1 data;
-        data.hWnd = hWnd;
-        data.hOwner = NULL;
-        data.windowRect = *lpRect;
-        data.clientRect = *lpRect;
-        data.zOrder = 0;
-        data.hMonitor = hMonitor;
-        data.isDesktop = true;
-
-        auto thiz = reinterpret_cast<WindowManager*>(lParam);
-        thiz->windowDataList_[1].push_back(data);
-
-        return TRUE;
-    };
-
-    using EnumDisplayMonitorsCallbackType = BOOL(CALLBACK *)(HMONITOR, HDC, LPRECT, LPARAM);
-    static const auto EnumDisplayMonitorsCallback = static_cast<EnumDisplayMonitorsCallbackType>(_EnumDisplayMonitorsCallback);
-    if (!::EnumDisplayMonitors(NULL, NULL, EnumDisplayMonitorsCallback, reinterpret_cast<LPARAM>(this)))
-    {
-        OutputApiError(__FUNCTION__, "EnumDisplayMonitors");
-    }
-
-    std::sort(
-        windowDataList_[1].begin(), 
-        windowDataList_[1].end(), 
-        [](const auto& a, const auto& b) 
-        {
-            return 
-                a.hOwner == nullptr &&
-                b.hOwner != nullptr;
-        });
-
-    {
-        std::lock_guard<std::mutex> lock(windowsHandleListMutex_);
-        std::swap(windowDataList_[0], windowDataList_[1]);
-    }
-    windowDataList_[1].clear();
-
-    POINT cursorPos;
-    if (::GetCursorPos(&cursorPos))
-    {
-        cursorWindow_ = GetWindowFromPoint(cursorPos);
-    }
-}
-
-
-void WindowManager::RenderWindows()
-{
-    for (auto&& pair : windows_)
-    {
-        pair.second->Render();
-    }
+#include <algorithm>
+#include "WindowManager.h"
+#include "WindowTexture.h"
+#include "Message.h"
+#include "Util.h"
+#include "Debug.h"
+
+
+
+UWC_SINGLETON_INSTANCE(WindowManager)
+
+
+namespace
+{
+    constexpr int kWindowUpdateMinInterval = 4; // [ms]
+    constexpr int kWindowUpdateMaxInterval = 16; // [ms]
+}
+
+
+// ---
+
+
+
+void WindowManager::Initialize()
+{
+    {
+        UWC_SCOPE_TIMER(InitUploadManager);
+        uploadManager_ = std::make_unique<UploadManager>();
+    }
+    {
+        UWC_SCOPE_TIMER(InitCaptureManager);
+        captureManager_ = std::make_unique<CaptureManager>();
+    }
+    {
+        UWC_SCOPE_TIMER(Cursor);
+        cursor_ = std::make_unique<Cursor>();
+    }
+    {
+        UWC_SCOPE_TIMER(InitThumbnailAtlas);
+        thumbnailAtlas_ = std::make_unique<ThumbnailAtlas>();
+    }
+    {
+        UWC_SCOPE_TIMER(InitIconCache);
+        iconCache_ = std::make_unique<IconCache>();
+    }
+    {
+        UWC_SCOPE_TIMER(StartThread);
+        windowSystem_ = std::make_unique<Win32WindowSystem>();
+        metadataResolver_ = std::make_unique<MetadataResolver>();
+        windowTracker_ = std::make_unique<WindowTracker>(*windowSystem_, *metadataResolver_);
+        StartWindowHandleListThread();
+    }
+}
+
+
+void WindowManager::Finalize()
+{
+    StopWindowHandleListThread();
+    windowTracker_.reset();
+    metadataResolver_.reset();
+    windowSystem_.reset();
+    captureManager_.reset();
+    uploadManager_.reset();
+    cursor_.reset();
+    thumbnailAtlas_.reset();
+    iconCache_.reset();
+    windows_.Clear();
+    windowIdsByHandle_.clear();
+    desktopIdsByMonitor_.clear();
+    windowIdsByThread_.clear();
+    spatialIndex_.Clear();
+    cursorWindowId_ = -1;
+    addedWindowIds_.clear();
+    std::atomic_store(&table_, std::shared_ptr<const WindowTable>(std::make_shared<WindowTable>()));
+}
+
+
+void WindowManager::Update()
+{
+}
+
+
+void WindowManager::Render(int eventId)
+{
+    const auto start = std::chrono::steady_clock::now();
+
+    UINT copyCount = 0;
+    if (eventId == kRenderEventAll)
+    {
+        copyCount = RenderFrame();
+        copyCount += RenderWindows(nullptr);
+    }
+    else if (eventId == kRenderEventFrame)
+    {
+        copyCount = RenderFrame();
+    }
+    else if (eventId >= 0)
+    {
+        const std::vector<int> ids { eventId };
+        copyCount = RenderWindows(&ids);
+    }
+    else
+    {
+        if (!captureManager_) return;
+
+        const auto group = captureManager_->GetCaptureGroup(GetGroupIdFromRenderEvent(eventId));
+        if (!group) return;
+
+        const auto ids = group->GetMembers();
+        copyCount = RenderWindows(&ids);
+    }
+
+    const auto time = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+    const float timeMs = time.count() / 1000.f;
+
+    std::lock_guard<std::mutex> lock(renderStatsMutex_);
+    auto& stats = renderStats_;
+    stats.frameCount++;
+    stats.lastCopyCount = copyCount;
+    stats.maxCopyCount = max(stats.maxCopyCount, copyCount);
+    stats.lastFrameTime = timeMs;
+    stats.averageFrameTime += (timeMs - stats.averageFrameTime) / stats.frameCount;
+    stats.maxFrameTime = max(stats.maxFrameTime, timeMs);
+}
+
+
+UINT WindowManager::RenderFrame()
+{
+    // the work done once per frame regardless of which windows are rendered.
+    frameClock_.Tick();
+
+    UINT copyCount = 0;
+    if (cursor_ && cursor_->Render()) copyCount++;
+
+    auto backend = uploadManager_ ? uploadManager_->GetBackend() : nullptr;
+    if (thumbnailAtlas_ && backend)
+    {
+        copyCount += thumbnailAtlas_->Render(backend);
+    }
+
+    return copyCount;
+}
+
+
+void WindowManager::StartWindowHandleListThread()
+{
+    // Changes are picked up as soon as they are notified, but not more often than the min interval.
+    windowHandleListThreadLoop_.Start([this]
+    {
+        windowTracker_->WaitForChanges(std::chrono::milliseconds(kWindowUpdateMaxInterval));
+        UpdateWindowHandleList();
+        UpdateWindows();
+        PublishTable();
+        NotifyAddedWindows();
+        PublishSnapshot();
+    }, std::chrono::milliseconds(kWindowUpdateMinInterval));
+}
+
+
+void WindowManager::StopWindowHandleListThread()
+{
+    windowHandleListThreadLoop_.Stop();
+}
+
+
+const std::unique_ptr<CaptureManager>& WindowManager::GetCaptureManager()
+{
+    return WindowManager::Get().captureManager_;
+}
+
+
+const std::unique_ptr<UploadManager>& WindowManager::GetUploadManager()
+{
+    return WindowManager::Get().uploadManager_;
+}
+
+
+const std::unique_ptr<Cursor>& WindowManager::GetCursor()
+{
+    return WindowManager::Get().cursor_;
+}
+
+
+const std::unique_ptr<ThumbnailAtlas>& WindowManager::GetThumbnailAtlas()
+{
+    return WindowManager::Get().thumbnailAtlas_;
+}
+
+
+const std::unique_ptr<IconCache>& WindowManager::GetIconCache()
+{
+    return WindowManager::Get().iconCache_;
+}
+
+
+std::shared_ptr<const ProcessInfo> WindowManager::GetProcessInfo(DWORD processId)
+{
+    const auto& resolver = WindowManager::Get().metadataResolver_;
+    return resolver ? resolver->GetProcessInfo(processId) : nullptr;
+}
+
+
+FrameClock& WindowManager::GetFrameClock()
+{
+    return WindowManager::Get().frameClock_;
+}
+
+
+std::shared_ptr<const WindowTable> WindowManager::GetTable() const
+{
+    return std::atomic_load(&table_);
+}
+
+
+void WindowManager::PublishTable()
+{
+    // the table is copied only when windows have been added or removed.
+    if (!isTableDirty_) return;
+    isTableDirty_ = false;
+
+    auto table = std::make_shared<WindowTable>();
+    table->windows = windows_;
+    table->windowIdsByHandle = windowIdsByHandle_;
+    for (const auto& window : windows_)
+    {
+        if (window->IsDesktop()) continue;
+        table->windowIdsByProcess[window->GetProcessId()].push_back(window->GetId());
+    }
+
+    std::atomic_store(&table_, std::shared_ptr<const WindowTable>(std::move(table)));
+}
+
+
+void WindowManager::NotifyAddedWindows()
+{
+    // sent after the table is published so that the consumers can access the windows right away.
+    for (const int id : addedWindowIds_)
+    {
+        if (const auto window = windows_.Find(id))
+        {
+            MessageManager::Get().Add({ MessageType::WindowAdded, id, (*window)->GetHandle() });
+        }
+    }
+    addedWindowIds_.clear();
+}
+
+
+bool WindowManager::CheckExistence(int id) const
+{
+    return GetTable()->windows.Contains(id);
+}
+
+
+std::shared_ptr<Window> WindowManager::GetWindow(int id) const
+{
+    const auto table = GetTable();
+    if (const auto window = table->windows.Find(id))
+    {
+        return *window;
+    }
+
+    // stale ids are expected since windows can be removed while requests for them are queued.
+    if (!table->windows.IsStale(id))
+    {
+        Debug::Error(__FUNCTION__, " => Window whose id is ", id, " does not exist.");
+    }
+    return nullptr;
+}
+
+
+std::shared_ptr<Window> WindowManager::GetWindowFromHandle(HWND hWnd) const
+{
+    const auto table = GetTable();
+    const auto it = table->windowIdsByHandle.find(hWnd);
+    if (it == table->windowIdsByHandle.end()) return nullptr;
+
+    const auto window = table->windows.Find(it->second);
+    return window ? *window : nullptr;
+}
+
+
+std::shared_ptr<Window> WindowManager::FindWindowFromHandle(HWND hWnd) const
+{
+    const auto it = windowIdsByHandle_.find(hWnd);
+    if (it == windowIdsByHandle_.end()) return nullptr;
+
+    const auto window = windows_.Find(it->second);
+    return window ? *window : nullptr;
+}
+
+
+std::shared_ptr<Window> WindowManager::GetWindowFromPoint(POINT point) const
+{
+    const int id = spatialIndex_.QueryPoint(point);
+    if (id < 0) return nullptr;
+
+    const auto window = GetTable()->windows.Find(id);
+    return window ? *window : nullptr;
+}
+
+
+void WindowManager::GetWindowIdsFromPoints(const POINT* points, UINT count, int* outIds) const
+{
+    spatialIndex_.QueryPoints(points, count, outIds);
+}
+
+
+std::vector<int> WindowManager::GetWindowIdsInRect(const RECT& rect) const
+{
+    return spatialIndex_.QueryRect(rect);
+}
+
+
+std::vector<int> WindowManager::GetWindowsOfProcess(DWORD processId) const
+{
+    const auto table = GetTable();
+    const auto it = table->windowIdsByProcess.find(processId);
+    if (it == table->windowIdsByProcess.end()) return {};
+
+    return it->second;
+}
+
+
+const std::set<int>* WindowManager::GetWindowsOfThread(DWORD processId, DWORD threadId) const
+{
+    const auto it = windowIdsByThread_.find({ processId, threadId });
+    if (it == windowIdsByThread_.end()) return nullptr;
+
+    return &it->second;
+}
+
+
+std::shared_ptr<Window> WindowManager::GetCursorWindow() const
+{
+    const int id = cursorWindowId_;
+    if (id < 0) return nullptr;
+
+    const auto window = GetTable()->windows.Find(id);
+    return window ? *window : nullptr;
+}
+
+
+std::shared_ptr<Window> WindowManager::FindParentWindow(const std::shared_ptr<Window>& window) const
+{
+    std::shared_ptr<Window> parent = nullptr;
+    int minDeltaZOrder = INT_MAX;
+    int selfZOrder = window->GetZOrder();
+
+    const auto checkCandidate = [&](const std::shared_ptr<Window>& other)
+    {
+        if (!other || other->GetId() == window->GetId()) 
+        {
+            return;
+        }
+
+        // TODO: This is not accurate, should find the correct way to detect the parent.
+        const int zOrder = other->GetZOrder();
+        const int deltaZOrder = zOrder - selfZOrder;
+        if (deltaZOrder > 0 && deltaZOrder < minDeltaZOrder)
+        {
+            minDeltaZOrder = deltaZOrder;
+            parent = other;
+        }
+    };
+
+    // Windows whose handle is the parent or the owner
+    if (window->GetParentHandle())
+    {
+        checkCandidate(FindWindowFromHandle(window->GetParentHandle()));
+    }
+    if (window->GetOwnerHandle())
+    {
+        checkCandidate(FindWindowFromHandle(window->GetOwnerHandle()));
+    }
+
+    // Top-level windows in the same thread
+    if (const auto ids = GetWindowsOfThread(window->GetProcessId(), window->GetThreadId()))
+    {
+        for (const int id : *ids)
+        {
+            const auto found = windows_.Find(id);
+            if (!found) continue;
+
+            const auto& other = *found;
+            if (other->GetParentId() == -1 || other->IsAltTab())
+            {
+                checkCandidate(other);
+            }
+        }
+    }
+
+    return parent;
+}
+
+
+std::shared_ptr<Window> WindowManager::FindOrAddWindow(HWND hWnd)
+{
+    if (auto window = FindWindowFromHandle(hWnd))
+    {
+        return window;
+    }
+
+    std::shared_ptr<Window> window;
+    const auto id = windows_.Insert([&](int id) { return window = std::make_shared<Window>(id); });
+    if (id < 0) return nullptr;
+    windowIdsByHandle_[hWnd] = id;
+    isTableDirty_ = true;
+
+    return window;
+}
+
+
+std::shared_ptr<Window> WindowManager::FindOrAddDesktop(HMONITOR hMonitor)
+{
+    const auto it = desktopIdsByMonitor_.find(hMonitor);
+    if (it != desktopIdsByMonitor_.end())
+    {
+        if (const auto window = windows_.Find(it->second))
+        {
+            return *window;
+        }
+    }
+
+    std::shared_ptr<Window> window;
+    const auto id = windows_.Insert([&](int id) { return window = std::make_shared<Window>(id); });
+    if (id < 0) return nullptr;
+    window->SetCaptureMode(CaptureMode::BitBlt);
+    desktopIdsByMonitor_[hMonitor] = id;
+    isTableDirty_ = true;
+
+    return window;
+}
+
+
+void WindowManager::AddToThreadIndex(const std::shared_ptr<Window>& window)
+{
+    windowIdsByThread_[{ window->GetProcessId(), window->GetThreadId() }].insert(window->GetId());
+}
+
+
+void WindowManager::RemoveFromIndices(const std::shared_ptr<Window>& window)
+{
+    const auto id = window->GetId();
+
+    spatialIndex_.Remove(id);
+
+    const auto processId = window->GetProcessId();
+    const auto threadIt = windowIdsByThread_.find({ processId, window->GetThreadId() });
+    if (threadIt != windowIdsByThread_.end())
+    {
+        threadIt->second.erase(id);
+        if (threadIt->second.empty())
+        {
+            windowIdsByThread_.erase(threadIt);
+
+            // the cached process info is dropped with the last window since process ids are reused.
+            const auto processIt = windowIdsByThread_.lower_bound({ processId, 0 });
+            if (metadataResolver_ && (processIt == windowIdsByThread_.end() || processIt->first.first != processId))
+            {
+                metadataResolver_->ForgetProcess(processId);
+            }
+        }
+    }
+
+    if (window->IsDesktop())
+    {
+        const auto it = desktopIdsByMonitor_.find(window->data1_.hMonitor);
+        if (it != desktopIdsByMonitor_.end() && it->second == id)
+        {
+            desktopIdsByMonitor_.erase(it);
+        }
+    }
+    else
+    {
+        const auto it = windowIdsByHandle_.find(window->GetHandle());
+        if (it != windowIdsByHandle_.end() && it->second == id)
+        {
+            windowIdsByHandle_.erase(it);
+        }
+    }
+}
+
+
+void WindowManager::UpdateWindows()
+{
+    UWC_SCOPE_TIMER(UpdateWindows);
+
+    ApplyMetadata();
+
+    for (const auto& window : windows_)
+    {
+        window->isAlive_ = false;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(windowsHandleListMutex_);
+        for (auto&& data1 : windowDataList_[0])
+        {
+            auto window = data1.isDesktop ?
+                WindowManager::Get().FindOrAddDesktop(data1.hMonitor) :
+                WindowManager::Get().FindOrAddWindow(data1.hWnd);
+            if (window)
+            {
+                const auto previous = window->data1_;
+                window->SetData(data1);
+                window->isAlive_ = true;
+
+                // Newly added
+                if (window->frameCount_ == 0)
+                {
+                    auto &data2 = window->data2_;
+                    const auto hWnd = window->GetHandle();
+
+                    if (!window->IsDesktop())
+                    {
+                        data2.hParent = ::GetParent(hWnd);
+                        data2.hInstance = reinterpret_cast<HINSTANCE>(::GetWindowLongPtr(hWnd, GWLP_HINSTANCE));
+                        data2.threadId = ::GetWindowThreadProcessId(hWnd, &data2.processId);
+                        data2.isAltTabWindow = false;
+                        data2.isApplicationFrameWindow = false;
+                        data2.isUWP = false;
+                        data2.isBackground = false;
+                        data2.isTransparent = (::GetWindowLong(hWnd, GWL_EXSTYLE) & WS_EX_TRANSPARENT) != 0;
+
+                        // WindowAdded is sent when the class name, the title and so on are resolved.
+                        metadataResolver_->RequestAttributes(window->GetId(), hWnd, data2.processId);
+                    }
+                    else
+                    {
+                        data2.hParent = NULL;
+                        data2.hInstance = NULL;
+                        data2.threadId = ::GetWindowThreadProcessId(hWnd, &data2.processId);
+                        data2.isAltTabWindow = false;
+                        data2.isApplicationFrameWindow = false;
+                        data2.isUWP = false;
+                        data2.isBackground = false;
+                        data2.isTransparent = false;
+                        data2.className = "";
+                        window->UpdateTitle();
+                        window->isMetadataResolved_ = true;
+                    }
+
+                    AddToThreadIndex(window);
+
+                    if (auto parent = FindParentWindow(window))
+                    {
+                        window->parentId_ = parent->GetId();
+                    }
+
+                    if (window->isMetadataResolved_)
+                    {
+                        window->notifiedTitleVersion_ = window->GetTitleVersion();
+                        addedWindowIds_.push_back(window->GetId());
+                    }
+                }
+                else
+                {
+                    // Quarantined windows keep their title until they respond again.
+                    // Empty titles are polled only when title change events are not available.
+                    const bool needsTitle = window->GetTitle().empty() && !windowTracker_->IsEventDriven();
+                    if ((window->hasTitleUpdateRequested_ || needsTitle) && !window->IsQuarantined()) 
+                    {
+                        window->hasTitleUpdateRequested_ = false;
+                        if (window->IsDesktop())
+                        {
+                            window->UpdateTitle();
+                        }
+                        else if (!metadataResolver_->RequestTitle(window->GetId(), window->GetHandle()))
+                        {
+                            // kept until the pending request of the window has finished.
+                            window->hasTitleUpdateRequested_ = true;
+                        }
+                    }
+                    const auto previousAttributes = window->GetAttributes();
+                    window->UpdateIsBackground();
+                    if (window->isMetadataResolved_)
+                    {
+                        NotifyWindowChanges(window, previous, previousAttributes);
+                    }
+                }
+
+                window->frameCount_++;
+
+                // click-through and cloaked windows are not hit by points.
+                if (window->IsBackground() || window->data2_.isTransparent)
+                {
+                    spatialIndex_.Remove(window->GetId());
+                }
+                else
+                {
+                    spatialIndex_.Update(window->GetId(), data1.windowRect, data1.zOrder, data1.isDesktop != FALSE);
+                }
+            }
+        }
+    }
+
+    windows_.EraseIf([this](const std::shared_ptr<Window>& window)
+    {
+        if (window->isAlive_) return false;
+
+        const auto id = window->GetId();
+
+        // consumers have not been told about windows whose metadata is still being resolved.
+        if (window->isMetadataResolved_)
+        {
+            MessageManager::Get().Add({ MessageType::WindowRemoved, id, window->GetHandle() });
+        }
+        if (captureManager_)
+        {
+            captureManager_->FailCaptureRequests(id);
+        }
+        if (thumbnailAtlas_)
+        {
+            thumbnailAtlas_->RemoveWindow(id);
+        }
+        RemoveFromIndices(window);
+        isTableDirty_ = true;
+        return true;
+    });
+
+    // queried after the index has the rects of this pass and no removed windows.
+    POINT cursorPos;
+    if (::GetCursorPos(&cursorPos))
+    {
+        cursorWindowId_ = spatialIndex_.QueryPoint(cursorPos);
+    }
+}
+
+
+void WindowManager::SetWindowFilter(const WindowFilterSettings& settings)
+{
+    if (windowTracker_)
+    {
+        windowTracker_->SetFilter(settings);
+    }
+}
+
+
+void WindowManager::ApplyMetadata()
+{
+    for (const auto& metadata : metadataResolver_->TakeResults())
+    {
+        const auto found = windows_.Find(metadata.windowId);
+        if (!found) continue;
+
+        const auto& window = *found;
+        if (window->GetHandle() != metadata.hWnd) continue;
+
+        if (metadata.hasAttributes)
+        {
+            auto& data2 = window->data2_;
+            data2.className = metadata.className;
+            data2.isAltTabWindow = metadata.isAltTabWindow;
+            data2.isApplicationFrameWindow = metadata.isApplicationFrameWindow;
+            data2.isUWP = metadata.isUWP;
+            window->UpdateIsBackground();
+        }
+
+        if (metadata.hasTitle)
+        {
+            window->SetTitle(metadata.title);
+        }
+        window->ReportCallTime(metadata.titleCallTime);
+
+        if (metadata.hasAttributes && !window->isMetadataResolved_)
+        {
+            window->isMetadataResolved_ = true;
+            window->notifiedTitleVersion_ = window->GetTitleVersion();
+            addedWindowIds_.push_back(window->GetId());
+        }
+    }
+}
+
+
+void WindowManager::NotifyWindowChanges(const std::shared_ptr<Window>& window, const Window::Data1& previous, const Window::Attributes& previousAttributes)
+{
+    const auto id = window->GetId();
+    const auto hWnd = window->GetHandle();
+    const auto& current = window->data1_;
+
+    if (!::EqualRect(&previous.windowRect, &current.windowRect))
+    {
+        const auto& rect = current.windowRect;
+        MessageManager::Get().Add({ MessageType::WindowMoved, id, hWnd, rect.left, rect.top, rect.right - rect.left, rect.bottom - rect.top });
+    }
+
+    if (previous.zOrder != current.zOrder)
+    {
+        MessageManager::Get().Add({ MessageType::WindowZOrderChanged, id, hWnd, static_cast<int>(current.zOrder) });
+    }
+
+    if (previous.isIconic != current.isIconic)
+    {
+        MessageManager::Get().Add({ MessageType::WindowIconicChanged, id, hWnd, current.isIconic ? 1 : 0 });
+    }
+
+    // desktops are identified by their monitors, so only windows can move between them.
+    if (!current.isDesktop && previous.hMonitor != current.hMonitor)
+    {
+        MessageManager::Get().Add({ MessageType::WindowMonitorChanged, id, current.hMonitor });
+    }
+
+    // titles can also be updated from the main thread, so compare with the last notified version.
+    const UINT titleVersion = window->GetTitleVersion();
+    if (window->notifiedTitleVersion_ != titleVersion)
+    {
+        window->notifiedTitleVersion_ = titleVersion;
+        MessageManager::Get().Add({ MessageType::WindowTitleChanged, id, hWnd, static_cast<int>(titleVersion) });
+    }
+
+    const auto attributes = window->GetAttributes();
+    if (attributes.isAltTabWindow != previousAttributes.isAltTabWindow ||
+        attributes.isUWP != previousAttributes.isUWP ||
+        attributes.isBackground != previousAttributes.isBackground ||
+        attributes.isTransparent != previousAttributes.isTransparent)
+    {
+        MessageManager::Get().Add({ MessageType::WindowAttributesChanged, id, hWnd, 
+            attributes.isAltTabWindow ? 1 : 0, 
+            attributes.isUWP ? 1 : 0, 
+            attributes.isBackground ? 1 : 0, 
+            attributes.isTransparent ? 1 : 0 });
+    }
+}
+
+
+void WindowManager::PublishSnapshot()
+{
+    auto snapshot = std::make_shared<WindowSnapshot>();
+    snapshot->entries.reserve(windows_.Size());
+
+    for (const auto& window : windows_)
+    {
+        if (!window->isMetadataResolved_) continue;
+
+        WindowSnapshotEntry entry;
+        ::ZeroMemory(&entry, sizeof(entry));
+
+        UINT flags = 0;
+        const auto setFlag = [&flags](WindowSnapshotFlag flag, bool value)
+        {
+            if (value) flags |= static_cast<UINT>(flag);
+        };
+        setFlag(WindowSnapshotFlag::Desktop, window->IsDesktop());
+        setFlag(WindowSnapshotFlag::Visible, window->IsVisible() != FALSE);
+        setFlag(WindowSnapshotFlag::Iconic, window->data1_.isIconic != FALSE);
+        setFlag(WindowSnapshotFlag::Zoomed, window->IsZoomed() != FALSE);
+        setFlag(WindowSnapshotFlag::Enabled, window->IsEnabled() != FALSE);
+        setFlag(WindowSnapshotFlag::AltTab, window->IsAltTab());
+        setFlag(WindowSnapshotFlag::ApplicationFrame, window->IsApplicationFrameWindow() != FALSE);
+        setFlag(WindowSnapshotFlag::UWP, window->IsUWP() != FALSE);
+        setFlag(WindowSnapshotFlag::Background, window->IsBackground() != FALSE);
+        setFlag(WindowSnapshotFlag::Quarantined, window->IsQuarantined());
+
+        entry.hWnd = window->GetHandle();
+        entry.hOwner = window->GetOwnerHandle();
+        entry.id = window->GetId();
+        entry.parentId = window->GetParentId();
+        entry.processId = window->GetProcessId();
+        entry.threadId = window->GetThreadId();
+        entry.x = window->GetWindowRect().left;
+        entry.y = window->GetWindowRect().top;
+        entry.width = window->GetWidth();
+        entry.height = window->GetHeight();
+        entry.clientWidth = window->GetClientWidth();
+        entry.clientHeight = window->GetClientHeight();
+        entry.zOrder = window->GetZOrder();
+        entry.flags = flags;
+        entry.textureWidth = window->GetTextureWidth();
+        entry.textureHeight = window->GetTextureHeight();
+        entry.textureOffsetX = window->GetTextureOffsetX();
+        entry.textureOffsetY = window->GetTextureOffsetY();
+        entry.iconWidth = window->GetIconWidth();
+        entry.iconHeight = window->GetIconHeight();
+        entry.titleVersion = window->GetTitleVersion();
+        snapshot->entries.push_back(entry);
+    }
+
+    std::lock_guard<std::mutex> lock(snapshotMutex_);
+
+    // the version only changes when something has changed, so readers can skip the copy.
+    const auto& previous = snapshot_->entries;
+    const bool hasChanged = 
+        previous.size() != snapshot->entries.size() ||
+        (!previous.empty() && memcmp(&previous[0], &snapshot->entries[0], previous.size() * sizeof(WindowSnapshotEntry)) != 0);
+    if (!hasChanged) return;
+
+    snapshot->version = snapshot_->version + 1;
+    snapshot_ = snapshot;
+}
+
+
+std::shared_ptr<const WindowSnapshot> WindowManager::GetSnapshot() const
+{
+    std::lock_guard<std::mutex> lock(snapshotMutex_);
+    return snapshot_;
+}
+
+
+void WindowManager::UpdateWindowHandleList()
+{
+    UWC_SCOPE_TIMER(UpdateWindowHandleList);
+
+    windowTracker_->Update(windowDataList_[1]);
+
+    for (const auto hWnd : windowTracker_->TakeTitleChangedWindows())
+    {
+        if (auto window = FindWindowFromHandle(hWnd))
+        {
+            window->RequestUpdateTitle();
+        }
+    }
+
+    std::sort(
+        windowDataList_[1].begin(), 
+        windowDataList_[1].end(), 
+        [](const auto& a, const auto& b) 
+        {
+            return 
+                a.hOwner == nullptr &&
+                b.hOwner != nullptr;
+        });
+
+    {
+        std::lock_guard<std::mutex> lock(windowsHandleListMutex_);
+        std::swap(windowDataList_[0], windowDataList_[1]);
+    }
+    windowDataList_[1].clear();
+}
+
+
+UINT WindowManager::RenderWindows(const std::vector<int>* targetIds)
+{
+    UINT copyCount = 0;
+    UINT64 copiedBytes = 0;
+
+    UINT budget = renderMetrics_.GetBudget();
+    if (budget == 0)
+    {
+        budget = renderQueue_.Size();
+    }
+    const UINT64 byteBudget = renderByteBudget_;
+
+    const auto isTarget = [targetIds](int id)
+    {
+        return !targetIds || std::find(targetIds->begin(), targetIds->end(), id) != targetIds->end();
+    };
+
+    // the windows over the budget stay in the queue and come first at the next event.
+    for (UINT i = 0; i < budget; ++i)
+    {
+        if (byteBudget > 0 && copiedBytes >= byteBudget) break;
+
+        const int id = renderQueue_.DequeueIf(isTarget);
+        if (id < 0) break;
+
+        auto window = GetWindow(id);
+        if (!window)
+        {
+            renderMetrics_.AddDropped();
+            continue;
+        }
+
+        ScopedTimer timer([this](std::chrono::microseconds us) 
+        { 
+            renderMetrics_.AddProcessed(us); 
+        });
+
+        if (window->Render())
+        {
+            copyCount++;
+            copiedBytes += static_cast<UINT64>(window->GetTextureWidth()) * window->GetTextureHeight() * 4;
+        }
+        else
+        {
+            renderMetrics_.AddDropped();
+        }
+    }
+
+    return copyCount;
+}
+
+
+void WindowManager::RequestRenderWindow(int id)
+{
+    renderQueue_.Enqueue(id);
+}
+
+
+bool WindowManager::CanRequestRenderWindow() const
+{
+    return !(renderQueue_.GetPolicy() == QueuePolicy::DropNewest && renderQueue_.Full());
+}
+
+
+void WindowManager::SetPipelineStageBudget(PipelineStage stage, UINT budget)
+{
+    switch (stage)
+    {
+        case PipelineStage::Capture:
+        {
+            if (captureManager_) captureManager_->SetBudget(budget);
+            break;
+        }
+        case PipelineStage::Upload:
+        {
+            if (uploadManager_) uploadManager_->SetBudget(budget);
+            break;
+        }
+        case PipelineStage::Render:
+        {
+            renderMetrics_.SetBudget(budget);
+            break;
+        }
+    }
+}
+
+
+void WindowManager::SetPipelineStageQueue(PipelineStage stage, UINT capacity, QueuePolicy policy)
+{
+    switch (stage)
+    {
+        case PipelineStage::Capture:
+        {
+            if (captureManager_) captureManager_->SetQueue(capacity, policy);
+            break;
+        }
+        case PipelineStage::Upload:
+        {
+            if (uploadManager_) uploadManager_->SetQueue(capacity, policy);
+            break;
+        }
+        case PipelineStage::Render:
+        {
+            renderQueue_.SetCapacity(capacity);
+            renderQueue_.SetPolicy(policy);
+            break;
+        }
+    }
+}
+
+
+bool WindowManager::GetPipelineStageStats(PipelineStage stage, PipelineStageStats* stats) const
+{
+    if (!stats) return false;
+
+    switch (stage)
+    {
+        case PipelineStage::Capture:
+        {
+            if (!captureManager_) return false;
+            captureManager_->GetStats(stats);
+            return true;
+        }
+        case PipelineStage::Upload:
+        {
+            if (!uploadManager_) return false;
+            uploadManager_->GetStats(stats);
+            return true;
+        }
+        case PipelineStage::Render:
+        {
+            renderMetrics_.GetStats(stats, renderQueue_.GetStats(), renderQueue_.GetCapacity());
+            return true;
+        }
+    }
+
+    return false;
+}
+
+
+void WindowManager::SetRenderByteBudget(UINT64 byteBudget)
+{
+    renderByteBudget_ = byteBudget;
+}
+
+
+void WindowManager::GetRenderStats(RenderStats* stats) const
+{
+    {
+        std::lock_guard<std::mutex> lock(renderStatsMutex_);
+        *stats = renderStats_;
+    }
+
+    stats->openedResourceCount = 0;
+    stats->reusedResourceCount = 0;
+    if (uploadManager_ && uploadManager_->GetBackend())
+    {
+        uploadManager_->GetBackend()->GetSharedResourceStats(&stats->openedResourceCount, &stats->reusedResourceCount);
+    }
 }
\ No newline at end of file
@@ -1,60 +1,137 @@
-#pragma once
-
-#include <Windows.h>
-#include <map>
-#include <vector>
-#include <deque>
-#include <memory>
-#include <mutex>
-
-#include "Singleton.h"
-#include "Thread.h"
-#include "CaptureManager.h"
-#include "UploadManager.h"
-#include "Window.h"
-#include "Cursor.h"
-
-
-class WindowManager
-{
-    UWC_SINGLETON(WindowManager)
-
-public:
-    void Initialize();
-    void Finalize();
-    void Update();
-    void Render();
-    bool CheckExistence(int id) const;
-    std::shared_ptr<Window> GetWindow(int id) const;
-    std::shared_ptr<Window> GetWindowFromPoint(POINT point) const;
-    std::shared_ptr<Window> GetCursorWindow() const;
-
-    static const std::unique_ptr<CaptureManager>& GetCaptureManager();
-    static const std::unique_ptr<UploadManager>& GetUploadManager();
-    static const std::unique_ptr<Cursor>& GetCursor();
-
-private:
-    std::shared_ptr<Window> FindParentWindow(const std::shared_ptr<Window>& window) const;
-    std::shared_ptr<Window> FindOrAddWindow(HWND hwnd);
-    std::shared_ptr<Window> FindOrAddDesktop(HMONITOR hMonitor);
-
-    void StartWindowHandleListThread();
-    void StopWindowHandleListThread();
-    void UpdateWindowHandleList();
-    void UpdateWindows();
-    void RenderWindows();
-
-    std::unique_ptr<CaptureManager> captureManager_;
-    std::unique_ptr<UploadManager> uploadManager_;
-    std::unique_ptr<Cursor> cursor_;
-
-    std::map<int, std::shared_ptr<Window>> windows_;
-    int lastWindowId_ = 0;
-    std::weak_ptr<Window> cursorWindow_;
-
-    ThreadLoop windowHandleListThreadLoop_;
-
-    std::vector<Window::Data1> windowDataList_[2];
-    mutable std::mutex windowsHandleListMutex_;
-};
-
+#pragma once
+
+#include <Windows.h>
+#include <map>
+#include <unordered_map>
+#include <set>
+#include <vector>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <atomic>
+
+#include "Singleton.h"
+#include "Thread.h"
+#include "CaptureManager.h"
+#include "UploadManager.h"
+#include "Pipeline.h"
+#include "FrameClock.h"
+#include "Window.h"
+#include "Cursor.h"
+#include "WindowSystem.h"
+#include "WindowTracker.h"
+#include "SpatialIndex.h"
+#include "WindowSnapshot.h"
+#include "MetadataResolver.h"
+#include "SlotMap.h"
+#include "ThumbnailAtlas.h"
+#include "IconCache.h"
+
+
+// Read-only copy of the window table published by the window thread.
+// Readers on the other threads load the latest table atomically and never see it change,
+// and removed windows are released when the last table (or reader) holding them goes away.
+struct WindowTable
+{
+    SlotMap<std::shared_ptr<Window>> windows;
+    std::unordered_map<HWND, int> windowIdsByHandle;
+    std::unordered_map<DWORD, std::vector<int>> windowIdsByProcess;
+};
+
+
+class WindowManager
+{
+    UWC_SINGLETON(WindowManager)
+
+public:
+    void Initialize();
+    void Finalize();
+    void Update();
+    void Render(int eventId);
+    bool CheckExistence(int id) const;
+    std::shared_ptr<Window> GetWindow(int id) const;
+    std::shared_ptr<Window> GetWindowFromHandle(HWND hWnd) const;
+    std::shared_ptr<Window> GetWindowFromPoint(POINT point) const;
+    void GetWindowIdsFromPoints(const POINT* points, UINT count, int* outIds) const;
+    std::vector<int> GetWindowIdsInRect(const RECT& rect) const;
+    std::vector<int> GetWindowsOfProcess(DWORD processId) const;
+    std::shared_ptr<const WindowSnapshot> GetSnapshot() const;
+    std::shared_ptr<Window> GetCursorWindow() const;
+    void SetWindowFilter(const WindowFilterSettings& settings);
+
+    void RequestRenderWindow(int id);
+    bool CanRequestRenderWindow() const;
+
+    void SetPipelineStageBudget(PipelineStage stage, UINT budget);
+    void SetPipelineStageQueue(PipelineStage stage, UINT capacity, QueuePolicy policy);
+    bool GetPipelineStageStats(PipelineStage stage, PipelineStageStats* stats) const;
+    void GetRenderStats(RenderStats* stats) const;
+    void SetRenderByteBudget(UINT64 byteBudget);
+
+    static const std::unique_ptr<CaptureManager>& GetCaptureManager();
+    static const std::unique_ptr<UploadManager>& GetUploadManager();
+    static const std::unique_ptr<Cursor>& GetCursor();
+    static const std::unique_ptr<ThumbnailAtlas>& GetThumbnailAtlas();
+    static const std::unique_ptr<IconCache>& GetIconCache();
+    static std::shared_ptr<const ProcessInfo> GetProcessInfo(DWORD processId);
+    static FrameClock& GetFrameClock();
+
+private:
+    std::shared_ptr<const WindowTable> GetTable() const;
+    void PublishTable();
+    void NotifyAddedWindows();
+    std::shared_ptr<Window> FindWindowFromHandle(HWND hWnd) const;
+    std::shared_ptr<Window> FindParentWindow(const std::shared_ptr<Window>& window) const;
+    std::shared_ptr<Window> FindOrAddWindow(HWND hwnd);
+    std::shared_ptr<Window> FindOrAddDesktop(HMONITOR hMonitor);
+    void AddToThreadIndex(const std::shared_ptr<Window>& window);
+    void RemoveFromIndices(const std::shared_ptr<Window>& window);
+    const std::set<int>* GetWindowsOfThread(DWORD processId, DWORD threadId) const;
+
+    void StartWindowHandleListThread();
+    void StopWindowHandleListThread();
+    void UpdateWindowHandleList();
+    void UpdateWindows();
+    UINT RenderFrame();
+    UINT RenderWindows(const std::vector<int>* targetIds);
+    void PublishSnapshot();
+    void ApplyMetadata();
+    void NotifyWindowChanges(const std::shared_ptr<Window>& window, const Window::Data1& previous, const Window::Attributes& previousAttributes);
+
+    std::unique_ptr<CaptureManager> captureManager_;
+    std::unique_ptr<UploadManager> uploadManager_;
+    std::unique_ptr<Cursor> cursor_;
+    std::unique_ptr<ThumbnailAtlas> thumbnailAtlas_;
+    std::unique_ptr<IconCache> iconCache_;
+    std::unique_ptr<IWindowSystem> windowSystem_;
+    std::unique_ptr<WindowTracker> windowTracker_;
+    std::unique_ptr<MetadataResolver> metadataResolver_;
+
+    // touched only by the window thread, the other threads read table_ instead.
+    SlotMap<std::shared_ptr<Window>> windows_; // window ids are the generational ids of this map
+    std::unordered_map<HWND, int> windowIdsByHandle_; // desktops share the same handle, so they are not included.
+    std::unordered_map<HMONITOR, int> desktopIdsByMonitor_;
+    std::map<std::pair<DWORD, DWORD>, std::set<int>> windowIdsByThread_; // (processId, threadId)
+    SpatialIndex spatialIndex_;
+    std::atomic<int> cursorWindowId_ = -1;
+
+    std::shared_ptr<const WindowTable> table_ = std::make_shared<WindowTable>(); // use std::atomic_load() / std::atomic_store()
+    bool isTableDirty_ = false;
+    std::vector<int> addedWindowIds_;
+
+    std::shared_ptr<const WindowSnapshot> snapshot_ = std::make_shared<WindowSnapshot>();
+    mutable std::mutex snapshotMutex_;
+
+    WindowQueue renderQueue_;
+    StageMetrics renderMetrics_ { 0 /* unlimited */ };
+    std::atomic<UINT64> renderByteBudget_ = 0; // per render event, 0 means unlimited
+    RenderStats renderStats_ = {};
+    mutable std::mutex renderStatsMutex_;
+    FrameClock frameClock_;
+
+    ThreadLoop windowHandleListThreadLoop_;
+
+    std::vector<Window::Data1> windowDataList_[2];
+    mutable std::mutex windowsHandleListMutex_;
+};
+
@@ -1,33 +1,156 @@
-#include <algorithm>
-#include "WindowQueue.h"
-
-
-
-void WindowQueue::Enqueue(int id)
-{
-    std::lock_guard<std::mutex> lock(mutex_);
-
-    const auto it = std::find(queue_.begin(), queue_.end(), id);
-    if (it == queue_.end())
-    {
-        queue_.push_front(id);
-    }
-}
-
-
-int WindowQueue::Dequeue()
-{
-    std::lock_guard<std::mutex> lock(mutex_);
-
-    if (queue_.empty()) return -1;
-
-    const auto id = queue_.back();
-    queue_.pop_back();
-    return id;
-}
-
-
-bool WindowQueue::Empty() const
-{
-    return queue_.empty();
-}
\ No newline at end of file
+#include <algorithm>
+#include "WindowQueue.h"
+
+
+
+void WindowQueue::SetCapacity(UINT capacity)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    capacity_ = capacity;
+
+    while (capacity_ > 0 && queue_.size() > capacity_)
+    {
+        queue_.pop_back();
+        stats_.dropped++;
+    }
+}
+
+
+UINT WindowQueue::GetCapacity() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return capacity_;
+}
+
+
+void WindowQueue::SetPolicy(QueuePolicy policy)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    policy_ = policy;
+}
+
+
+QueuePolicy WindowQueue::GetPolicy() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return policy_;
+}
+
+
+bool WindowQueue::Enqueue(int id)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    const auto it = std::find_if(
+        queue_.begin(),
+        queue_.end(),
+        [id](const Item& item) { return item.id == id; });
+    if (it != queue_.end())
+    {
+        stats_.coalesced++;
+        return true;
+    }
+
+    if (capacity_ > 0 && queue_.size() >= capacity_)
+    {
+        stats_.dropped++;
+
+        switch (policy_)
+        {
+            case QueuePolicy::DropOldest:
+            {
+                queue_.pop_back();
+                break;
+            }
+            case QueuePolicy::DropNewest:
+            {
+                return false;
+            }
+        }
+    }
+
+    queue_.push_front({ id, clock::now() });
+
+    stats_.enqueued++;
+    stats_.depth = static_cast<UINT>(queue_.size());
+    stats_.maxDepth = max(stats_.maxDepth, stats_.depth);
+
+    return true;
+}
+
+
+int WindowQueue::Dequeue()
+{
+    return DequeueIf([](int) { return true; });
+}
+
+
+int WindowQueue::DequeueIf(const std::function<bool(int)>& pred)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    const auto it = std::find_if(
+        queue_.rbegin(),
+        queue_.rend(),
+        [&pred](const Item& item) { return pred(item.id); });
+    if (it == queue_.rend()) return -1;
+
+    const auto item = *it;
+    queue_.erase(std::next(it).base());
+
+    const auto waitTime = std::chrono::duration_cast<microseconds>(clock::now() - item.time);
+    stats_.dequeued++;
+    stats_.depth = static_cast<UINT>(queue_.size());
+    stats_.totalWaitTime += waitTime;
+    stats_.maxWaitTime = max(stats_.maxWaitTime, waitTime);
+
+    return item.id;
+}
+
+
+bool WindowQueue::Remove(int id)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    const auto it = std::find_if(
+        queue_.begin(),
+        queue_.end(),
+        [id](const Item& item) { return item.id == id; });
+    if (it == queue_.end()) return false;
+
+    queue_.erase(it);
+
+    stats_.coalesced++;
+    stats_.depth = static_cast<UINT>(queue_.size());
+
+    return true;
+}
+
+
+bool WindowQueue::Empty() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return queue_.empty();
+}
+
+
+bool WindowQueue::Full() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return capacity_ > 0 && queue_.size() >= capacity_;
+}
+
+
+UINT WindowQueue::Size() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return static_cast<UINT>(queue_.size());
+}
+
+
+WindowQueue::Stats WindowQueue::GetStats() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+}
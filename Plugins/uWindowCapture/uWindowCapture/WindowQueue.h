@@ -1,17 +1,64 @@
-#pragma once
-
-#include <deque>
-#include <mutex>
-
-
-class WindowQueue
-{
-public:
-    void Enqueue(int id);
-    int Dequeue();
-    bool Empty() const;
-
-private:
-    std::mutex mutex_;
-    std::deque<int> queue_;
-};
+#pragma once
+
+#include <Windows.h>
+#include <deque>
+#include <mutex>
+#include <chrono>
+#include <functional>
+
+
+// A window owns a single frame buffer, so pending requests for the same window
+// are always coalesced (latest wins). The policy decides what happens when the
+// queue itself is full.
+enum class QueuePolicy
+{
+    DropOldest = 0, // discard the oldest request to accept the new one.
+    DropNewest = 1, // refuse the new request so that the producer backs off.
+};
+
+
+class WindowQueue
+{
+public:
+    using clock = std::chrono::steady_clock;
+    using microseconds = std::chrono::microseconds;
+
+    struct Stats
+    {
+        UINT depth = 0;
+        UINT maxDepth = 0;
+        UINT64 enqueued = 0;
+        UINT64 dequeued = 0;
+        UINT64 dropped = 0;
+        UINT64 coalesced = 0;
+        microseconds totalWaitTime = microseconds::zero();
+        microseconds maxWaitTime = microseconds::zero();
+    };
+
+    void SetCapacity(UINT capacity);
+    UINT GetCapacity() const;
+    void SetPolicy(QueuePolicy policy);
+    QueuePolicy GetPolicy() const;
+
+    bool Enqueue(int id);
+    int Dequeue();
+    int DequeueIf(const std::function<bool(int)>& pred); // the oldest one which satisfies pred
+    bool Remove(int id); // coalesced into a request made elsewhere
+    bool Empty() const;
+    bool Full() const;
+    UINT Size() const;
+    Stats GetStats() const;
+
+private:
+    struct Item
+    {
+        int id;
+        clock::time_point time;
+    };
+
+    mutable std::mutex mutex_;
+    std::deque<Item> queue_;
+    UINT capacity_ = 0; // 0 means unbounded.
+    QueuePolicy policy_ = QueuePolicy::DropOldest;
+    Stats stats_;
+};
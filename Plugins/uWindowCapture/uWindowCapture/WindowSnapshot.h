@@ -0,0 +1,55 @@
+#pragma once
+
+#include <Windows.h>
+#include <vector>
+
+
+enum class WindowSnapshotFlag : UINT
+{
+    Desktop = 1 << 0,
+    Visible = 1 << 1,
+    Iconic = 1 << 2,
+    Zoomed = 1 << 3,
+    Enabled = 1 << 4,
+    AltTab = 1 << 5,
+    ApplicationFrame = 1 << 6,
+    UWP = 1 << 7,
+    Background = 1 << 8,
+    Quarantined = 1 << 9,
+};
+
+
+// Packed properties of a window. Titles are not included since they are variable length,
+// so titleVersion tells when the title has to be fetched again.
+struct WindowSnapshotEntry
+{
+    HWND hWnd;
+    HWND hOwner;
+    int id;
+    int parentId;
+    DWORD processId;
+    DWORD threadId;
+    int x;
+    int y;
+    UINT width;
+    UINT height;
+    UINT clientWidth;
+    UINT clientHeight;
+    UINT zOrder;
+    UINT flags; // WindowSnapshotFlag
+    UINT textureWidth;
+    UINT textureHeight;
+    UINT textureOffsetX;
+    UINT textureOffsetY;
+    UINT iconWidth;
+    UINT iconHeight;
+    UINT titleVersion;
+};
+
+
+// Immutable once published, so readers can copy it without holding any lock on the windows.
+struct WindowSnapshot
+{
+    UINT64 version = 0;
+    std::vector<WindowSnapshotEntry> entries;
+};
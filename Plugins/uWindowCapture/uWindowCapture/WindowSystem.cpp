@@ -0,0 +1,361 @@
+#include <dwmapi.h>
+#include "WindowSystem.h"
+#include "WindowFilter.h"
+#include "Util.h"
+#include "Debug.h"
+
+
+
+namespace
+{
+    // WinEvent callbacks have no user data, but they are called on the thread which has set the hooks.
+    thread_local Win32WindowSystem* t_eventWindowSystem = nullptr;
+
+    const std::pair<DWORD, DWORD> kHookedEventRanges[] =
+    {
+        { EVENT_SYSTEM_FOREGROUND, EVENT_SYSTEM_FOREGROUND },
+        { EVENT_SYSTEM_MOVESIZEEND, EVENT_SYSTEM_MOVESIZEEND },
+        { EVENT_SYSTEM_MINIMIZESTART, EVENT_SYSTEM_MINIMIZEEND },
+        { EVENT_OBJECT_CREATE, EVENT_OBJECT_REORDER },
+        { EVENT_OBJECT_LOCATIONCHANGE, EVENT_OBJECT_NAMECHANGE },
+    };
+}
+
+
+// ---
+
+
+Win32WindowSystem::~Win32WindowSystem()
+{
+    StopEvents();
+}
+
+
+bool Win32WindowSystem::StartEvents(const EventFunc& func)
+{
+    if (eventThread_.joinable()) return true;
+
+    eventFunc_ = func;
+
+    std::promise<bool> started;
+    auto future = started.get_future();
+    eventThread_ = std::thread([this, &started] { RunEventLoop(started); });
+
+    if (!future.get())
+    {
+        eventThread_.join();
+        return false;
+    }
+
+    return true;
+}
+
+
+void Win32WindowSystem::StopEvents()
+{
+    if (!eventThread_.joinable()) return;
+
+    ::PostThreadMessage(eventThreadId_, WM_QUIT, 0, 0);
+    eventThread_.join();
+    eventThreadId_ = 0;
+}
+
+
+void Win32WindowSystem::RunEventLoop(std::promise<bool>& started)
+{
+    t_eventWindowSystem = this;
+    eventThreadId_ = ::GetCurrentThreadId();
+
+    // make the message queue before anyone posts WM_QUIT to it.
+    MSG msg;
+    ::PeekMessage(&msg, NULL, 0, 0, PM_NOREMOVE);
+
+    std::vector<HWINEVENTHOOK> hooks;
+    for (const auto& range : kHookedEventRanges)
+    {
+        const auto hook = ::SetWinEventHook(range.first, range.second, NULL, OnWinEvent, 0, 0, WINEVENT_OUTOFCONTEXT);
+        if (!hook)
+        {
+            OutputApiError(__FUNCTION__, "SetWinEventHook");
+            break;
+        }
+        hooks.push_back(hook);
+    }
+
+    const bool hasHooked = hooks.size() == _countof(kHookedEventRanges);
+    started.set_value(hasHooked);
+
+    if (hasHooked)
+    {
+        while (::GetMessage(&msg, NULL, 0, 0) > 0)
+        {
+            ::TranslateMessage(&msg);
+            ::DispatchMessage(&msg);
+        }
+    }
+
+    for (const auto hook : hooks)
+    {
+        ::UnhookWinEvent(hook);
+    }
+    t_eventWindowSystem = nullptr;
+}
+
+
+void CALLBACK Win32WindowSystem::OnWinEvent(HWINEVENTHOOK hook, DWORD event, HWND hWnd, LONG idObject, LONG idChild, DWORD threadId, DWORD time)
+{
+    auto thiz = t_eventWindowSystem;
+    if (!thiz || !thiz->eventFunc_) return;
+
+    if (idObject != OBJID_WINDOW || idChild != CHILDID_SELF || !hWnd) return;
+
+    // a destroyed window cannot be checked anymore, so the receiver filters them.
+    switch (event)
+    {
+        case EVENT_OBJECT_DESTROY:
+            thiz->eventFunc_(WindowSystemEvent::Destroyed, hWnd);
+            break;
+        case EVENT_OBJECT_REORDER:
+            // raised on the parent whose children have been reordered.
+            if (hWnd == ::GetDesktopWindow()) thiz->eventFunc_(WindowSystemEvent::Reordered, hWnd);
+            break;
+        case EVENT_SYSTEM_FOREGROUND:
+            thiz->eventFunc_(WindowSystemEvent::Reordered, hWnd);
+            break;
+        default:
+            break;
+    }
+
+    if (::GetAncestor(hWnd, GA_ROOT) != hWnd) return;
+
+    switch (event)
+    {
+        case EVENT_OBJECT_CREATE:
+            thiz->eventFunc_(WindowSystemEvent::Created, hWnd);
+            break;
+        case EVENT_OBJECT_SHOW:
+            thiz->eventFunc_(WindowSystemEvent::Shown, hWnd);
+            break;
+        case EVENT_OBJECT_HIDE:
+            thiz->eventFunc_(WindowSystemEvent::Hidden, hWnd);
+            break;
+        case EVENT_OBJECT_LOCATIONCHANGE:
+        case EVENT_SYSTEM_MOVESIZEEND:
+            thiz->eventFunc_(WindowSystemEvent::Moved, hWnd);
+            break;
+        case EVENT_SYSTEM_MINIMIZESTART:
+            thiz->eventFunc_(WindowSystemEvent::Minimized, hWnd);
+            break;
+        case EVENT_SYSTEM_MINIMIZEEND:
+            thiz->eventFunc_(WindowSystemEvent::Restored, hWnd);
+            break;
+        case EVENT_OBJECT_NAMECHANGE:
+            thiz->eventFunc_(WindowSystemEvent::TitleChanged, hWnd);
+            break;
+        default:
+            break;
+    }
+}
+
+
+bool Win32WindowSystem::EnumerateWindows(const WindowFunc& func) const
+{
+    static const auto _EnumWindowsCallback = [](HWND hWnd, LPARAM lParam) -> BOOL
+    {
+        const auto& func = *reinterpret_cast<const WindowFunc*>(lParam);
+        func(hWnd);
+        return TRUE;
+    };
+
+    using EnumWindowsCallbackType = BOOL(CALLBACK *)(HWND, LPARAM);
+    static const auto EnumWindowsCallback = static_cast<EnumWindowsCallbackType>(_EnumWindowsCallback);
+    if (!::EnumWindows(EnumWindowsCallback, reinterpret_cast<LPARAM>(&func)))
+    {
+        OutputApiError(__FUNCTION__, "EnumWindows");
+        return false;
+    }
+
+    return true;
+}
+
+
+bool Win32WindowSystem::EnumerateMonitors(const MonitorFunc& func) const
+{
+    static const auto _EnumDisplayMonitorsCallback = [](HMONITOR hMonitor, HDC hDc, LPRECT lpRect, LPARAM lParam) -> BOOL
+    {
+        const auto& func = *reinterpret_cast<const MonitorFunc*>(lParam);
+        func(hMonitor, *lpRect);
+        return TRUE;
+    };
+
+    using EnumDisplayMonitorsCallbackType = BOOL(CALLBACK *)(HMONITOR, HDC, LPRECT, LPARAM);
+    static const auto EnumDisplayMonitorsCallback = static_cast<EnumDisplayMonitorsCallbackType>(_EnumDisplayMonitorsCallback);
+    if (!::EnumDisplayMonitors(NULL, NULL, EnumDisplayMonitorsCallback, reinterpret_cast<LPARAM>(&func)))
+    {
+        OutputApiError(__FUNCTION__, "EnumDisplayMonitors");
+        return false;
+    }
+
+    return true;
+}
+
+
+bool Win32WindowSystem::IsWindow(HWND hWnd) const
+{
+    return ::IsWindow(hWnd) != FALSE;
+}
+
+
+bool Win32WindowSystem::IsWindowVisible(HWND hWnd) const
+{
+    return ::IsWindowVisible(hWnd) != FALSE;
+}
+
+
+bool Win32WindowSystem::IsHungAppWindow(HWND hWnd) const
+{
+    return ::IsHungAppWindow(hWnd) != FALSE;
+}
+
+
+bool Win32WindowSystem::IsIconic(HWND hWnd) const
+{
+    return ::IsIconic(hWnd) != FALSE;
+}
+
+
+bool Win32WindowSystem::IsCloaked(HWND hWnd) const
+{
+    int cloaked = 0;
+    if (FAILED(::DwmGetWindowAttribute(hWnd, DWMWA_CLOAKED, &cloaked, sizeof(cloaked)))) return false;
+    return cloaked != 0;
+}
+
+
+bool Win32WindowSystem::IsAltTabWindow(HWND hWnd) const
+{
+    return ::IsAltTabWindow(hWnd);
+}
+
+
+DWORD Win32WindowSystem::GetProcessId(HWND hWnd) const
+{
+    DWORD processId = 0;
+    ::GetWindowThreadProcessId(hWnd, &processId);
+    return processId;
+}
+
+
+std::wstring Win32WindowSystem::GetWindowClass(HWND hWnd) const
+{
+    WCHAR buf[256];
+    const int len = ::GetClassNameW(hWnd, buf, _countof(buf));
+    return std::wstring(buf, max(len, 0));
+}
+
+
+std::wstring Win32WindowSystem::GetTitle(HWND hWnd) const
+{
+    // GetWindowText() reads the cached text of windows in other processes without sending WM_GETTEXT.
+    WCHAR buf[256];
+    const int len = ::GetWindowTextW(hWnd, buf, _countof(buf));
+    return std::wstring(buf, max(len, 0));
+}
+
+
+HWND Win32WindowSystem::GetOwner(HWND hWnd) const
+{
+    return ::GetWindow(hWnd, GW_OWNER);
+}
+
+
+void Win32WindowSystem::GetWindowRect(HWND hWnd, RECT* rect) const
+{
+    ::GetWindowRect(hWnd, rect);
+}
+
+
+void Win32WindowSystem::GetClientRect(HWND hWnd, RECT* rect) const
+{
+    ::GetClientRect(hWnd, rect);
+}
+
+
+HMONITOR Win32WindowSystem::GetMonitor(HWND hWnd) const
+{
+    return ::MonitorFromWindow(hWnd, MONITOR_DEFAULTTOPRIMARY);
+}
+
+
+HWND Win32WindowSystem::GetDesktopWindow() const
+{
+    return ::GetDesktopWindow();
+}
+
+
+// ---
+
+
+bool EnumerateWindowData(const IWindowSystem& system, std::vector<Window::Data1>& outList, WindowFilter* filter)
+{
+    UINT zOrder = 0;
+
+    if (filter)
+    {
+        filter->BeginPass();
+    }
+
+    const bool hasEnumeratedWindows = system.EnumerateWindows([&](HWND hWnd)
+    {
+        if (!system.IsWindow(hWnd) || !system.IsWindowVisible(hWnd))
+        {
+            return;
+        }
+
+        // hung and filtered windows are skipped but still occupy their place in the z-order.
+        const UINT currentZOrder = zOrder++;
+
+        Window::Data1 data;
+        system.GetWindowRect(hWnd, &data.windowRect);
+        if (filter && !filter->Accept(system, hWnd, data.windowRect))
+        {
+            return;
+        }
+
+        if (system.IsHungAppWindow(hWnd))
+        {
+            return;
+        }
+
+        data.hWnd = hWnd;
+        data.hOwner = system.GetOwner(hWnd);
+        system.GetClientRect(hWnd, &data.clientRect);
+        data.zOrder = currentZOrder;
+        data.hMonitor = system.GetMonitor(hWnd);
+        data.isIconic = system.IsIconic(hWnd);
+        data.isDesktop = false;
+        outList.push_back(data);
+    });
+
+    const auto hDesktop = system.GetDesktopWindow();
+    const bool hasEnumeratedMonitors = system.EnumerateMonitors([&](HMONITOR hMonitor, const RECT& rect)
+    {
+        Window::Data1 data;
+        data.hWnd = hDesktop;
+        data.hOwner = NULL;
+        data.windowRect = rect;
+        data.clientRect = rect;
+        data.zOrder = 0;
+        data.hMonitor = hMonitor;
+        data.isIconic = false;
+        data.isDesktop = true;
+        outList.push_back(data);
+    });
+
+    if (filter)
+    {
+        filter->EndPass();
+    }
+
+    return hasEnumeratedWindows && hasEnumeratedMonitors;
+}
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <Windows.h>
+#include <functional>
+#include <vector>
+#include <thread>
+#include <future>
+#include <string>
+
+#include "Window.h"
+
+
+class WindowFilter;
+
+
+enum class WindowSystemEvent
+{
+    Created = 0,
+    Destroyed = 1,
+    Shown = 2,
+    Hidden = 3,
+    Moved = 4,
+    Reordered = 5,
+    Minimized = 6,
+    Restored = 7,
+    TitleChanged = 8,
+};
+
+
+// Abstracts the Win32 calls used to enumerate and track windows so that the
+// enumeration logic can also be driven by a fake window stack.
+class IWindowSystem
+{
+public:
+    using WindowFunc = std::function<void(HWND)>;
+    using MonitorFunc = std::function<void(HMONITOR, const RECT&)>;
+    using EventFunc = std::function<void(WindowSystemEvent, HWND)>;
+
+    virtual ~IWindowSystem() {}
+
+    // returns false if change events are not available, then the caller has to poll.
+    // func is called from a thread owned by the window system.
+    virtual bool StartEvents(const EventFunc& func) = 0;
+    virtual void StopEvents() = 0;
+
+    // top-level windows are given from the top of the z-order to the bottom.
+    virtual bool EnumerateWindows(const WindowFunc& func) const = 0;
+    virtual bool EnumerateMonitors(const MonitorFunc& func) const = 0;
+
+    virtual bool IsWindow(HWND hWnd) const = 0;
+    virtual bool IsWindowVisible(HWND hWnd) const = 0;
+    virtual bool IsHungAppWindow(HWND hWnd) const = 0;
+    virtual bool IsIconic(HWND hWnd) const = 0;
+    virtual bool IsCloaked(HWND hWnd) const = 0;
+    virtual bool IsAltTabWindow(HWND hWnd) const = 0;
+    virtual DWORD GetProcessId(HWND hWnd) const = 0;
+    virtual std::wstring GetWindowClass(HWND hWnd) const = 0;
+    virtual std::wstring GetTitle(HWND hWnd) const = 0; // must not block on hung windows
+    virtual HWND GetOwner(HWND hWnd) const = 0;
+    virtual void GetWindowRect(HWND hWnd, RECT* rect) const = 0;
+    virtual void GetClientRect(HWND hWnd, RECT* rect) const = 0;
+    virtual HMONITOR GetMonitor(HWND hWnd) const = 0;
+    virtual HWND GetDesktopWindow() const = 0;
+};
+
+
+class Win32WindowSystem : public IWindowSystem
+{
+public:
+    ~Win32WindowSystem();
+
+    bool StartEvents(const EventFunc& func) override;
+    void StopEvents() override;
+
+    bool EnumerateWindows(const WindowFunc& func) const override;
+    bool EnumerateMonitors(const MonitorFunc& func) const override;
+
+    bool IsWindow(HWND hWnd) const override;
+    bool IsWindowVisible(HWND hWnd) const override;
+    bool IsHungAppWindow(HWND hWnd) const override;
+    bool IsIconic(HWND hWnd) const override;
+    bool IsCloaked(HWND hWnd) const override;
+    bool IsAltTabWindow(HWND hWnd) const override;
+    DWORD GetProcessId(HWND hWnd) const override;
+    std::wstring GetWindowClass(HWND hWnd) const override;
+    std::wstring GetTitle(HWND hWnd) const override;
+    HWND GetOwner(HWND hWnd) const override;
+    void GetWindowRect(HWND hWnd, RECT* rect) const override;
+    void GetClientRect(HWND hWnd, RECT* rect) const override;
+    HMONITOR GetMonitor(HWND hWnd) const override;
+    HWND GetDesktopWindow() const override;
+
+private:
+    static void CALLBACK OnWinEvent(HWINEVENTHOOK hook, DWORD event, HWND hWnd, LONG idObject, LONG idChild, DWORD threadId, DWORD time);
+    void RunEventLoop(std::promise<bool>& started);
+
+    EventFunc eventFunc_;
+    std::thread eventThread_;
+    DWORD eventThreadId_ = 0;
+};
+
+
+// Collects the windows and the desktops in a single pass.
+// The z-order of a window is the number of visible windows above it,
+// which is derived from the enumeration order instead of walking GW_HWNDPREV.
+// Windows rejected by the filter are skipped before any other query but keep their place in the z-order.
+bool EnumerateWindowData(const IWindowSystem& system, std::vector<Window::Data1>& outList, WindowFilter* filter = nullptr);
@@ -0,0 +1,184 @@
+#include "WindowTracker.h"
+
+
+
+namespace
+{
+    constexpr int kReconcileInterval = 1000; // [ms]
+}
+
+
+// ---
+
+
+WindowTracker::WindowTracker(IWindowSystem& system, MetadataResolver& resolver)
+    : system_(system)
+    , filter_(resolver)
+{
+    isEventDriven_ = system_.StartEvents([this](WindowSystemEvent event, HWND hWnd)
+    {
+        OnEvent(event, hWnd);
+    });
+}
+
+
+WindowTracker::~WindowTracker()
+{
+    system_.StopEvents();
+}
+
+
+bool WindowTracker::IsEventDriven() const
+{
+    return isEventDriven_;
+}
+
+
+bool WindowTracker::IsTracked(HWND hWnd) const
+{
+    return trackedWindows_.find(hWnd) != trackedWindows_.end();
+}
+
+
+void WindowTracker::OnEvent(WindowSystemEvent event, HWND hWnd)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        switch (event)
+        {
+            case WindowSystemEvent::Created:
+            {
+                // windows are usually created hidden, so wait for them to be shown.
+                return;
+            }
+            case WindowSystemEvent::Shown:
+            case WindowSystemEvent::Reordered:
+            {
+                needsEnumeration_ = true;
+                break;
+            }
+            case WindowSystemEvent::Destroyed:
+            case WindowSystemEvent::Hidden:
+            {
+                // child windows come and go all the time, so ignore the ones not in the list.
+                if (!IsTracked(hWnd)) return;
+                needsEnumeration_ = true;
+                break;
+            }
+            case WindowSystemEvent::Moved:
+            case WindowSystemEvent::Minimized:
+            case WindowSystemEvent::Restored:
+            {
+                if (!IsTracked(hWnd)) return;
+                movedWindows_.insert(hWnd);
+                break;
+            }
+            case WindowSystemEvent::TitleChanged:
+            {
+                if (!IsTracked(hWnd)) return;
+                titleChangedWindows_.push_back(hWnd);
+                break;
+            }
+        }
+    }
+
+    cv_.notify_all();
+}
+
+
+void WindowTracker::WaitForChanges(milliseconds timeout)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    cv_.wait_for(lock, timeout, [this]
+    {
+        return needsEnumeration_ || !movedWindows_.empty() || !titleChangedWindows_.empty();
+    });
+}
+
+
+void WindowTracker::Update(std::vector<Window::Data1>& outList)
+{
+    bool needsEnumeration = false;
+    std::unordered_set<HWND> movedWindows;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        needsEnumeration = needsEnumeration_;
+        needsEnumeration_ = false;
+        movedWindows.swap(movedWindows_);
+    }
+
+    const auto now = clock::now();
+    if (!isEventDriven_ || needsEnumeration || now - lastEnumerationTime_ >= milliseconds(kReconcileInterval))
+    {
+        Enumerate();
+        lastEnumerationTime_ = now;
+    }
+    else
+    {
+        for (const auto hWnd : movedWindows)
+        {
+            Refresh(hWnd);
+        }
+    }
+
+    outList = dataList_;
+}
+
+
+std::vector<HWND> WindowTracker::TakeTitleChangedWindows()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<HWND> windows;
+    windows.swap(titleChangedWindows_);
+    return windows;
+}
+
+
+void WindowTracker::SetFilter(const WindowFilterSettings& settings)
+{
+    filter_.SetSettings(settings);
+
+    // windows which do not pass the new filter are removed by the next enumeration.
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        needsEnumeration_ = true;
+    }
+    cv_.notify_all();
+}
+
+
+void WindowTracker::Enumerate()
+{
+    dataList_.clear();
+    dataIndices_.clear();
+
+    EnumerateWindowData(system_, dataList_, &filter_);
+
+    std::unordered_set<HWND> trackedWindows;
+    for (size_t i = 0; i < dataList_.size(); ++i)
+    {
+        const auto& data = dataList_[i];
+        if (data.isDesktop) continue;
+
+        dataIndices_[data.hWnd] = i;
+        trackedWindows.insert(data.hWnd);
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    trackedWindows_.swap(trackedWindows);
+}
+
+
+void WindowTracker::Refresh(HWND hWnd)
+{
+    const auto it = dataIndices_.find(hWnd);
+    if (it == dataIndices_.end()) return;
+
+    auto& data = dataList_[it->second];
+    system_.GetWindowRect(hWnd, &data.windowRect);
+    system_.GetClientRect(hWnd, &data.clientRect);
+    data.hMonitor = system_.GetMonitor(hWnd);
+    data.isIconic = system_.IsIconic(hWnd);
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <Windows.h>
+#include <chrono>
+#include <mutex>
+#include <condition_variable>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "WindowSystem.h"
+#include "WindowFilter.h"
+
+
+// Keeps the list of windows up to date from the change events of the window system.
+// A full enumeration only runs when windows may have been added, removed or reordered,
+// and periodically as a safety net for missed events. Moved windows are refreshed one by one.
+class WindowTracker
+{
+public:
+    using clock = std::chrono::steady_clock;
+    using milliseconds = std::chrono::milliseconds;
+
+    WindowTracker(IWindowSystem& system, MetadataResolver& resolver);
+    ~WindowTracker();
+
+    bool IsEventDriven() const;
+    void WaitForChanges(milliseconds timeout);
+    void Update(std::vector<Window::Data1>& outList);
+    std::vector<HWND> TakeTitleChangedWindows();
+    void SetFilter(const WindowFilterSettings& settings);
+
+private:
+    void OnEvent(WindowSystemEvent event, HWND hWnd);
+    bool IsTracked(HWND hWnd) const;
+    void Enumerate();
+    void Refresh(HWND hWnd);
+
+    IWindowSystem& system_;
+    WindowFilter filter_;
+    bool isEventDriven_ = false;
+
+    mutable std::mutex mutex_;
+    std::condition_variable cv_;
+    bool needsEnumeration_ = true;
+    std::unordered_set<HWND> movedWindows_;
+    std::vector<HWND> titleChangedWindows_;
+    std::unordered_set<HWND> trackedWindows_;
+
+    // touched only by the thread calling Update().
+    std::vector<Window::Data1> dataList_;
+    std::unordered_map<HWND, size_t> dataIndices_;
+    clock::time_point lastEnumerationTime_;
+};
@@ -0,0 +1,341 @@
+#include <algorithm>
+#include "FakeWindowSystem.h"
+
+
+
+namespace
+{
+    // far above the handles of the real windows, since the plugin still sends some Win32 calls to them.
+    constexpr UINT_PTR kHandleBase = 0x40000000;
+
+    // an arbitrary handle which never collides with the fake windows.
+    const HWND kDesktopHandle = reinterpret_cast<HWND>(static_cast<UINT_PTR>(-1));
+}
+
+
+// ---
+
+
+HWND FakeWindowSystem::AddWindow(const RECT& rect, HWND hOwner)
+{
+    HWND hWnd;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        hWnd = reinterpret_cast<HWND>(kHandleBase + ++lastHandle_);
+        windows_.emplace(hWnd, FakeWindow { hOwner, rect, true, false, false });
+        stack_.insert(stack_.begin(), hWnd);
+    }
+
+    Raise(WindowSystemEvent::Created, hWnd);
+    Raise(WindowSystemEvent::Shown, hWnd);
+    return hWnd;
+}
+
+
+void FakeWindowSystem::RemoveWindow(HWND hWnd)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        windows_.erase(hWnd);
+        stack_.erase(std::remove(stack_.begin(), stack_.end(), hWnd), stack_.end());
+    }
+
+    Raise(WindowSystemEvent::Destroyed, hWnd);
+}
+
+
+void FakeWindowSystem::MoveWindow(HWND hWnd, const RECT& rect)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (auto window = Find(hWnd))
+        {
+            window->rect = rect;
+        }
+    }
+
+    Raise(WindowSystemEvent::Moved, hWnd);
+}
+
+
+void FakeWindowSystem::RaiseWindow(HWND hWnd)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        const auto it = std::find(stack_.begin(), stack_.end(), hWnd);
+        if (it != stack_.end())
+        {
+            std::rotate(stack_.begin(), it, it + 1);
+        }
+    }
+
+    Raise(WindowSystemEvent::Reordered, hWnd);
+}
+
+
+void FakeWindowSystem::SetWindowVisible(HWND hWnd, bool isVisible)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (auto window = Find(hWnd))
+        {
+            window->isVisible = isVisible;
+        }
+    }
+
+    Raise(isVisible ? WindowSystemEvent::Shown : WindowSystemEvent::Hidden, hWnd);
+}
+
+
+void FakeWindowSystem::SetWindowHung(HWND hWnd, bool isHung)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (auto window = Find(hWnd))
+    {
+        window->isHung = isHung;
+    }
+}
+
+
+void FakeWindowSystem::SetWindowIconic(HWND hWnd, bool isIconic)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (auto window = Find(hWnd))
+        {
+            window->isIconic = isIconic;
+        }
+    }
+
+    Raise(isIconic ? WindowSystemEvent::Minimized : WindowSystemEvent::Restored, hWnd);
+}
+
+
+void FakeWindowSystem::SetWindowTitle(HWND hWnd)
+{
+    Raise(WindowSystemEvent::TitleChanged, hWnd);
+}
+
+
+HMONITOR FakeWindowSystem::AddMonitor(const RECT& rect)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    const auto hMonitor = reinterpret_cast<HMONITOR>(kHandleBase + ++lastHandle_);
+    monitors_.push_back({ hMonitor, rect });
+    return hMonitor;
+}
+
+
+void FakeWindowSystem::SetEventsDropped(bool isDropped)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    isEventDropped_ = isDropped;
+}
+
+
+UINT FakeWindowSystem::GetQueryCount() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return queryCount_;
+}
+
+
+bool FakeWindowSystem::StartEvents(const EventFunc& func)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    eventFunc_ = func;
+    return true;
+}
+
+
+void FakeWindowSystem::StopEvents()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    eventFunc_ = nullptr;
+}
+
+
+bool FakeWindowSystem::EnumerateWindows(const WindowFunc& func) const
+{
+    std::vector<HWND> handles;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        handles = stack_;
+    }
+
+    for (const auto hWnd : handles)
+    {
+        func(hWnd);
+    }
+
+    return true;
+}
+
+
+bool FakeWindowSystem::EnumerateMonitors(const MonitorFunc& func) const
+{
+    std::vector<FakeMonitor> monitors;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        monitors = monitors_;
+    }
+
+    for (const auto& monitor : monitors)
+    {
+        func(monitor.hMonitor, monitor.rect);
+    }
+
+    return true;
+}
+
+
+bool FakeWindowSystem::IsWindow(HWND hWnd) const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return Find(hWnd) != nullptr;
+}
+
+
+bool FakeWindowSystem::IsWindowVisible(HWND hWnd) const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    const auto window = Find(hWnd);
+    return window && window->isVisible;
+}
+
+
+bool FakeWindowSystem::IsHungAppWindow(HWND hWnd) const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    const auto window = Find(hWnd);
+    return window && window->isHung;
+}
+
+
+bool FakeWindowSystem::IsIconic(HWND hWnd) const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    const auto window = Find(hWnd);
+    return window && window->isIconic;
+}
+
+
+bool FakeWindowSystem::IsCloaked(HWND hWnd) const
+{
+    return false;
+}
+
+
+bool FakeWindowSystem::IsAltTabWindow(HWND hWnd) const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    const auto window = Find(hWnd);
+    return window && !window->hOwner;
+}
+
+
+DWORD FakeWindowSystem::GetProcessId(HWND hWnd) const
+{
+    return 0;
+}
+
+
+std::wstring FakeWindowSystem::GetWindowClass(HWND hWnd) const
+{
+    return L"FakeWindow";
+}
+
+
+std::wstring FakeWindowSystem::GetTitle(HWND hWnd) const
+{
+    return L"";
+}
+
+
+HWND FakeWindowSystem::GetOwner(HWND hWnd) const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    const auto window = Find(hWnd);
+    return window ? window->hOwner : NULL;
+}
+
+
+void FakeWindowSystem::GetWindowRect(HWND hWnd, RECT* rect) const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    const auto window = Find(hWnd);
+    *rect = window ? window->rect : RECT { 0, 0, 0, 0 };
+}
+
+
+void FakeWindowSystem::GetClientRect(HWND hWnd, RECT* rect) const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    const auto window = Find(hWnd);
+    if (!window)
+    {
+        *rect = { 0, 0, 0, 0 };
+        return;
+    }
+    *rect = { 0, 0, window->rect.right - window->rect.left, window->rect.bottom - window->rect.top };
+}
+
+
+HMONITOR FakeWindowSystem::GetMonitor(HWND hWnd) const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (monitors_.empty()) return NULL;
+
+    const auto window = Find(hWnd);
+    if (!window) return monitors_.front().hMonitor;
+
+    const LONG x = (window->rect.left + window->rect.right) / 2;
+    const LONG y = (window->rect.top + window->rect.bottom) / 2;
+    for (const auto& monitor : monitors_)
+    {
+        const auto& rect = monitor.rect;
+        if (x >= rect.left && x < rect.right && y >= rect.top && y < rect.bottom)
+        {
+            return monitor.hMonitor;
+        }
+    }
+
+    return monitors_.front().hMonitor;
+}
+
+
+HWND FakeWindowSystem::GetDesktopWindow() const
+{
+    return kDesktopHandle;
+}
+
+
+const FakeWindowSystem::FakeWindow* FakeWindowSystem::Find(HWND hWnd) const
+{
+    queryCount_++;
+    const auto it = windows_.find(hWnd);
+    return it != windows_.end() ? &it->second : nullptr;
+}
+
+
+FakeWindowSystem::FakeWindow* FakeWindowSystem::Find(HWND hWnd)
+{
+    const auto it = windows_.find(hWnd);
+    return it != windows_.end() ? &it->second : nullptr;
+}
+
+
+void FakeWindowSystem::Raise(WindowSystemEvent event, HWND hWnd)
+{
+    EventFunc func;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (isEventDropped_) return;
+        func = eventFunc_;
+    }
+
+    if (func)
+    {
+        func(event, hWnd);
+    }
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <Windows.h>
+#include <vector>
+#include <unordered_map>
+#include <mutex>
+
+#include "WindowSystem.h"
+
+
+// Scripted window stack to replay window churn without touching the desktop.
+// Every scripted change raises the same event as the real window system would,
+// unless events are dropped to play the WinEvents which are lost under load.
+class FakeWindowSystem : public IWindowSystem
+{
+public:
+    HWND AddWindow(const RECT& rect, HWND hOwner = NULL);
+    void RemoveWindow(HWND hWnd);
+    void MoveWindow(HWND hWnd, const RECT& rect);
+    void RaiseWindow(HWND hWnd);
+    void SetWindowVisible(HWND hWnd, bool isVisible);
+    void SetWindowHung(HWND hWnd, bool isHung);
+    void SetWindowIconic(HWND hWnd, bool isIconic);
+    void SetWindowTitle(HWND hWnd);
+    HMONITOR AddMonitor(const RECT& rect);
+    void SetEventsDropped(bool isDropped);
+    UINT GetQueryCount() const;
+
+    bool StartEvents(const EventFunc& func) override;
+    void StopEvents() override;
+
+    bool EnumerateWindows(const WindowFunc& func) const override;
+    bool EnumerateMonitors(const MonitorFunc& func) const override;
+
+    bool IsWindow(HWND hWnd) const override;
+    bool IsWindowVisible(HWND hWnd) const override;
+    bool IsHungAppWindow(HWND hWnd) const override;
+    bool IsIconic(HWND hWnd) const override;
+    bool IsCloaked(HWND hWnd) const override;
+    bool IsAltTabWindow(HWND hWnd) const override;
+    DWORD GetProcessId(HWND hWnd) const override;
+    std::wstring GetWindowClass(HWND hWnd) const override;
+    std::wstring GetTitle(HWND hWnd) const override;
+    HWND GetOwner(HWND hWnd) const override;
+    void GetWindowRect(HWND hWnd, RECT* rect) const override;
+    void GetClientRect(HWND hWnd, RECT* rect) const override;
+    HMONITOR GetMonitor(HWND hWnd) const override;
+    HWND GetDesktopWindow() const override;
+
+private:
+    struct FakeWindow
+    {
+        HWND hOwner;
+        RECT rect;
+        bool isVisible;
+        bool isHung;
+        bool isIconic;
+    };
+
+    struct FakeMonitor
+    {
+        HMONITOR hMonitor;
+        RECT rect;
+    };
+
+    // called with the lock, and counts the query like a Win32 call.
+    const FakeWindow* Find(HWND hWnd) const;
+    FakeWindow* Find(HWND hWnd);
+    void Raise(WindowSystemEvent event, HWND hWnd);
+
+    mutable std::mutex mutex_;
+    std::unordered_map<HWND, FakeWindow> windows_;
+    std::vector<HWND> stack_; // from the top to the bottom
+    std::vector<FakeMonitor> monitors_;
+    UINT_PTR lastHandle_ = 0;
+    EventFunc eventFunc_;
+    bool isEventDropped_ = false;
+    mutable UINT queryCount_ = 0;
+};
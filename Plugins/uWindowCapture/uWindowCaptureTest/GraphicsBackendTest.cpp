@@ -0,0 +1,67 @@
+#include "Test.h"
+#include "GraphicsBackend.h"
+#include "NullGraphicsBackend.h"
+
+
+
+namespace
+{
+    // Unity textures are opaque keys for the null backend.
+    ID3D11Texture2D* MakeFakeTexture(UINT_PTR key)
+    {
+        return reinterpret_cast<ID3D11Texture2D*>(key);
+    }
+}
+
+
+// ---
+
+
+UWC_TEST(NullBackendIsCreatedOnlyWhenSelected)
+{
+    // there is no Unity device here, so the default backend is not available at all.
+    SetGraphicsBackendType(GraphicsBackendType::D3D11);
+    UWC_CHECK(CreateGraphicsBackend() == nullptr);
+
+    SetGraphicsBackendType(GraphicsBackendType::Null);
+    const auto backend = CreateGraphicsBackend();
+    UWC_CHECK(backend && strcmp(backend->GetName(), "Null") == 0);
+
+    SetGraphicsBackendType(GraphicsBackendType::D3D11);
+}
+
+
+UWC_TEST(NullBackendRecordsUploads)
+{
+    NullGraphicsBackend backend;
+    const auto unityTexture = MakeFakeTexture(1);
+    UWC_CHECK(!backend.CreateSharedTexture(unityTexture));
+
+    backend.RegisterUnityTexture(unityTexture, 4, 2);
+    const auto texture = backend.CreateSharedTexture(unityTexture);
+    UWC_CHECK(texture && texture->GetWidth() == 4 && texture->GetHeight() == 2);
+    if (!texture) return;
+
+    std::vector<BYTE> frame(4 * 2 * 4, 0x11);
+    UWC_CHECK(backend.UpdateSharedTexture(texture.get(), frame.data(), 4 * 4));
+
+    const BYTE region[2 * 4] = { 1, 2, 3, 4, 5, 6, 7, 8 };
+    UWC_CHECK(backend.UpdateSharedTextureRegion(texture.get(), { 1, 1, 3, 2 }, region, 2 * 4));
+    UWC_CHECK(!backend.UpdateSharedTextureRegion(texture.get(), { 3, 1, 5, 2 }, region, 2 * 4));
+
+    const auto pixels = static_cast<NullSharedTexture*>(texture.get())->GetPixels();
+    UWC_CHECK(pixels[(0 + 1 * 4) * 4] == 0x11);
+    UWC_CHECK(pixels[(1 + 1 * 4) * 4] == 1);
+    UWC_CHECK(pixels[(2 + 1 * 4) * 4 + 3] == 8);
+    UWC_CHECK(pixels[(3 + 1 * 4) * 4] == 0x11);
+
+    NullGraphicsBackendStats stats;
+    backend.GetStats(&stats);
+    UWC_CHECK(stats.createdTextureCount == 1);
+    UWC_CHECK(stats.uploadCount == 2);
+    UWC_CHECK(stats.uploadedBytes == 4 * 2 * 4 + 2 * 4);
+
+    UWC_CHECK(backend.CopyToUnityTexture(texture.get(), unityTexture));
+    backend.GetStats(&stats);
+    UWC_CHECK(stats.renderCount == 1);
+}
@@ -0,0 +1,55 @@
+#include <cstdio>
+#include "Test.h"
+
+
+
+namespace
+{
+    UINT g_failureCount = 0;
+}
+
+
+// ---
+
+
+std::vector<TestCase>& GetTestCases()
+{
+    // constructed on the first use since the registrars run during static initialization.
+    static std::vector<TestCase> testCases;
+    return testCases;
+}
+
+
+void ReportFailure(const char* file, int line, const char* expression)
+{
+    printf("    %s(%d): check failed: %s\n", file, line, expression);
+    g_failureCount++;
+}
+
+
+UINT GetFailureCount()
+{
+    return g_failureCount;
+}
+
+
+double Measure(UINT iterations, const std::function<void()>& func)
+{
+    func();
+
+    const auto start = std::chrono::steady_clock::now();
+    for (UINT i = 0; i < iterations; ++i)
+    {
+        func();
+    }
+    const auto end = std::chrono::steady_clock::now();
+
+    const auto us = std::chrono::duration<double, std::micro>(end - start).count();
+    return us / max(iterations, 1u);
+}
+
+
+void PrintResult(const std::string& name, double value, const char* unit)
+{
+    printf("    %-48s %12.3f %s\n", name.c_str(), value, unit);
+}
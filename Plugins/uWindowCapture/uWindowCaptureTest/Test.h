@@ -0,0 +1,55 @@
+#pragma once
+
+#include <Windows.h>
+#include <functional>
+#include <chrono>
+#include <string>
+#include <vector>
+
+
+// Minimal test registry. Each test file only defines its cases with UWC_TEST / UWC_BENCHMARK,
+// and TestMain runs them (benchmarks only with --bench since they take seconds).
+struct TestCase
+{
+    const char* name;
+    std::function<void()> func;
+    bool isBenchmark;
+};
+
+
+std::vector<TestCase>& GetTestCases();
+void ReportFailure(const char* file, int line, const char* expression);
+UINT GetFailureCount();
+
+
+struct TestRegistrar
+{
+    TestRegistrar(const char* name, std::function<void()> func, bool isBenchmark)
+    {
+        GetTestCases().push_back({ name, func, isBenchmark });
+    }
+};
+
+
+#define UWC_TEST(Name) \
+    static void Name(); \
+    static TestRegistrar s_##Name##Registrar(#Name, Name, false); \
+    static void Name()
+
+#define UWC_BENCHMARK(Name) \
+    static void Name(); \
+    static TestRegistrar s_##Name##Registrar(#Name, Name, true); \
+    static void Name()
+
+#define UWC_CHECK(Expression) \
+    do \
+    { \
+        if (!(Expression)) ReportFailure(__FILE__, __LINE__, #Expression); \
+    } while (false)
+
+
+// Average time of func over the iterations after a warm-up run. [us]
+double Measure(UINT iterations, const std::function<void()>& func);
+
+// Prints a row of a benchmark table like "  name  value unit".
+void PrintResult(const std::string& name, double value, const char* unit);
@@ -0,0 +1,46 @@
+#include <cstdio>
+#include <cstring>
+#include "Test.h"
+#include "Debug.h"
+
+
+// usage: uWindowCaptureTest [--bench] [name filter]
+int main(int argc, char** argv)
+{
+    bool runsBenchmarks = false;
+    const char* filter = nullptr;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (strcmp(argv[i], "--bench") == 0)
+        {
+            runsBenchmarks = true;
+        }
+        else
+        {
+            filter = argv[i];
+        }
+    }
+
+    // the plugin logs into uWindowCapture.log by default, which is not wanted here.
+    Debug::SetMode(Debug::Mode::None);
+
+    UINT runCount = 0;
+    UINT failedCount = 0;
+    for (const auto& testCase : GetTestCases())
+    {
+        if (testCase.isBenchmark && !runsBenchmarks) continue;
+        if (filter && !strstr(testCase.name, filter)) continue;
+
+        printf("[ RUN  ] %s\n", testCase.name);
+        const UINT failureCount = GetFailureCount();
+        testCase.func();
+        const bool hasPassed = GetFailureCount() == failureCount;
+        printf("[ %s ] %s\n", hasPassed ? " OK " : "FAIL", testCase.name);
+
+        runCount++;
+        if (!hasPassed) failedCount++;
+    }
+
+    printf("%u run, %u failed\n", runCount, failedCount);
+    return failedCount == 0 ? 0 : 1;
+}
@@ -0,0 +1,149 @@
+#include "Test.h"
+#include "UploadRing.h"
+#include "NullGraphicsBackend.h"
+
+
+
+namespace
+{
+    int WriteFrame(UploadRing& ring, NullGraphicsBackend& backend)
+    {
+        const int slot = ring.BeginWrite();
+        if (slot >= 0) ring.EndWrite(slot, &backend, true);
+        return slot;
+    }
+
+
+    int ReadFrame(UploadRing& ring, NullGraphicsBackend& backend)
+    {
+        const int slot = ring.BeginRead();
+        if (slot >= 0) ring.EndRead(slot, &backend, true);
+        return slot;
+    }
+}
+
+
+// ---
+
+
+UWC_TEST(RingReadsOnlyUploadedFrames)
+{
+    NullGraphicsBackend backend;
+    backend.SetFenceLatency(1);
+    UploadRing ring;
+
+    const int slot = WriteFrame(ring, backend);
+    UWC_CHECK(slot >= 0);
+    UWC_CHECK(ring.HasPendingWrites());
+
+    // the upload fence has not completed yet.
+    UWC_CHECK(!ring.PollWrites());
+    UWC_CHECK(ring.BeginRead() < 0);
+
+    UWC_CHECK(ring.PollWrites());
+    UWC_CHECK(!ring.HasPendingWrites());
+    UWC_CHECK(ReadFrame(ring, backend) == slot);
+
+    // the same frame is never read twice.
+    UWC_CHECK(ring.BeginRead() < 0);
+}
+
+
+UWC_TEST(RingWritesWhileReading)
+{
+    NullGraphicsBackend backend;
+    UploadRing ring;
+
+    WriteFrame(ring, backend);
+    ring.PollWrites();
+    const int readSlot = ring.BeginRead();
+    UWC_CHECK(readSlot >= 0);
+
+    const int writeSlot = WriteFrame(ring, backend);
+    UWC_CHECK(writeSlot >= 0 && writeSlot != readSlot);
+
+    ring.EndRead(readSlot, &backend, true);
+    ring.PollWrites();
+    UWC_CHECK(ReadFrame(ring, backend) == writeSlot);
+}
+
+
+UWC_TEST(RingSkipsOlderUnreadFrames)
+{
+    NullGraphicsBackend backend;
+    UploadRing ring;
+
+    WriteFrame(ring, backend);
+    const int newestSlot = WriteFrame(ring, backend);
+    ring.PollWrites();
+    UWC_CHECK(ReadFrame(ring, backend) == newestSlot);
+    UWC_CHECK(ring.BeginRead() < 0);
+
+    // the writer overwrites the oldest unread frame when no slot is free.
+    NullGraphicsBackend slowBackend;
+    slowBackend.SetFenceLatency(100);
+    UploadRing fullRing;
+    const int oldestSlot = WriteFrame(fullRing, slowBackend);
+    WriteFrame(fullRing, slowBackend);
+    WriteFrame(fullRing, slowBackend);
+    UWC_CHECK(fullRing.BeginWrite() == oldestSlot);
+}
+
+
+UWC_TEST(RingFreesFailedAccesses)
+{
+    NullGraphicsBackend backend;
+    UploadRing ring;
+
+    for (int i = 0; i < UploadRing::kSlotCount * 2; ++i)
+    {
+        const int slot = ring.BeginWrite();
+        UWC_CHECK(slot >= 0);
+        ring.EndWrite(slot, &backend, false);
+    }
+    UWC_CHECK(!ring.HasPendingWrites());
+
+    for (int i = 0; i < UploadRing::kSlotCount * 2; ++i)
+    {
+        WriteFrame(ring, backend);
+        ring.PollWrites();
+        const int slot = ring.BeginRead();
+        UWC_CHECK(slot >= 0);
+        ring.EndRead(slot, &backend, false);
+        UWC_CHECK(!ring.HasPendingReads());
+    }
+}
+
+
+UWC_TEST(RingRecoversWhenEverySlotWaitsForRender)
+{
+    NullGraphicsBackend backend;
+    UploadRing ring;
+
+    // the render fences are created at the first read of each slot, so only the render queue runs behind.
+    for (int i = 0; i < UploadRing::kSlotCount; ++i)
+    {
+        WriteFrame(ring, backend);
+        ring.PollWrites();
+        backend.SetFenceLatency(10);
+        UWC_CHECK(ReadFrame(ring, backend) >= 0);
+        backend.SetFenceLatency(0);
+    }
+
+    UWC_CHECK(ring.BeginWrite() < 0);
+    UWC_CHECK(ring.HasPendingReads());
+
+    // nothing is ready to be read, so only PollReads() can free the slots.
+    int pollCount = 0;
+    while (ring.HasPendingReads() && pollCount < 100)
+    {
+        ring.PollReads();
+        pollCount++;
+    }
+    UWC_CHECK(!ring.HasPendingReads());
+
+    const int slot = WriteFrame(ring, backend);
+    UWC_CHECK(slot >= 0);
+    ring.PollWrites();
+    UWC_CHECK(ReadFrame(ring, backend) == slot);
+}
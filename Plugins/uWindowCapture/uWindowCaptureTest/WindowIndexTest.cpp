@@ -0,0 +1,123 @@
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <unordered_map>
+#include "Test.h"
+#include "FakeWindowSystem.h"
+#include "SlotMap.h"
+
+
+
+namespace
+{
+    RECT MakeRect(LONG x, LONG y, LONG width, LONG height)
+    {
+        return { x, y, x + width, y + height };
+    }
+
+
+    // stands for Window, which cannot be made without a desktop.
+    struct Entry
+    {
+        HWND hWnd;
+        HMONITOR hMonitor;
+        bool isDesktop;
+    };
+
+
+    // the lookups of WindowManager::FindOrAddWindow() / FindOrAddDesktop() through the hash indices.
+    class HashedWindows
+    {
+    public:
+        int FindOrAdd(const Window::Data1& data)
+        {
+            auto& ids = data.isDesktop ? desktopIds_ : windowIds_;
+            const auto key = data.isDesktop ? reinterpret_cast<void*>(data.hMonitor) : reinterpret_cast<void*>(data.hWnd);
+
+            const auto it = ids.find(key);
+            if (it != ids.end() && windows_.Find(it->second)) return it->second;
+
+            const int id = windows_.Insert([&](int) { return std::make_shared<Entry>(Entry { data.hWnd, data.hMonitor, data.isDesktop != FALSE }); });
+            ids[key] = id;
+            return id;
+        }
+
+    private:
+        SlotMap<std::shared_ptr<Entry>> windows_;
+        std::unordered_map<void*, int> windowIds_;
+        std::unordered_map<void*, int> desktopIds_;
+    };
+
+
+    // the linear scans the lookups did before the indices.
+    class ScannedWindows
+    {
+    public:
+        int FindOrAdd(const Window::Data1& data)
+        {
+            const auto it = std::find_if(windows_.begin(), windows_.end(), [&](const auto& pair)
+            {
+                const auto& entry = *pair.second;
+                return data.isDesktop ?
+                    (entry.isDesktop && entry.hMonitor == data.hMonitor) :
+                    (!entry.isDesktop && entry.hWnd == data.hWnd);
+            });
+            if (it != windows_.end()) return it->first;
+
+            const int id = lastId_++;
+            windows_.emplace(id, std::make_shared<Entry>(Entry { data.hWnd, data.hMonitor, data.isDesktop != FALSE }));
+            return id;
+        }
+
+    private:
+        std::map<int, std::shared_ptr<Entry>> windows_;
+        int lastId_ = 0;
+    };
+
+
+    // one tick of the window thread without the per-window updates: enumerate, then find the window of each entry.
+    template <class Windows>
+    double MeasureTick(const FakeWindowSystem& system, Windows& windows)
+    {
+        std::vector<Window::Data1> list;
+        return Measure(100, [&]
+        {
+            list.clear();
+            EnumerateWindowData(system, list);
+            for (const auto& data : list)
+            {
+                windows.FindOrAdd(data);
+            }
+        });
+    }
+}
+
+
+// ---
+
+
+UWC_BENCHMARK(WindowIndexTickScaling)
+{
+    // with the indices the tick has to grow linearly with the window count, where the scans made it quadratic.
+    for (const UINT windowCount : { 100u, 400u, 1600u })
+    {
+        FakeWindowSystem system;
+        system.AddMonitor(MakeRect(0, 0, 1920, 1080));
+        system.AddMonitor(MakeRect(1920, 0, 1920, 1080));
+        for (UINT i = 0; i < windowCount; ++i)
+        {
+            system.AddWindow(MakeRect(10 * (i % 100), 10 * (i % 50), 640, 480));
+        }
+
+        HashedWindows hashedWindows;
+        ScannedWindows scannedWindows;
+        const double hashedTime = MeasureTick(system, hashedWindows);
+        const double scannedTime = MeasureTick(system, scannedWindows);
+
+        const auto suffix = " (" + std::to_string(windowCount) + " windows)";
+        PrintResult("hash indices" + suffix, hashedTime, "us/tick");
+        PrintResult("hash indices per window" + suffix, hashedTime / windowCount, "us/window");
+        PrintResult("linear scans" + suffix, scannedTime, "us/tick");
+        PrintResult("linear scans per window" + suffix, scannedTime / windowCount, "us/window");
+    }
+}
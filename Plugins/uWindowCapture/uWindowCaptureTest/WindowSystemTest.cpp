@@ -0,0 +1,131 @@
+#include <algorithm>
+#include "Test.h"
+#include "FakeWindowSystem.h"
+#include "WindowFilter.h"
+#include "MetadataResolver.h"
+
+
+
+namespace
+{
+    RECT MakeRect(LONG x, LONG y, LONG width, LONG height)
+    {
+        return { x, y, x + width, y + height };
+    }
+
+
+    const Window::Data1* FindData(const std::vector<Window::Data1>& list, HWND hWnd)
+    {
+        const auto it = std::find_if(list.begin(), list.end(), [hWnd](const Window::Data1& data) 
+        { 
+            return !data.isDesktop && data.hWnd == hWnd; 
+        });
+        return it != list.end() ? &*it : nullptr;
+    }
+
+
+    // what the enumeration did before the single pass: counting the visible windows above each one
+    // by walking up the stack (GW_HWNDPREV) from it.
+    UINT EnumerateZOrderByWalking(const IWindowSystem& system)
+    {
+        std::vector<HWND> stack;
+        system.EnumerateWindows([&](HWND hWnd) { stack.push_back(hWnd); });
+
+        UINT sum = 0;
+        for (size_t i = 0; i < stack.size(); ++i)
+        {
+            if (!system.IsWindow(stack[i]) || !system.IsWindowVisible(stack[i])) continue;
+
+            UINT zOrder = 0;
+            for (size_t j = i; j > 0; --j)
+            {
+                if (system.IsWindow(stack[j - 1]) && system.IsWindowVisible(stack[j - 1])) zOrder++;
+            }
+            sum += zOrder;
+        }
+        return sum;
+    }
+}
+
+
+// ---
+
+
+UWC_TEST(EnumerationZOrderFollowsStack)
+{
+    FakeWindowSystem system;
+    system.AddMonitor(MakeRect(0, 0, 1920, 1080));
+    const auto hA = system.AddWindow(MakeRect(0, 0, 100, 100));
+    const auto hB = system.AddWindow(MakeRect(0, 0, 100, 100));
+    const auto hC = system.AddWindow(MakeRect(0, 0, 100, 100));
+    system.RaiseWindow(hA);
+
+    std::vector<Window::Data1> list;
+    UWC_CHECK(EnumerateWindowData(system, list));
+    UWC_CHECK(FindData(list, hA) && FindData(list, hA)->zOrder == 0);
+    UWC_CHECK(FindData(list, hC) && FindData(list, hC)->zOrder == 1);
+    UWC_CHECK(FindData(list, hB) && FindData(list, hB)->zOrder == 2);
+}
+
+
+UWC_TEST(EnumerationZOrderSkipsOnlyHiddenWindows)
+{
+    FakeWindowSystem system;
+    MetadataResolver resolver;
+    WindowFilter filter(resolver);
+    WindowFilterSettings settings;
+    settings.minWidth = 50;
+    filter.SetSettings(settings);
+
+    system.AddMonitor(MakeRect(0, 0, 1920, 1080));
+    const auto hBottom = system.AddWindow(MakeRect(0, 0, 100, 100));
+    const auto hSmall = system.AddWindow(MakeRect(0, 0, 10, 10));
+    const auto hHung = system.AddWindow(MakeRect(0, 0, 100, 100));
+    const auto hHidden = system.AddWindow(MakeRect(0, 0, 100, 100));
+    const auto hTop = system.AddWindow(MakeRect(0, 0, 100, 100));
+    system.SetWindowHung(hHung, true);
+    system.SetWindowVisible(hHidden, false);
+
+    // hidden windows are not counted, but hung and filtered ones keep their place.
+    std::vector<Window::Data1> list;
+    UWC_CHECK(EnumerateWindowData(system, list, &filter));
+    UWC_CHECK(FindData(list, hTop) && FindData(list, hTop)->zOrder == 0);
+    UWC_CHECK(!FindData(list, hHidden));
+    UWC_CHECK(!FindData(list, hHung));
+    UWC_CHECK(!FindData(list, hSmall));
+    UWC_CHECK(FindData(list, hBottom) && FindData(list, hBottom)->zOrder == 3);
+}
+
+
+UWC_BENCHMARK(EnumerationZOrderScaling)
+{
+    // the single pass has to stay linear in the number of windows, where walking up from each window was quadratic.
+    for (const UINT windowCount : { 100u, 400u, 1600u })
+    {
+        FakeWindowSystem system;
+        system.AddMonitor(MakeRect(0, 0, 1920, 1080));
+        for (UINT i = 0; i < windowCount; ++i)
+        {
+            system.AddWindow(MakeRect(10 * (i % 100), 10 * (i % 50), 640, 480));
+        }
+
+        std::vector<Window::Data1> list;
+        UINT queryCount = system.GetQueryCount();
+        const double passTime = Measure(100, [&]
+        {
+            list.clear();
+            EnumerateWindowData(system, list);
+        });
+        const double passQueries = (system.GetQueryCount() - queryCount) / 101.0;
+
+        queryCount = system.GetQueryCount();
+        const double walkTime = Measure(10, [&] { EnumerateZOrderByWalking(system); });
+        const double walkQueries = (system.GetQueryCount() - queryCount) / 11.0;
+
+        const auto suffix = " (" + std::to_string(windowCount) + " windows)";
+        PrintResult("single pass" + suffix, passTime, "us/enumeration");
+        PrintResult("single pass queries" + suffix, passQueries / windowCount, "calls/window");
+        PrintResult("walking up" + suffix, walkTime, "us/enumeration");
+        PrintResult("walking up queries" + suffix, walkQueries / windowCount, "calls/window");
+    }
+}
@@ -0,0 +1,181 @@
+#include <cstdio>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "Test.h"
+#include "SlotMap.h"
+
+
+
+namespace
+{
+    constexpr UINT kWindowCount = 400;
+    constexpr int kRunTime = 300; // [ms] per configuration
+    constexpr int kPublishInterval = 1; // [ms] a window is added and another one removed at every interval
+
+
+    // stands for Window, which cannot be made without a desktop.
+    struct Entry
+    {
+        int id;
+    };
+
+    using Table = SlotMap<std::shared_ptr<Entry>>;
+
+
+    // how WindowManager shares the table now: the window thread publishes a copy and readers load it atomically.
+    class PublishedTable
+    {
+    public:
+        PublishedTable()
+        {
+            for (UINT i = 0; i < kWindowCount; ++i) Add();
+            Publish();
+        }
+
+        std::shared_ptr<Entry> Find(int id) const
+        {
+            const auto table = std::atomic_load(&table_);
+            const auto entry = table->Find(id);
+            return entry ? *entry : nullptr;
+        }
+
+        void Churn()
+        {
+            windows_.Erase(ids_.front());
+            ids_.erase(ids_.begin());
+            Add();
+            Publish();
+        }
+
+        const std::vector<int>& GetIds() const { return ids_; }
+
+    private:
+        void Add()
+        {
+            ids_.push_back(windows_.Insert([](int id) { return std::make_shared<Entry>(Entry { id }); }));
+        }
+
+        void Publish()
+        {
+            std::atomic_store(&table_, std::shared_ptr<const Table>(std::make_shared<Table>(windows_)));
+        }
+
+        Table windows_;
+        std::vector<int> ids_;
+        std::shared_ptr<const Table> table_;
+    };
+
+
+    // the baseline: one table guarded by a mutex, which the writer changes in place.
+    class LockedTable
+    {
+    public:
+        LockedTable()
+        {
+            for (UINT i = 0; i < kWindowCount; ++i) Add();
+        }
+
+        std::shared_ptr<Entry> Find(int id) const
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            const auto entry = windows_.Find(id);
+            return entry ? *entry : nullptr;
+        }
+
+        void Churn()
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            windows_.Erase(ids_.front());
+            ids_.erase(ids_.begin());
+            Add();
+        }
+
+        const std::vector<int>& GetIds() const { return ids_; }
+
+    private:
+        void Add()
+        {
+            ids_.push_back(windows_.Insert([](int id) { return std::make_shared<Entry>(Entry { id }); }));
+        }
+
+        Table windows_;
+        std::vector<int> ids_;
+        mutable std::mutex mutex_;
+    };
+
+
+    // readers look up the ids known at the start (so more and more of them go stale) while the writer churns.
+    template <class WindowTable>
+    double MeasureLookups(UINT readerCount)
+    {
+        WindowTable table;
+        const auto ids = table.GetIds();
+
+        std::atomic<bool> isRunning = true;
+        std::atomic<UINT64> lookupCount = 0;
+
+        std::vector<std::thread> readers;
+        for (UINT i = 0; i < readerCount; ++i)
+        {
+            readers.emplace_back([&, i]
+            {
+                UINT64 count = 0;
+                size_t index = i;
+                while (isRunning)
+                {
+                    table.Find(ids[index++ % ids.size()]);
+                    count++;
+                }
+                lookupCount += count;
+            });
+        }
+
+        const auto start = std::chrono::steady_clock::now();
+        while (std::chrono::steady_clock::now() - start < std::chrono::milliseconds(kRunTime))
+        {
+            table.Churn();
+            std::this_thread::sleep_for(std::chrono::milliseconds(kPublishInterval));
+        }
+        isRunning = false;
+
+        for (auto& reader : readers) reader.join();
+
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        return lookupCount / seconds;
+    }
+}
+
+
+// ---
+
+
+UWC_TEST(PublishedTableKeepsRemovedWindowsForReaders)
+{
+    PublishedTable table;
+    const int id = table.GetIds().front();
+    const auto entry = table.Find(id);
+    UWC_CHECK(entry && entry->id == id);
+
+    table.Churn();
+    UWC_CHECK(!table.Find(id));
+    UWC_CHECK(entry->id == id);
+}
+
+
+UWC_BENCHMARK(WindowTableContention)
+{
+    // the render, capture and upload threads and the exports read the table while the window thread changes it.
+    printf("    (%u hardware threads)\n", std::thread::hardware_concurrency());
+    for (const UINT readerCount : { 1u, 2u, 4u, 8u })
+    {
+        const double publishedRate = MeasureLookups<PublishedTable>(readerCount);
+        const double lockedRate = MeasureLookups<LockedTable>(readerCount);
+
+        const auto suffix = " (" + std::to_string(readerCount) + " readers)";
+        PrintResult("atomic table" + suffix, publishedRate / 1e6, "M lookups/s");
+        PrintResult("mutex baseline" + suffix, lockedRate / 1e6, "M lookups/s");
+    }
+}
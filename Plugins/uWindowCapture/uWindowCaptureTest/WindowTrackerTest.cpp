@@ -0,0 +1,233 @@
+#include <algorithm>
+#include <thread>
+#include "Test.h"
+#include "FakeWindowSystem.h"
+#include "WindowTracker.h"
+#include "MetadataResolver.h"
+
+
+
+namespace
+{
+    constexpr int kReconcileWaitTime = 1100; // [ms] a bit longer than the reconcile interval of WindowTracker
+
+
+    RECT MakeRect(LONG x, LONG y, LONG width, LONG height)
+    {
+        return { x, y, x + width, y + height };
+    }
+
+
+    const Window::Data1* FindData(const std::vector<Window::Data1>& list, HWND hWnd)
+    {
+        const auto it = std::find_if(list.begin(), list.end(), [hWnd](const Window::Data1& data) 
+        { 
+            return !data.isDesktop && data.hWnd == hWnd; 
+        });
+        return it != list.end() ? &*it : nullptr;
+    }
+
+
+    size_t CountWindows(const std::vector<Window::Data1>& list)
+    {
+        return std::count_if(list.begin(), list.end(), [](const Window::Data1& data) { return !data.isDesktop; });
+    }
+
+
+    // a tracker and the window system it listens to, with a few windows already enumerated.
+    struct Replay
+    {
+        FakeWindowSystem system;
+        MetadataResolver resolver;
+        std::unique_ptr<WindowTracker> tracker;
+        std::vector<Window::Data1> list;
+
+        explicit Replay(UINT windowCount)
+        {
+            system.AddMonitor(MakeRect(0, 0, 1920, 1080));
+            for (UINT i = 0; i < windowCount; ++i)
+            {
+                system.AddWindow(MakeRect(10 * (i % 100), 10 * (i % 50), 640, 480));
+            }
+            tracker = std::make_unique<WindowTracker>(system, resolver);
+            tracker->Update(list);
+        }
+    };
+}
+
+
+// ---
+
+
+UWC_TEST(TrackerEnumeratesWindowsInZOrder)
+{
+    FakeWindowSystem system;
+    MetadataResolver resolver;
+    system.AddMonitor(MakeRect(0, 0, 1920, 1080));
+    const auto hBottom = system.AddWindow(MakeRect(0, 0, 100, 100));
+    const auto hMiddle = system.AddWindow(MakeRect(0, 0, 100, 100));
+    const auto hTop = system.AddWindow(MakeRect(0, 0, 100, 100));
+
+    WindowTracker tracker(system, resolver);
+    UWC_CHECK(tracker.IsEventDriven());
+
+    std::vector<Window::Data1> list;
+    tracker.Update(list);
+
+    UWC_CHECK(CountWindows(list) == 3);
+    UWC_CHECK(list.size() == 4); // and the desktop of the monitor
+    UWC_CHECK(FindData(list, hTop) && FindData(list, hTop)->zOrder == 0);
+    UWC_CHECK(FindData(list, hMiddle) && FindData(list, hMiddle)->zOrder == 1);
+    UWC_CHECK(FindData(list, hBottom) && FindData(list, hBottom)->zOrder == 2);
+}
+
+
+UWC_TEST(TrackerRefreshesMovedWindowWithoutEnumeration)
+{
+    Replay replay(100);
+    const auto hWnd = replay.list.front().hWnd;
+
+    const UINT queryCount = replay.system.GetQueryCount();
+    replay.system.MoveWindow(hWnd, MakeRect(300, 200, 800, 600));
+    replay.tracker->Update(replay.list);
+
+    const auto data = FindData(replay.list, hWnd);
+    UWC_CHECK(data && data->windowRect.left == 300 && data->windowRect.right == 1100);
+    UWC_CHECK(data && data->clientRect.right == 800 && data->clientRect.bottom == 600);
+    UWC_CHECK(CountWindows(replay.list) == 100);
+
+    // only the moved window is queried again (rect, client rect, monitor and iconic).
+    UWC_CHECK(replay.system.GetQueryCount() - queryCount <= 4);
+}
+
+
+UWC_TEST(TrackerEnumeratesOnLifecycleAndReorder)
+{
+    Replay replay(10);
+
+    const auto hAdded = replay.system.AddWindow(MakeRect(0, 0, 200, 200));
+    replay.tracker->Update(replay.list);
+    UWC_CHECK(CountWindows(replay.list) == 11);
+    UWC_CHECK(FindData(replay.list, hAdded) && FindData(replay.list, hAdded)->zOrder == 0);
+
+    const auto hBottom = replay.list[CountWindows(replay.list) - 1].hWnd;
+    replay.system.RaiseWindow(hBottom);
+    replay.tracker->Update(replay.list);
+    UWC_CHECK(FindData(replay.list, hBottom) && FindData(replay.list, hBottom)->zOrder == 0);
+    UWC_CHECK(FindData(replay.list, hAdded) && FindData(replay.list, hAdded)->zOrder == 1);
+
+    replay.system.SetWindowVisible(hAdded, false);
+    replay.tracker->Update(replay.list);
+    UWC_CHECK(!FindData(replay.list, hAdded));
+
+    replay.system.RemoveWindow(hBottom);
+    replay.tracker->Update(replay.list);
+    UWC_CHECK(!FindData(replay.list, hBottom));
+    UWC_CHECK(CountWindows(replay.list) == 9);
+}
+
+
+UWC_TEST(TrackerIgnoresEventsOfUntrackedWindows)
+{
+    Replay replay(10);
+
+    const auto hHidden = replay.system.AddWindow(MakeRect(0, 0, 200, 200));
+    replay.system.SetWindowVisible(hHidden, false);
+    replay.tracker->Update(replay.list);
+
+    const UINT queryCount = replay.system.GetQueryCount();
+    replay.system.MoveWindow(hHidden, MakeRect(50, 50, 200, 200));
+    replay.system.SetWindowTitle(hHidden);
+    replay.tracker->Update(replay.list);
+
+    UWC_CHECK(replay.system.GetQueryCount() == queryCount);
+    UWC_CHECK(replay.tracker->TakeTitleChangedWindows().empty());
+}
+
+
+UWC_TEST(TrackerReportsTitleChanges)
+{
+    Replay replay(10);
+    const auto hWnd = replay.list.front().hWnd;
+
+    replay.system.SetWindowTitle(hWnd);
+    const auto windows = replay.tracker->TakeTitleChangedWindows();
+    UWC_CHECK(windows.size() == 1 && windows.front() == hWnd);
+    UWC_CHECK(replay.tracker->TakeTitleChangedWindows().empty());
+}
+
+
+UWC_TEST(TrackerWakesUpOnEvent)
+{
+    Replay replay(10);
+    const auto hWnd = replay.list.front().hWnd;
+
+    std::thread eventThread([&]
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        replay.system.MoveWindow(hWnd, MakeRect(1, 1, 100, 100));
+    });
+
+    const auto start = std::chrono::steady_clock::now();
+    replay.tracker->WaitForChanges(std::chrono::milliseconds(5000));
+    const auto waitTime = std::chrono::steady_clock::now() - start;
+    eventThread.join();
+
+    UWC_CHECK(waitTime < std::chrono::milliseconds(1000));
+}
+
+
+UWC_TEST(TrackerReconcilesMissedEvents)
+{
+    Replay replay(10);
+    const auto hMoved = replay.list.front().hWnd;
+
+    // the events of these changes are lost, so only the periodic enumeration can find them.
+    replay.system.SetEventsDropped(true);
+    const auto hAdded = replay.system.AddWindow(MakeRect(0, 0, 200, 200));
+    replay.system.MoveWindow(hMoved, MakeRect(700, 0, 100, 100));
+
+    replay.tracker->Update(replay.list);
+    UWC_CHECK(!FindData(replay.list, hAdded));
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(kReconcileWaitTime));
+    replay.tracker->Update(replay.list);
+    UWC_CHECK(FindData(replay.list, hAdded) != nullptr);
+    UWC_CHECK(FindData(replay.list, hMoved) && FindData(replay.list, hMoved)->windowRect.left == 700);
+}
+
+
+UWC_BENCHMARK(TrackerChurnReplay)
+{
+    // cost of one tick of the window thread: a full enumeration (what every tick did before the tracker)
+    // against an event-driven tick where one window has moved.
+    for (const UINT windowCount : { 100u, 400u, 1600u })
+    {
+        Replay replay(windowCount);
+
+        std::vector<Window::Data1> list;
+        UINT queryCount = replay.system.GetQueryCount();
+        const double enumerationTime = Measure(100, [&]
+        {
+            list.clear();
+            EnumerateWindowData(replay.system, list);
+        });
+        const double enumerationQueries = (replay.system.GetQueryCount() - queryCount) / 101.0;
+
+        UINT i = 0;
+        queryCount = replay.system.GetQueryCount();
+        const double moveTime = Measure(1000, [&]
+        {
+            const auto hWnd = replay.list[i++ % windowCount].hWnd;
+            replay.system.MoveWindow(hWnd, MakeRect(i % 500, i % 300, 640, 480));
+            replay.tracker->Update(replay.list);
+        });
+        const double moveQueries = (replay.system.GetQueryCount() - queryCount) / 1001.0;
+
+        const auto suffix = " (" + std::to_string(windowCount) + " windows)";
+        PrintResult("full enumeration" + suffix, enumerationTime, "us/tick");
+        PrintResult("full enumeration queries" + suffix, enumerationQueries, "calls/tick");
+        PrintResult("event-driven move" + suffix, moveTime, "us/tick");
+        PrintResult("event-driven move queries" + suffix, moveQueries, "calls/tick");
+    }
+}